@@ -8,8 +8,6 @@
 
 #include "tenh/core.hpp"
 
-#include <vector>
-
 #include "tenh/componentindex.hpp" // technically not conceptual code, but close enough.
 #include "tenh/conceptual/concept.hpp"
 #include "tenh/meta/typestringof.hpp"
@@ -158,6 +156,12 @@ struct TypeStringOf_t<LinearEmbedding_c<Domain_,Codomain_,Scalar_,EmbeddingId_,W
 
 template <typename Concept_> struct DimensionOf_f; // forward declaration
 
+// the coembed operation for a given embedding, stored in compressed sparse row form:
+// the entries for domain component i are at [row_begin(i), row_end(i)) of the
+// contiguous scale factor and codomain component index arrays.  since each codomain
+// component is the embedding of at most one domain component, there are at most
+// CODOMAIN_DIM entries in total.  within each row, the entries are in increasing
+// order of codomain component index.
 template <typename Domain_,
           typename Codomain_,
           typename Scalar_,
@@ -166,27 +170,60 @@ struct CoembedLookupTable_t
 {
     typedef ComponentIndex_t<DimensionOf_f<Domain_>::V> DomainComponentIndex;
     typedef ComponentIndex_t<DimensionOf_f<Codomain_>::V> CodomainComponentIndex;
-    typedef std::pair<Scalar_,CodomainComponentIndex> ScaleFactorAndComponentIndex;
-    typedef std::vector<ScaleFactorAndComponentIndex> ScaleFactorAndComponentIndexVector;
+
+    static Uint32 const DOMAIN_DIM = DimensionOf_f<Domain_>::V;
+    static Uint32 const CODOMAIN_DIM = DimensionOf_f<Codomain_>::V;
+
+    // the table is constructed on first use, so it doesn't depend on static
+    // initialization order.
+    static CoembedLookupTable_t const &instance ()
+    {
+        static CoembedLookupTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    Uint32 entry_count () const { return m_row_offset[DOMAIN_DIM]; }
+    Uint32 row_begin (DomainComponentIndex const &i) const { return m_row_offset[i.value()]; }
+    Uint32 row_end (DomainComponentIndex const &i) const { return m_row_offset[i.value()+1]; }
+    Scalar_ const *scale_factors () const { return m_scale_factor; }
+    CodomainComponentIndex const *component_indices () const { return m_component_index; }
+
+private:
 
     CoembedLookupTable_t ()
     {
-        // compute the table
         typedef typename LinearEmbedding_f<Domain_,Codomain_,Scalar_,EmbeddingId_,WithExceptions::DISABLED>::T LinearEmbedding;
+        // count the entries in each row (shifted by one, so that the prefix sum
+        // gives the row offsets directly).
+        for (Uint32 j = 0; j <= DOMAIN_DIM; ++j)
+            m_row_offset[j] = 0;
+        for (CodomainComponentIndex i; i.is_not_at_end(); ++i)
+            if (!LinearEmbedding::embedded_component_is_procedural_zero(i))
+                ++m_row_offset[LinearEmbedding::source_component_index_for_embedded_component(i).value()+1];
+        for (Uint32 j = 0; j < DOMAIN_DIM; ++j)
+            m_row_offset[j+1] += m_row_offset[j];
+        // fill in the rows, using a running cursor for each row.
+        Uint32 cursor[DOMAIN_DIM];
+        for (Uint32 j = 0; j < DOMAIN_DIM; ++j)
+            cursor[j] = m_row_offset[j];
         for (CodomainComponentIndex i; i.is_not_at_end(); ++i)
         {
             if (!LinearEmbedding::embedded_component_is_procedural_zero(i))
             {
-                DomainComponentIndex j(LinearEmbedding::source_component_index_for_embedded_component(i));
-                m_lookup[j.value()].push_back(ScaleFactorAndComponentIndex(LinearEmbedding::scalar_factor_for_embedded_component(i), i));
+                Uint32 &c = cursor[LinearEmbedding::source_component_index_for_embedded_component(i).value()];
+                m_scale_factor[c] = LinearEmbedding::scalar_factor_for_embedded_component(i);
+                m_component_index[c] = i;
+                ++c;
             }
         }
     }
 
-    static Uint32 const DOMAIN_DIM = DimensionOf_f<Domain_>::V;
-    ScaleFactorAndComponentIndexVector m_lookup[DOMAIN_DIM];
+    Uint32 m_row_offset[DOMAIN_DIM+1];
+    Scalar_ m_scale_factor[CODOMAIN_DIM];
+    CodomainComponentIndex m_component_index[CODOMAIN_DIM];
 };
 
+// a CoembedIndexIterator which walks one row of the CoembedLookupTable_t.
 template <typename Domain_,
           typename Codomain_,
           typename Scalar_,
@@ -197,30 +234,26 @@ struct LookupTableCoembedIndexIterator_t
     typedef ComponentIndex_t<DimensionOf_f<Codomain_>::V> CodomainComponentIndex;
 
     LookupTableCoembedIndexIterator_t (DomainComponentIndex const &i)
-        :
-        m_it(m_lookup_table.m_lookup[i.value()].begin()),
-        m_it_end(m_lookup_table.m_lookup[i.value()].end())
-    { }
-    void operator ++ () { ++m_it; }
-    bool is_not_at_end () const { return m_it != m_it_end; }
-    Scalar_ scale_factor () const { return m_it->first; }
+    {
+        CoembedLookupTable const &lookup_table = CoembedLookupTable::instance();
+        m_scale_factor = lookup_table.scale_factors() + lookup_table.row_begin(i);
+        m_component_index = lookup_table.component_indices() + lookup_table.row_begin(i);
+        m_component_index_end = lookup_table.component_indices() + lookup_table.row_end(i);
+    }
+    void operator ++ () { ++m_scale_factor; ++m_component_index; }
+    bool is_not_at_end () const { return m_component_index != m_component_index_end; }
+    Scalar_ scale_factor () const { return *m_scale_factor; }
     typedef CodomainComponentIndex ComponentIndexReturnType;
-    ComponentIndexReturnType const &component_index () { return m_it->second; }
+    ComponentIndexReturnType const &component_index () { return *m_component_index; }
 
 private:
 
     typedef CoembedLookupTable_t<Domain_,Codomain_,Scalar_,EmbeddingId_> CoembedLookupTable;
-    static CoembedLookupTable const m_lookup_table;
-    typename CoembedLookupTable::ScaleFactorAndComponentIndexVector::const_iterator m_it;
-    typename CoembedLookupTable::ScaleFactorAndComponentIndexVector::const_iterator m_it_end;
+    Scalar_ const *m_scale_factor;
+    CodomainComponentIndex const *m_component_index;
+    CodomainComponentIndex const *m_component_index_end;
 };
 
-template <typename Domain_,
-          typename Codomain_,
-          typename Scalar_,
-          typename EmbeddingId_>
-CoembedLookupTable_t<Domain_,Codomain_,Scalar_,EmbeddingId_> const LookupTableCoembedIndexIterator_t<Domain_,Codomain_,Scalar_,EmbeddingId_>::m_lookup_table;
-
 } // end of namespace Tenh
 
 #endif // TENH_CONCEPTUAL_LINEAREMBEDDING_HPP_
@@ -20,6 +20,26 @@ namespace Tenh {
 // expression-template-generation (making ETs from vectors/tensors)
 // ////////////////////////////////////////////////////////////////////////////
 
+// forward declaration, for the scatter-based assignment below
+template <typename Operand_,
+          typename SourceAbstractIndexType_,
+          typename EmbeddingCodomain_,
+          typename EmbeddedAbstractIndexType_,
+          typename EmbeddingId_>
+struct ExpressionTemplate_IndexEmbed_t;
+// forward declaration, for the flat assignment of split tensor products below
+template <typename Operand, typename SourceAbstractIndexType, typename SplitAbstractIndexTyple>
+struct ExpressionTemplate_IndexSplit_t;
+// forward declaration, for the block-aware contraction below.  SummationPolicy_ determines
+// how the terms of the contraction are accumulated (see tenh/summationpolicy.hpp).
+template <typename LeftOperand,
+          typename RightOperand,
+          typename SummationPolicy_ = typename SummationPolicy_f<typename LeftOperand::Scalar>::T>
+struct ExpressionTemplate_Multiplication_t;
+// forward declaration, for the aliasing analysis in the assignment operators below
+template <typename Expression_, typename DestinationObject_, typename DestinationFactorTyple_, typename DestinationDimIndexTyple_>
+struct ElementwiseAliasing_t;
+
 enum class ForceConst : bool { TRUE = true, FALSE = false };
 
 inline std::ostream &operator << (std::ostream &out, ForceConst force_const)
@@ -34,6 +54,53 @@ inline std::ostream &operator << (std::ostream &out, CheckForAliasing check_for_
     return out << "CheckForAliasing::" << (bool(check_for_aliasing) ? "TRUE" : "FALSE");
 }
 
+// the memory of the destination object of an assignment, for the aliasing analysis below.
+// bundling these avoids passing the (possibly uninitialized) destination itself by const
+// pointer or reference, which some compilers warn about.
+struct AliasingDestination_t
+{
+    template <typename Object_>
+    explicit AliasingDestination_t (Object_ const &object)
+        :
+        object(&object),
+        ptr(reinterpret_cast<Uint8 const *>(object.pointer_to_allocation())),
+        range(object.allocation_size_in_bytes())
+    { }
+
+    void const *object;
+    Uint8 const *ptr;
+    Uint32 range;
+};
+
+// temporaries for aliased assignment at most this many bytes are put on the stack,
+// larger ones are allocated on the heap.
+static Uint32 const MAX_STACK_ALIASING_TEMPORARY_SIZE_IN_BYTES = 4096;
+
+// storage for the evaluated right operand of an aliased assignment.
+template <typename Scalar_,
+          Uint32 COMPONENT_COUNT_,
+          bool IS_ON_STACK_ = COMPONENT_COUNT_*sizeof(Scalar_) <= MAX_STACK_ALIASING_TEMPORARY_SIZE_IN_BYTES>
+struct AliasingTemporary_t
+{
+    Scalar_ *pointer () { return m_components; }
+private:
+    Scalar_ m_components[COMPONENT_COUNT_];
+};
+
+template <typename Scalar_, Uint32 COMPONENT_COUNT_>
+struct AliasingTemporary_t<Scalar_,COMPONENT_COUNT_,false>
+{
+    AliasingTemporary_t () : m_components(new Scalar_[COMPONENT_COUNT_]) { }
+    ~AliasingTemporary_t () { delete[] m_components; }
+
+    Scalar_ *pointer () { return m_components; }
+private:
+    AliasingTemporary_t (AliasingTemporary_t const &);
+    void operator = (AliasingTemporary_t const &);
+
+    Scalar_ *m_components;
+};
+
 // this is the "const" version of an indexed tensor expression (it has summed indices, so it doesn't make sense to assign to it)
 template <typename Object,
           typename FactorTyple, // this is necessary because the factor type depends on if the thing is being indexed as a vector or tensor
@@ -143,6 +210,165 @@ private:
     IsExpressionTemplate_f();
 };
 
+// an implementation type whose nonzero components lie in diagonal blocks (e.g. a direct
+// sum of procedural 2-tensors) can specialize this so that indexed assignment from it
+// (t(i*j) = d(i*j)) or from its contraction with a vector (u(i) = d(i*j)*v(j)) visits
+// only those blocks.  T must provide the Factor0, Factor1 and BlockMatrix types and
+// static contract(u, v) and assign_to(t) functions (see DirectSumOf2TensorsBlocks_t).
+template <typename Object_>
+struct BlockStructureOf_f
+{
+    typedef NullType T;
+private:
+    BlockStructureOf_f();
+};
+
+// gives the BlockStructureOf_f of the object in d(i*j) or d.split(i*j) (with i and j
+// distinct), and NullType for any other expression.
+template <typename Expression_>
+struct BlockStructureOfOperand_f
+{
+    typedef NullType T;
+private:
+    BlockStructureOfOperand_f();
+};
+
+template <typename Object_,
+          typename FactorTyple_,
+          typename RowDimIndex_,
+          typename ColDimIndex_,
+          ForceConst FORCE_CONST_,
+          CheckForAliasing CHECK_FOR_ALIASING_,
+          typename Derived_>
+struct BlockStructureOfOperand_f<ExpressionTemplate_IndexedObject_t<Object_,
+                                                                    FactorTyple_,
+                                                                    Typle_t<RowDimIndex_,ColDimIndex_>,
+                                                                    Typle_t<>,
+                                                                    FORCE_CONST_,
+                                                                    CHECK_FOR_ALIASING_,
+                                                                    Derived_>>
+{
+    typedef typename BlockStructureOf_f<Object_>::T T;
+private:
+    BlockStructureOfOperand_f();
+};
+
+template <typename Object_,
+          typename FactorTyple_,
+          typename DimIndex_,
+          ForceConst FORCE_CONST_,
+          CheckForAliasing CHECK_FOR_ALIASING_,
+          typename Derived_,
+          typename SourceAbstractIndexType_,
+          typename RowAbstractIndexType_,
+          typename ColAbstractIndexType_>
+struct BlockStructureOfOperand_f<ExpressionTemplate_IndexSplit_t<ExpressionTemplate_IndexedObject_t<Object_,
+                                                                                                    FactorTyple_,
+                                                                                                    Typle_t<DimIndex_>,
+                                                                                                    Typle_t<>,
+                                                                                                    FORCE_CONST_,
+                                                                                                    CHECK_FOR_ALIASING_,
+                                                                                                    Derived_>,
+                                                                 SourceAbstractIndexType_,
+                                                                 Typle_t<RowAbstractIndexType_,ColAbstractIndexType_>>>
+{
+    typedef typename If_f<TypesAreEqual_f<RowAbstractIndexType_,ColAbstractIndexType_>::V,
+                          NullType,
+                          typename BlockStructureOf_f<Object_>::T>::T T;
+private:
+    BlockStructureOfOperand_f();
+};
+
+// determines if the indexed assignment of RightOperand_ to DestinationObject_ (indexed by
+// DestinationFreeDimIndexTyple_) can be done by BlockStructureOfOperand_f<RightOperand_>::T::assign_to.
+template <typename DestinationObject_,
+          typename DestinationFreeDimIndexTyple_,
+          typename RightOperand_,
+          typename Blocks_ = typename BlockStructureOfOperand_f<RightOperand_>::T>
+struct IsBlockAssignment_f
+{
+    static bool const V = TypesAreEqual_f<DestinationFreeDimIndexTyple_,typename RightOperand_::FreeDimIndexTyple>::V &&
+                          TypesAreEqual_f<typename DestinationObject_::BasedVectorSpace,typename Blocks_::BlockMatrix>::V;
+private:
+    IsBlockAssignment_f();
+};
+
+template <typename DestinationObject_, typename DestinationFreeDimIndexTyple_, typename RightOperand_>
+struct IsBlockAssignment_f<DestinationObject_,DestinationFreeDimIndexTyple_,RightOperand_,NullType>
+{
+    static bool const V = false;
+private:
+    IsBlockAssignment_f();
+};
+
+// determines if the indexed assignment of d(i*j)*v(j) (or d.split(i*j)*v(j)) to u(i)
+// can be done by BlockStructureOfOperand_f<LeftOperand_>::T::contract, where v(j) must
+// index a vector directly.
+template <typename DestinationObject_,
+          typename DestinationFreeDimIndexTyple_,
+          typename LeftOperand_,
+          typename VectorFreeDimIndexTyple_,
+          typename VectorBasedVectorSpace_,
+          typename Blocks_ = typename BlockStructureOfOperand_f<LeftOperand_>::T>
+struct BlockContractionMatches_f
+{
+    static bool const V = TypesAreEqual_f<DestinationFreeDimIndexTyple_,Typle_t<typename Element_f<typename LeftOperand_::FreeDimIndexTyple,0>::T>>::V &&
+                          TypesAreEqual_f<VectorFreeDimIndexTyple_,Typle_t<typename Element_f<typename LeftOperand_::FreeDimIndexTyple,1>::T>>::V &&
+                          TypesAreEqual_f<typename DestinationObject_::BasedVectorSpace,typename Blocks_::Factor0>::V &&
+                          TypesAreEqual_f<VectorBasedVectorSpace_,typename DualOf_f<typename Blocks_::Factor1>::T>::V;
+private:
+    BlockContractionMatches_f();
+};
+
+template <typename DestinationObject_,
+          typename DestinationFreeDimIndexTyple_,
+          typename LeftOperand_,
+          typename VectorFreeDimIndexTyple_,
+          typename VectorBasedVectorSpace_>
+struct BlockContractionMatches_f<DestinationObject_,DestinationFreeDimIndexTyple_,LeftOperand_,VectorFreeDimIndexTyple_,VectorBasedVectorSpace_,NullType>
+{
+    static bool const V = false;
+private:
+    BlockContractionMatches_f();
+};
+
+template <typename DestinationObject_, typename DestinationFreeDimIndexTyple_, typename LeftOperand_, typename RightOperand_>
+struct IsBlockContraction_f
+{
+    static bool const V = false;
+private:
+    IsBlockContraction_f();
+};
+
+template <typename DestinationObject_,
+          typename DestinationFreeDimIndexTyple_,
+          typename LeftOperand_,
+          typename VectorObject_,
+          typename VectorFactorTyple_,
+          typename VectorDimIndex_,
+          ForceConst FORCE_CONST_,
+          CheckForAliasing CHECK_FOR_ALIASING_,
+          typename VectorDerived_>
+struct IsBlockContraction_f<DestinationObject_,
+                            DestinationFreeDimIndexTyple_,
+                            LeftOperand_,
+                            ExpressionTemplate_IndexedObject_t<VectorObject_,
+                                                               VectorFactorTyple_,
+                                                               Typle_t<VectorDimIndex_>,
+                                                               Typle_t<>,
+                                                               FORCE_CONST_,
+                                                               CHECK_FOR_ALIASING_,
+                                                               VectorDerived_>>
+{
+    static bool const V = BlockContractionMatches_f<DestinationObject_,
+                                                    DestinationFreeDimIndexTyple_,
+                                                    LeftOperand_,
+                                                    Typle_t<VectorDimIndex_>,
+                                                    typename VectorObject_::BasedVectorSpace>::V;
+private:
+    IsBlockContraction_f();
+};
+
 // this is the "non-const" version of an indexed tensor expression (it has no summed indices, so it makes sense to assign to it)
 template <typename Object,
           typename FactorTyple,
@@ -227,18 +453,16 @@ struct ExpressionTemplate_IndexedObject_t<Object,FactorTyple,DimIndexTyple,Typle
         static_assert(!ContainsDuplicates_f<FreeDimIndexTyple>::V, "left operand must have no duplicate free indices");
         static_assert(!ContainsDuplicates_f<typename RightOperand::FreeDimIndexTyple>::V, "right operand must have no duplicate free indices");
 
-        // check for aliasing (where source and destination memory overlap)
-        Uint8 const *ptr = reinterpret_cast<Uint8 const *>(m_object.pointer_to_allocation());
-        Uint32 range = m_object.allocation_size_in_bytes();
-        if (bool(CHECK_FOR_ALIASING_) && right_operand.overlaps_memory_range(ptr, range))
-            throw std::invalid_argument("aliased tensor assignment (source and destination memory overlap) -- see eval() and no_alias()");
-
-        typedef MultiIndexMap_t<FreeDimIndexTyple,typename RightOperand::FreeDimIndexTyple> RightOperandIndexMap;
-        typename RightOperandIndexMap::EvalMapType right_operand_index_map = RightOperandIndexMap::eval;
+        if (is_unsafely_aliased(right_operand))
+        {
+            AliasingTemporary_t<Scalar,MultiIndex::COMPONENT_COUNT> temporary;
+            evaluate_into(temporary.pointer(), right_operand);
+            for (MultiIndex m; m.is_not_at_end(); ++m)
+                m_object[m] = temporary.pointer()[m.value()];
+            return;
+        }
 
-        // component-wise assignment via the free index type.
-        for (MultiIndex m; m.is_not_at_end(); ++m)
-            m_object[m] = right_operand[right_operand_index_map(m)];
+        assign_from(right_operand);
     }
 
     template <typename RightOperand>
@@ -250,11 +474,14 @@ struct ExpressionTemplate_IndexedObject_t<Object,FactorTyple,DimIndexTyple,Typle
         static_assert(!ContainsDuplicates_f<FreeDimIndexTyple>::V, "left operand must have no duplicate free indices");
         static_assert(!ContainsDuplicates_f<typename RightOperand::FreeDimIndexTyple>::V, "right operand must have no duplicate free indices");
 
-        // check for aliasing (where source and destination memory overlap)
-        Uint8 const *ptr = reinterpret_cast<Uint8 const *>(m_object.pointer_to_allocation());
-        Uint32 range = m_object.allocation_size_in_bytes();
-        if (bool(CHECK_FOR_ALIASING_) && right_operand.overlaps_memory_range(ptr, range))
-            throw std::invalid_argument("aliased tensor assignment (source and destination memory overlap) -- see eval() and no_alias()");
+        if (is_unsafely_aliased(right_operand))
+        {
+            AliasingTemporary_t<Scalar,MultiIndex::COMPONENT_COUNT> temporary;
+            evaluate_into(temporary.pointer(), right_operand);
+            for (MultiIndex m; m.is_not_at_end(); ++m)
+                m_object[m] += temporary.pointer()[m.value()];
+            return;
+        }
 
         typedef MultiIndexMap_t<FreeDimIndexTyple,typename RightOperand::FreeDimIndexTyple> RightOperandIndexMap;
         typename RightOperandIndexMap::EvalMapType right_operand_index_map = RightOperandIndexMap::eval;
@@ -273,11 +500,14 @@ struct ExpressionTemplate_IndexedObject_t<Object,FactorTyple,DimIndexTyple,Typle
         static_assert(!ContainsDuplicates_f<FreeDimIndexTyple>::V, "left operand must have no duplicate free indices");
         static_assert(!ContainsDuplicates_f<typename RightOperand::FreeDimIndexTyple>::V, "right operand must have no duplicate free indices");
 
-        // check for aliasing (where source and destination memory overlap)
-        Uint8 const *ptr = reinterpret_cast<Uint8 const *>(m_object.pointer_to_allocation());
-        Uint32 range = m_object.allocation_size_in_bytes();
-        if (bool(CHECK_FOR_ALIASING_) && right_operand.overlaps_memory_range(ptr, range))
-            throw std::invalid_argument("aliased tensor assignment (source and destination memory overlap) -- see eval() and no_alias()");
+        if (is_unsafely_aliased(right_operand))
+        {
+            AliasingTemporary_t<Scalar,MultiIndex::COMPONENT_COUNT> temporary;
+            evaluate_into(temporary.pointer(), right_operand);
+            for (MultiIndex m; m.is_not_at_end(); ++m)
+                m_object[m] -= temporary.pointer()[m.value()];
+            return;
+        }
 
         typedef MultiIndexMap_t<FreeDimIndexTyple,typename RightOperand::FreeDimIndexTyple> RightOperandIndexMap;
         typename RightOperandIndexMap::EvalMapType right_operand_index_map = RightOperandIndexMap::eval;
@@ -307,6 +537,200 @@ struct ExpressionTemplate_IndexedObject_t<Object,FactorTyple,DimIndexTyple,Typle
 
 private:
 
+    // the source and destination memory overlapping (aliasing) is only a problem if some
+    // component of the destination is written before it is read for the evaluation of
+    // a different component.  if every overlapping part of right_operand reads exactly
+    // the component being written (e.g. x(i) = 2*x(i) + y(i)), then the assignment can
+    // be done in place.  otherwise (e.g. x(i) = A(i*j)*x(j)), right_operand is evaluated
+    // into a temporary first.  the analysis is only done if there is overlap at all, so
+    // the non-aliased case costs nothing extra.  no_alias() skips the check entirely.
+    template <typename RightOperand>
+    bool is_unsafely_aliased (RightOperand const &right_operand) const
+    {
+        if (!bool(CHECK_FOR_ALIASING_))
+            return false;
+
+        // is_safe also checks for overlap, so it's the only thing done here.
+        AliasingDestination_t destination(m_object);
+        return !ElementwiseAliasing_t<RightOperand,Object,FactorTyple,DimIndexTyple>::is_safe(right_operand, destination);
+    }
+
+    // stores the components of right_operand in the row-major order of MultiIndex.
+    template <typename RightOperand>
+    static void evaluate_into (Scalar *temporary, RightOperand const &right_operand)
+    {
+        typedef MultiIndexMap_t<FreeDimIndexTyple,typename RightOperand::FreeDimIndexTyple> RightOperandIndexMap;
+        typename RightOperandIndexMap::EvalMapType right_operand_index_map = RightOperandIndexMap::eval;
+
+        for (MultiIndex m; m.is_not_at_end(); ++m)
+            temporary[m.value()] = right_operand[right_operand_index_map(m)];
+    }
+
+    template <typename RightOperand>
+    void assign_from (RightOperand const &right_operand)
+    {
+        assign_componentwise(right_operand);
+    }
+
+    template <typename RightOperand>
+    void assign_componentwise (RightOperand const &right_operand)
+    {
+        typedef MultiIndexMap_t<FreeDimIndexTyple,typename RightOperand::FreeDimIndexTyple> RightOperandIndexMap;
+        typename RightOperandIndexMap::EvalMapType right_operand_index_map = RightOperandIndexMap::eval;
+
+        // component-wise assignment via the free index type.
+        for (MultiIndex m; m.is_not_at_end(); ++m)
+            m_object[m] = right_operand[right_operand_index_map(m)];
+    }
+
+    // an embedded expression is nonzero in only a few of its components, so rather
+    // than gathering each component (and checking if it's a procedural zero), zero
+    // the destination and scatter the source components into it, using the coembed
+    // structure of the embedding to find the destination of each source component.
+    // this isn't possible if the embedded index is also summed (a trace).
+    template <typename Operand_,
+              typename SourceAbstractIndexType_,
+              typename EmbeddingCodomain_,
+              typename EmbeddedAbstractIndexType_,
+              typename EmbeddingId_>
+    void assign_from (ExpressionTemplate_IndexEmbed_t<Operand_,SourceAbstractIndexType_,EmbeddingCodomain_,EmbeddedAbstractIndexType_,EmbeddingId_> const &right_operand)
+    {
+        typedef ExpressionTemplate_IndexEmbed_t<Operand_,SourceAbstractIndexType_,EmbeddingCodomain_,EmbeddedAbstractIndexType_,EmbeddingId_> RightOperand;
+        typedef IndexEmbedder_t<Operand_,SourceAbstractIndexType_,EmbeddingCodomain_,EmbeddedAbstractIndexType_,EmbeddingId_> IndexEmbedder;
+        assign_from_embed<IndexEmbedder>(right_operand, Value_t<bool,(Length_f<typename RightOperand::SummedDimIndexTyple>::V == 0)>());
+    }
+
+    // d(i*j), where d has a block structure (see BlockStructureOf_f).
+    template <typename Object_,
+              typename FactorTyple_,
+              typename DimIndexTyple_,
+              typename SummedDimIndexTyple_,
+              ForceConst FORCE_CONST_,
+              CheckForAliasing OTHER_CHECK_FOR_ALIASING_,
+              typename OtherDerived_>
+    void assign_from (ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,SummedDimIndexTyple_,FORCE_CONST_,OTHER_CHECK_FOR_ALIASING_,OtherDerived_> const &right_operand)
+    {
+        typedef ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,SummedDimIndexTyple_,FORCE_CONST_,OTHER_CHECK_FOR_ALIASING_,OtherDerived_> RightOperand;
+        assign_from_blocks(right_operand, Value_t<bool,IsBlockAssignment_f<Object,FreeDimIndexTyple,RightOperand>::V>());
+    }
+
+    template <typename RightOperand>
+    void assign_from_blocks (RightOperand const &right_operand, Value_t<bool,false> const &)
+    {
+        assign_componentwise(right_operand);
+    }
+
+    // the off-diagonal blocks are zeroed and only the diagonal blocks are evaluated.
+    template <typename RightOperand>
+    void assign_from_blocks (RightOperand const &right_operand, Value_t<bool,true> const &)
+    {
+        BlockStructureOfOperand_f<RightOperand>::T::assign_to(m_object);
+    }
+
+    // a contraction d(i*j)*v(j), where d has a block structure, only involves the
+    // diagonal blocks of d, so it's computed block by block.  other products (and
+    // block-structured tensors nested deeper in an expression) are assigned componentwise,
+    // as are products with a summation policy other than the default one.
+    template <typename LeftOperand_, typename RightOperand_, typename SummationPolicy_>
+    void assign_from (ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_,SummationPolicy_> const &right_operand)
+    {
+        static bool const IS_BLOCK_CONTRACTION = IsBlockContraction_f<Object,FreeDimIndexTyple,LeftOperand_,RightOperand_>::V &&
+                                                 TypesAreEqual_f<SummationPolicy_,typename SummationPolicy_f<Scalar>::T>::V;
+        assign_from_multiplication<LeftOperand_>(right_operand, Value_t<bool,IS_BLOCK_CONTRACTION>());
+    }
+
+    template <typename LeftOperand_, typename RightOperand>
+    void assign_from_multiplication (RightOperand const &right_operand, Value_t<bool,false> const &)
+    {
+        assign_componentwise(right_operand);
+    }
+
+    template <typename LeftOperand_, typename RightOperand>
+    void assign_from_multiplication (RightOperand const &right_operand, Value_t<bool,true> const &)
+    {
+        BlockStructureOfOperand_f<LeftOperand_>::T::contract(m_object, right_operand.right_operand().object());
+    }
+
+    // splitting a whole tensor product object (as in t.split(i*j*k)) is a reinterpretation
+    // of its component index, so if this object is also a tensor product, indexed in the
+    // same order, then the assignment is a component-by-component copy of the same memory
+    // layout, and the multi-index iteration can be skipped entirely.
+    template <typename Operand_,
+              typename SourceAbstractIndexType_,
+              typename SplitAbstractIndexTyple_>
+    void assign_from (ExpressionTemplate_IndexSplit_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexTyple_> const &right_operand)
+    {
+        typedef ExpressionTemplate_IndexSplit_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexTyple_> RightOperand;
+        typedef typename IndexSplitter_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexTyple_>::SourceFactor SourceFactor;
+        typedef typename Object::BasedVectorSpace ObjectBasedVectorSpace;
+        static bool const IS_FLAT_COPY = IsTensorProductOfBasedVectorSpaces_f<SourceFactor>::V &&
+                                         Length_f<typename Operand_::FreeDimIndexTyple>::V == 1 &&
+                                         Length_f<typename RightOperand::SummedDimIndexTyple>::V == 0 &&
+                                         TypesAreEqual_f<FreeDimIndexTyple,typename RightOperand::FreeDimIndexTyple>::V &&
+                                         IsTensorProductOfBasedVectorSpaces_f<ObjectBasedVectorSpace>::V &&
+                                         OrderOf_f<ObjectBasedVectorSpace>::V == Length_f<FreeDimIndexTyple>::V;
+        static bool const IS_BLOCK_ASSIGNMENT = IsBlockAssignment_f<Object,FreeDimIndexTyple,RightOperand>::V;
+        if (IS_BLOCK_ASSIGNMENT)
+            assign_from_blocks(right_operand, Value_t<bool,IS_BLOCK_ASSIGNMENT>());
+        else
+            assign_from_split<Operand_>(right_operand, Value_t<bool,IS_FLAT_COPY>());
+    }
+
+    template <typename Operand_, typename RightOperand>
+    void assign_from_split (RightOperand const &right_operand, Value_t<bool,false> const &)
+    {
+        assign_componentwise(right_operand);
+    }
+
+    template <typename Operand_, typename RightOperand>
+    void assign_from_split (RightOperand const &right_operand, Value_t<bool,true> const &)
+    {
+        typedef typename Operand_::MultiIndex OperandMultiIndex;
+        typedef ComponentIndex_t<OperandMultiIndex::COMPONENT_COUNT> OperandComponentIndex;
+        static_assert(OperandMultiIndex::COMPONENT_COUNT == Object::ComponentIndex::COMPONENT_COUNT, "dimensions must match");
+        Operand_ const &operand = right_operand.operand();
+        for (typename Object::ComponentIndex i; i.is_not_at_end(); ++i)
+            m_object[i] = operand[OperandMultiIndex(OperandComponentIndex(i.value(), CheckRange::FALSE))];
+    }
+
+    template <typename IndexEmbedder_, typename RightOperand>
+    void assign_from_embed (RightOperand const &right_operand, Value_t<bool,false> const &)
+    {
+        assign_componentwise(right_operand);
+    }
+
+    template <typename IndexEmbedder_, typename RightOperand>
+    void assign_from_embed (RightOperand const &right_operand, Value_t<bool,true> const &)
+    {
+        typedef typename IndexEmbedder_::Operand Operand;
+        typedef typename IndexEmbedder_::EmbeddingDomain EmbeddingDomain;
+        typedef typename IndexEmbedder_::EmbeddingCodomain EmbeddingCodomain;
+        typedef typename IndexEmbedder_::EmbeddingId EmbeddingId;
+        static Uint32 const SOURCE_INDEX_TYPE_INDEX = IndexEmbedder_::SOURCE_INDEX_TYPE_INDEX;
+        typedef ComponentIndex_t<DimensionOf_f<EmbeddingDomain>::V> EmbeddingDomainComponentIndex;
+        typedef typename CoembedIndexIterator_f<EmbeddingDomain,EmbeddingCodomain,Scalar,EmbeddingId,WithExceptions::DISABLED>::T CoembedIndexIterator;
+        typedef MultiIndexMap_t<typename IndexEmbedder_::DimIndexTyple,FreeDimIndexTyple> IndexMap;
+        typename IndexMap::EvalMapType index_map = IndexMap::eval;
+
+        for (typename Object::ComponentIndex i; i.is_not_at_end(); ++i)
+            m_object[i] = Scalar(0);
+
+        Operand const &operand = right_operand.operand();
+        for (typename Operand::MultiIndex s; s.is_not_at_end(); ++s)
+        {
+            Scalar value(operand[s]);
+            EmbeddingDomainComponentIndex j(s.template el<SOURCE_INDEX_TYPE_INDEX>());
+            for (CoembedIndexIterator it(j); it.is_not_at_end(); ++it)
+            {
+                // this replaces the SourceAbstractIndexType_ portion with EmbeddedAbstractIndexType_
+                typename IndexEmbedder_::MultiIndex m(s.template leading_tuple<SOURCE_INDEX_TYPE_INDEX>()
+                                                      |
+                                                      (it.component_index() >>= s.template trailing_tuple<SOURCE_INDEX_TYPE_INDEX+1>()));
+                m_object[index_map(m)] = it.scale_factor() * value;
+            }
+        }
+    }
+
     Object &m_object;
 };
 
@@ -510,16 +934,16 @@ private:
 // expression template AST for such contractions and restructuring the AST.
 // NOTE: if this is ever subclassed, then it will be necessary to change the 
 // inheritance to pass in the Derived type
-template <typename LeftOperand, typename RightOperand>
+template <typename LeftOperand, typename RightOperand, typename SummationPolicy_>
 struct ExpressionTemplate_Multiplication_t
     :
-    public ExpressionTemplate_i<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>,
+    public ExpressionTemplate_i<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy_>,
                                 typename LeftOperand::Scalar,
                                 typename FreeFactorTypleOfMultiplication_f<LeftOperand,RightOperand>::T,
                                 typename FreeDimIndexTypleOfMultiplication_f<LeftOperand,RightOperand>::T,
                                 typename UsedDimIndexTypleOfMultiplication_f<LeftOperand,RightOperand>::T>
 {
-    typedef ExpressionTemplate_i<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>,
+    typedef ExpressionTemplate_i<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy_>,
                                  typename LeftOperand::Scalar,
                                  typename FreeFactorTypleOfMultiplication_f<LeftOperand,RightOperand>::T,
                                  typename FreeDimIndexTypleOfMultiplication_f<LeftOperand,RightOperand>::T,
@@ -532,6 +956,7 @@ struct ExpressionTemplate_Multiplication_t
     typedef typename Parent::MultiIndex MultiIndex;
 
     typedef typename SummedDimIndexTypleOfMultiplication_f<LeftOperand,RightOperand>::T SummedDimIndexTyple;
+    typedef SummationPolicy_ SummationPolicy;
 
     // TODO: check that the summed indices from each operand have no indices in common
     // though technically this is unnecessary, because the summed indices are "private"
@@ -558,7 +983,16 @@ struct ExpressionTemplate_Multiplication_t
 
     Scalar operator [] (MultiIndex const &m) const
     {
-        return BinarySummation_t<LeftOperand,RightOperand,FreeDimIndexTyple,SummedDimIndexTyple>::eval(m_left_operand, m_right_operand, m);
+        return BinarySummation_t<LeftOperand,RightOperand,FreeDimIndexTyple,SummedDimIndexTyple,SummationPolicy_>::eval(m_left_operand, m_right_operand, m);
+    }
+
+    // returns this product, but with its terms accumulated using OtherSummationPolicy_
+    // instead, e.g. (a(i*j)*x(j)).summed_using<KahanSummation>().  this overrides
+    // SummationPolicy_f for this one contraction.
+    template <typename OtherSummationPolicy_>
+    ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,OtherSummationPolicy_> summed_using () const
+    {
+        return ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,OtherSummationPolicy_>(m_left_operand, m_right_operand);
     }
 
     bool overlaps_memory_range (Uint8 const *ptr, Uint32 range) const
@@ -572,7 +1006,8 @@ struct ExpressionTemplate_Multiplication_t
     static std::string type_as_string (bool verbose)
     {
         return "ExpressionTemplate_Multiplication_t<" + type_string_of<LeftOperand>() + ','
-                                                      + type_string_of<RightOperand>() + '>';
+                                                      + type_string_of<RightOperand>() + ','
+                                                      + type_string_of<SummationPolicy_>() + '>';
     }
 
 private:
@@ -583,14 +1018,132 @@ private:
     RightOperand m_right_operand;
 };
 
-template <typename LeftOperand_, typename RightOperand_>
-struct IsExpressionTemplate_f<ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_>>
+template <typename LeftOperand_, typename RightOperand_, typename SummationPolicy_>
+struct IsExpressionTemplate_f<ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_,SummationPolicy_>>
 {
     static bool const V = true;
 private:
     IsExpressionTemplate_f();
 };
 
+// ////////////////////////////////////////////////////////////////////////////
+// aliasing analysis for assignment
+// ////////////////////////////////////////////////////////////////////////////
+
+// determines if evaluating Expression_ in place into destination (which is indexed as
+// DestinationObject_ with the given factor and index typles) is safe, i.e. if every part of Expression_ that overlaps the destination
+// memory reads only the very component of the destination that is being written.
+// this is conservative: expression templates other than those handled below (e.g.
+// split, bundle, embed, and reindexed ones) are only considered safe if they don't
+// overlap the destination at all.
+template <typename Expression_, typename DestinationObject_, typename DestinationFactorTyple_, typename DestinationDimIndexTyple_>
+struct ElementwiseAliasing_t
+{
+    static bool is_safe (Expression_ const &expression, AliasingDestination_t const &destination)
+    {
+        return !expression.overlaps_memory_range(destination.ptr, destination.range);
+    }
+private:
+    ElementwiseAliasing_t();
+};
+
+// an indexed object reads the component being written exactly when it is the destination
+// itself, indexed by the same (free, and in the same order) indices.
+template <typename Object_,
+          typename FactorTyple_,
+          typename DimIndexTyple_,
+          typename SummedDimIndexTyple_,
+          ForceConst FORCE_CONST_,
+          CheckForAliasing CHECK_FOR_ALIASING_,
+          typename DestinationObject_,
+          typename DestinationFactorTyple_,
+          typename DestinationDimIndexTyple_>
+struct ElementwiseAliasing_t<ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,SummedDimIndexTyple_,FORCE_CONST_,CHECK_FOR_ALIASING_>,
+                             DestinationObject_,
+                             DestinationFactorTyple_,
+                             DestinationDimIndexTyple_>
+{
+    typedef ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,SummedDimIndexTyple_,FORCE_CONST_,CHECK_FOR_ALIASING_> Expression;
+    static bool const IS_INDEXED_LIKE_DESTINATION = TypesAreEqual_f<Object_,DestinationObject_>::V &&
+                                                    TypesAreEqual_f<FactorTyple_,DestinationFactorTyple_>::V &&
+                                                    TypesAreEqual_f<DimIndexTyple_,DestinationDimIndexTyple_>::V &&
+                                                    Length_f<SummedDimIndexTyple_>::V == 0;
+
+    static bool is_safe (Expression const &expression, AliasingDestination_t const &destination)
+    {
+        if (!expression.overlaps_memory_range(destination.ptr, destination.range))
+            return true;
+        return IS_INDEXED_LIKE_DESTINATION &&
+               static_cast<void const *>(&expression.object()) == destination.object;
+    }
+private:
+    ElementwiseAliasing_t();
+};
+
+// addition, scalar multiplication and multiplication access their operands using the
+// same index symbols, so they're safe if their operands are.
+template <typename LeftOperand_,
+          typename RightOperand_,
+          char OPERATOR_,
+          typename DestinationObject_,
+          typename DestinationFactorTyple_,
+          typename DestinationDimIndexTyple_>
+struct ElementwiseAliasing_t<ExpressionTemplate_Addition_t<LeftOperand_,RightOperand_,OPERATOR_>,
+                             DestinationObject_,
+                             DestinationFactorTyple_,
+                             DestinationDimIndexTyple_>
+{
+    static bool is_safe (ExpressionTemplate_Addition_t<LeftOperand_,RightOperand_,OPERATOR_> const &expression,
+                         AliasingDestination_t const &destination)
+    {
+        return ElementwiseAliasing_t<LeftOperand_,DestinationObject_,DestinationFactorTyple_,DestinationDimIndexTyple_>::is_safe(expression.left_operand(), destination) &&
+               ElementwiseAliasing_t<RightOperand_,DestinationObject_,DestinationFactorTyple_,DestinationDimIndexTyple_>::is_safe(expression.right_operand(), destination);
+    }
+private:
+    ElementwiseAliasing_t();
+};
+
+template <typename Operand_,
+          typename Scalar_,
+          char OPERATOR_,
+          typename DestinationObject_,
+          typename DestinationFactorTyple_,
+          typename DestinationDimIndexTyple_>
+struct ElementwiseAliasing_t<ExpressionTemplate_ScalarMultiplication_t<Operand_,Scalar_,OPERATOR_>,
+                             DestinationObject_,
+                             DestinationFactorTyple_,
+                             DestinationDimIndexTyple_>
+{
+    static bool is_safe (ExpressionTemplate_ScalarMultiplication_t<Operand_,Scalar_,OPERATOR_> const &expression,
+                         AliasingDestination_t const &destination)
+    {
+        return ElementwiseAliasing_t<Operand_,DestinationObject_,DestinationFactorTyple_,DestinationDimIndexTyple_>::is_safe(expression.operand(), destination);
+    }
+private:
+    ElementwiseAliasing_t();
+};
+
+template <typename LeftOperand_,
+          typename RightOperand_,
+          typename SummationPolicy_,
+          typename DestinationObject_,
+          typename DestinationFactorTyple_,
+          typename DestinationDimIndexTyple_>
+struct ElementwiseAliasing_t<ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_,SummationPolicy_>,
+                             DestinationObject_,
+                             DestinationFactorTyple_,
+                             DestinationDimIndexTyple_>
+{
+    static bool is_safe (ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_,SummationPolicy_> const &expression,
+                         AliasingDestination_t const &destination)
+    {
+        return ElementwiseAliasing_t<LeftOperand_,DestinationObject_,DestinationFactorTyple_,DestinationDimIndexTyple_>::is_safe(expression.left_operand(), destination) &&
+               ElementwiseAliasing_t<RightOperand_,DestinationObject_,DestinationFactorTyple_,DestinationDimIndexTyple_>::is_safe(expression.right_operand(), destination);
+    }
+private:
+    ElementwiseAliasing_t();
+};
+
 // ////////////////////////////////////////////////////////////////////////////
 // bundling multiple separate indices into a single vector index (downcasting)
 // ////////////////////////////////////////////////////////////////////////////
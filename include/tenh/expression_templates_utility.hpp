@@ -17,6 +17,7 @@
 #include "tenh/implementation/implementationof.hpp"
 #include "tenh/interface/expressiontemplate.hpp"
 #include "tenh/multiindex.hpp"
+#include "tenh/summationpolicy.hpp"
 
 namespace Tenh {
 
@@ -162,7 +163,11 @@ private:
 // this is designed to handle trace-type expression templates, such as u(i,i) or v(i,j,i)
 // technically SummedDimIndexTyple is a redundant argument (as it is derivable from TensorDimIndexTyple),
 // but it is necessary so that a template specialization can be made for when it is Typle_t<>.
-template <typename Tensor, typename TensorDimIndexTyple, typename SummedDimIndexTyple>
+// SummationPolicy determines how the terms are accumulated (see tenh/summationpolicy.hpp).
+template <typename Tensor,
+          typename TensorDimIndexTyple,
+          typename SummedDimIndexTyple,
+          typename SummationPolicy = typename SummationPolicy_f<typename Tensor::Scalar>::T>
 struct UnarySummation_t
 {
 private:
@@ -190,7 +195,7 @@ public:
         // constructing t with m initializes the first elements which correpond to
         // MultiIndex with the value of m, and initializes the remaining elements to zero.
         TotalMultiIndex t(m);
-        Scalar retval(0);
+        typename SummationPolicy::template Accumulator_t<Scalar> accumulator;
         // get the map which produces the MultiIndex for each tensor from the TotalMultiIndex t
         typedef MultiIndexMap_t<TotalDimIndexTyple,TensorDimIndexTyple> TensorIndexMap;
         static typename TensorIndexMap::EvalMapType const tensor_index_map = TensorIndexMap::eval;
@@ -201,13 +206,13 @@ public:
             // should go away, since this is a non-natural pairing, and it causes C++ plumbing issues
             // (getting the C++ scalar type from the index, where the index will only be aware of the
             // abstract BasedVectorSpace).
-            retval += tensor[tensor_index_map(t)];// * summation_component_factor(s);
-        return retval;
+            accumulator.add(tensor[tensor_index_map(t)]);// * summation_component_factor(s);
+        return accumulator.value();
     }
 };
 
-template <typename Tensor, typename TensorDimIndexTyple>
-struct UnarySummation_t<Tensor,TensorDimIndexTyple,Typle_t<>>
+template <typename Tensor, typename TensorDimIndexTyple, typename SummationPolicy>
+struct UnarySummation_t<Tensor,TensorDimIndexTyple,Typle_t<>,SummationPolicy>
 {
     // no summations to check the natural pairing for
 
@@ -218,7 +223,12 @@ struct UnarySummation_t<Tensor,TensorDimIndexTyple,Typle_t<>>
     static Scalar eval (Tensor const &tensor, MultiIndex const &m) { return tensor[m]; }
 };
 
-template <typename LeftOperand, typename RightOperand, typename FreeDimIndexTyple, typename SummedDimIndexTyple>
+// SummationPolicy determines how the terms are accumulated (see tenh/summationpolicy.hpp).
+template <typename LeftOperand,
+          typename RightOperand,
+          typename FreeDimIndexTyple,
+          typename SummedDimIndexTyple,
+          typename SummationPolicy = typename SummationPolicy_f<typename LeftOperand::Scalar>::T>
 struct BinarySummation_t
 {
 private:
@@ -250,7 +260,7 @@ public:
         // constructing t with m initializes the first elements which correpond to
         // MultiIndex with the value of m, and initializes the remaining elements to zero.
         TotalMultiIndex t(m);
-        Scalar retval(0);
+        typename SummationPolicy::template Accumulator_t<Scalar> accumulator;
         // get the map which produces the MultiIndex for each operand from the TotalMultiIndex t
         typedef MultiIndexMap_t<TotalDimIndexTyple,typename LeftOperand::FreeDimIndexTyple> LeftOperandIndexMap;
         typedef MultiIndexMap_t<TotalDimIndexTyple,typename RightOperand::FreeDimIndexTyple> RightOperandIndexMap;
@@ -259,16 +269,16 @@ public:
         // t = (f,s), which is a concatenation of the free access indices and the summed access indices.
         // s is a reference to the second part, which is what is iterated over in the summation.
         for (SummedMultiIndex &s = t.template trailing_tuple<Length_f<FreeDimIndexTyple>::V>(); s.is_not_at_end(); ++s)
-            retval += left_operand[left_operand_index_map(t)] *
-                      right_operand[right_operand_index_map(t)];// *
-                      //summation_component_factor(s);
-        return retval;
+            accumulator.add(left_operand[left_operand_index_map(t)] *
+                            right_operand[right_operand_index_map(t)]);// *
+                            //summation_component_factor(s);
+        return accumulator.value();
     }
 };
 
 // template specialization handles summation over no indices
-template <typename LeftOperand, typename RightOperand, typename FreeDimIndexTyple>
-struct BinarySummation_t<LeftOperand,RightOperand,FreeDimIndexTyple,Typle_t<>>
+template <typename LeftOperand, typename RightOperand, typename FreeDimIndexTyple, typename SummationPolicy>
+struct BinarySummation_t<LeftOperand,RightOperand,FreeDimIndexTyple,Typle_t<>,SummationPolicy>
 {
     static_assert(IsExpressionTemplate_f<LeftOperand>::V, "LeftOperand must be an ExpressionTemplate_i");
     static_assert(IsExpressionTemplate_f<RightOperand>::V, "RightOperand must be an ExpressionTemplate_i");
@@ -387,6 +397,95 @@ template <typename Scalar, typename BundleDimIndexTyple, typename ResultingFacto
 typename BundleIndexMap_t<Scalar,BundleDimIndexTyple,ResultingFactorType,ResultingDimIndexType>::T const BundleIndexMap_t<Scalar,BundleDimIndexTyple,ResultingFactorType,ResultingDimIndexType>::V =
     ImplementationOf_t<ResultingFactorType,Scalar,UseMemberArray_t<ComponentsAreConst::FALSE>>::template bundle_index_map<BundleDimIndexTyple,ResultingDimIndexType>;
 
+// split and bundle index maps are tabulated (see BundleIndexTable_t and SplitIndexTable_t),
+// with one entry per component, only up to this many components.  larger tables would cost
+// more memory than they save time, so their index maps are computed per access instead.
+static Uint32 const MAX_INDEX_TABLE_COMPONENT_COUNT = 4096;
+
+// determines if the split/bundle index maps of Factor_ (whose table would have
+// TABLE_COMPONENT_COUNT_ entries) are tabulated.  a tensor product needs no table,
+// since its split and bundle are a row-major reinterpretation of the component index.
+template <typename Factor_, Uint32 TABLE_COMPONENT_COUNT_>
+struct IndexMapIsTabulated_f
+{
+    static bool const V = !IsTensorProductOfBasedVectorSpaces_f<Factor_>::V &&
+                          TABLE_COMPONENT_COUNT_ <= MAX_INDEX_TABLE_COMPONENT_COUNT;
+private:
+    IndexMapIsTabulated_f();
+};
+
+// precomputed values of BundleIndexMap_t, one per component of ResultingFactorType, so that
+// a bundled access is a single lookup instead of a call to bundle_index_map.
+template <typename Scalar,
+          typename BundleDimIndexTyple,
+          typename ResultingFactorType,
+          typename ResultingDimIndexType,
+          bool IS_TABULATED_ = IndexMapIsTabulated_f<ResultingFactorType,ResultingDimIndexType::COMPONENT_COUNT>::V>
+struct BundleIndexTable_t
+{
+    typedef MultiIndex_t<BundleDimIndexTyple> BundleMultiIndex;
+
+    static Uint32 const DIM = ResultingDimIndexType::COMPONENT_COUNT;
+
+    // the table is constructed on first use, so it doesn't depend on static
+    // initialization order.
+    static BundleIndexTable_t const &instance ()
+    {
+        static BundleIndexTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    BundleMultiIndex const &operator [] (ResultingDimIndexType const &p) const { return m_bundle_multi_index[p.value()]; }
+
+private:
+
+    BundleIndexTable_t ()
+    {
+        typedef BundleIndexMap_t<Scalar,BundleDimIndexTyple,ResultingFactorType,ResultingDimIndexType> BundleIndexMap;
+        for (ResultingDimIndexType p; p.is_not_at_end(); ++p)
+            m_bundle_multi_index[p.value()] = BundleIndexMap::V(p);
+    }
+
+    BundleMultiIndex m_bundle_multi_index[DIM];
+};
+
+// an untabulated bundle index map is computed by bundle_index_map on each access.
+template <typename Scalar, typename BundleDimIndexTyple, typename ResultingFactorType, typename ResultingDimIndexType>
+struct BundleIndexTable_t<Scalar,BundleDimIndexTyple,ResultingFactorType,ResultingDimIndexType,false>
+{
+    typedef MultiIndex_t<BundleDimIndexTyple> BundleMultiIndex;
+
+    static BundleIndexTable_t const &instance ()
+    {
+        static BundleIndexTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    BundleMultiIndex operator [] (ResultingDimIndexType const &p) const
+    {
+        return BundleIndexMap_t<Scalar,BundleDimIndexTyple,ResultingFactorType,ResultingDimIndexType>::V(p);
+    }
+};
+
+// bundling into a tensor product is just the row-major reinterpretation of the bundled
+// indices, so there is nothing to look up; this inlines to index arithmetic.
+template <typename Scalar, typename BundleDimIndexTyple, typename FactorTyple, typename ResultingDimIndexType>
+struct BundleIndexTable_t<Scalar,BundleDimIndexTyple,TensorProductOfBasedVectorSpaces_c<FactorTyple>,ResultingDimIndexType,false>
+{
+    typedef MultiIndex_t<BundleDimIndexTyple> BundleMultiIndex;
+
+    static_assert(BundleMultiIndex::COMPONENT_COUNT == ResultingDimIndexType::COMPONENT_COUNT, "bundled and resulting dimensions must match");
+
+    static BundleIndexTable_t const &instance ()
+    {
+        static BundleIndexTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    // this constructor breaks the vector index apart into a row-major multi-index
+    BundleMultiIndex operator [] (ResultingDimIndexType const &p) const { return BundleMultiIndex(p); }
+};
+
 // not an expression template, but just something that handles the bundled indices
 template <typename Operand, typename BundleAbstractIndexTyple, typename ResultingFactorType, typename ResultingAbstractIndexType, CheckFactorTypes CHECK_FACTOR_TYPES_>
 struct IndexBundle_t
@@ -457,20 +556,28 @@ public:
                              BundleDimIndexTyple,
                              ResultingFactorType,
                              ResultingDimIndexType> BundleIndexMap;
+    typedef BundleIndexTable_t<Scalar,
+                               BundleDimIndexTyple,
+                               ResultingFactorType,
+                               ResultingDimIndexType> BundleIndexTable;
 
-    IndexBundle_t (Operand const &operand) : m_operand(operand) { }
+    IndexBundle_t (Operand const &operand)
+        :
+        m_operand(operand),
+        m_bundle_index_table(BundleIndexTable::instance())
+    { }
 
     Scalar operator [] (MultiIndex const &m) const
     {
-        // replace the head of m with the separate indices that it bundles.
-        // use MultiIndexMap_t to place the indices in the correct order.
+        // replace the head of m with the separate indices that it bundles (looked up
+        // in the precomputed bundle index table).  use MultiIndexMap_t to place the
+        // indices in the correct order.
         typedef MultiIndexMap_t<UnpackedDimIndexTyple,typename Operand::FreeDimIndexTyple> OperandIndexMap;
         static typename OperandIndexMap::EvalMapType const operand_index_map = OperandIndexMap::eval;
-        static typename BundleIndexMap::T const bundle_index_map = BundleIndexMap::V;
         // | is concatenation of MultiIndex_t instances
         return m_operand[operand_index_map(m.template leading_tuple<MultiIndex::LENGTH-1>()
                                            |
-                                           bundle_index_map(m.template el<MultiIndex::LENGTH-1>()))];
+                                           m_bundle_index_table[m.template el<MultiIndex::LENGTH-1>()])];
     }
 
     bool overlaps_memory_range (Uint8 const *ptr, Uint32 range) const
@@ -485,6 +592,120 @@ private:
     void operator = (IndexBundle_t const &);
 
     Operand m_operand;
+    BundleIndexTable const &m_bundle_index_table;
+};
+
+// precomputed split of each component of the tensor product that SourceFactor_ embeds in,
+// indexed by its row-major component index: whether it is a procedural zero, and if not, the
+// component of SourceFactor_ that it reads and the scalar factor to apply.  this turns the
+// vector_index_of and scalar_factor_for_component computations of a split access into lookups.
+template <typename SourceFactor_,
+          typename Scalar_,
+          bool IS_TABULATED_ = IndexMapIsTabulated_f<SourceFactor_,
+                                                     DimensionOf_f<typename AS_EMBEDDABLE_IN_TENSOR_PRODUCT_OF_BASED_VECTOR_SPACES(SourceFactor_)::TensorProductOfBasedVectorSpaces>::V>::V>
+struct SplitIndexTable_t
+{
+    // TODO: the use of UseMemberArray_t<ComponentsAreConst::FALSE> here is arbitrary because it's just used to access a
+    // static method.  figure out if this is a problem
+    typedef ImplementationOf_t<SourceFactor_,Scalar_,UseMemberArray_t<ComponentsAreConst::FALSE>> ImplementationOfSourceFactor;
+    typedef typename ImplementationOfSourceFactor::MultiIndex SourceFactorMultiIndex;
+    typedef ComponentIndex_t<DimensionOf_f<SourceFactor_>::V> SourceFactorComponentIndex;
+
+    static Uint32 const DIM = SourceFactorMultiIndex::COMPONENT_COUNT;
+
+    // the table is constructed on first use, so it doesn't depend on static
+    // initialization order.
+    static SplitIndexTable_t const &instance ()
+    {
+        static SplitIndexTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    bool component_is_procedural_zero (Uint32 i) const { return m_is_procedural_zero[i]; }
+    SourceFactorComponentIndex const &vector_index (Uint32 i) const { return m_vector_index[i]; }
+    Scalar_ scalar_factor (Uint32 i) const { return m_scalar_factor[i]; }
+
+private:
+
+    SplitIndexTable_t ()
+    {
+        // iterating over the table index (rather than the multi-index) makes the bound
+        // visible to the compiler, which otherwise can't tell that a 1-dimensional table
+        // is written only at index 0 (and warns under -Warray-bounds).
+        for (Uint32 i = 0; i < DIM; ++i)
+        {
+            SourceFactorMultiIndex s(ComponentIndex_t<DIM>(i, CheckRange::FALSE));
+            m_is_procedural_zero[i] = ImplementationOfSourceFactor::component_is_procedural_zero(s);
+            if (m_is_procedural_zero[i])
+            {
+                m_vector_index[i] = SourceFactorComponentIndex(0, CheckRange::FALSE);
+                m_scalar_factor[i] = Scalar_(0);
+            }
+            else
+            {
+                m_vector_index[i] = SourceFactorComponentIndex(ImplementationOfSourceFactor::vector_index_of(s));
+                m_scalar_factor[i] = ImplementationOfSourceFactor::scalar_factor_for_component(s);
+            }
+        }
+    }
+
+    bool m_is_procedural_zero[DIM];
+    SourceFactorComponentIndex m_vector_index[DIM];
+    Scalar_ m_scalar_factor[DIM];
+};
+
+// an untabulated split computes vector_index_of and scalar_factor_for_component on each access.
+template <typename SourceFactor_, typename Scalar_>
+struct SplitIndexTable_t<SourceFactor_,Scalar_,false>
+{
+    typedef ImplementationOf_t<SourceFactor_,Scalar_,UseMemberArray_t<ComponentsAreConst::FALSE>> ImplementationOfSourceFactor;
+    typedef typename ImplementationOfSourceFactor::MultiIndex SourceFactorMultiIndex;
+    typedef ComponentIndex_t<DimensionOf_f<SourceFactor_>::V> SourceFactorComponentIndex;
+
+    static SplitIndexTable_t const &instance ()
+    {
+        static SplitIndexTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    bool component_is_procedural_zero (Uint32 i) const
+    {
+        return ImplementationOfSourceFactor::component_is_procedural_zero(multi_index(i));
+    }
+    SourceFactorComponentIndex vector_index (Uint32 i) const
+    {
+        return SourceFactorComponentIndex(ImplementationOfSourceFactor::vector_index_of(multi_index(i)));
+    }
+    Scalar_ scalar_factor (Uint32 i) const
+    {
+        return ImplementationOfSourceFactor::scalar_factor_for_component(multi_index(i));
+    }
+
+private:
+
+    static SourceFactorMultiIndex multi_index (Uint32 i)
+    {
+        return SourceFactorMultiIndex(ComponentIndex_t<SourceFactorMultiIndex::COMPONENT_COUNT>(i, CheckRange::FALSE));
+    }
+};
+
+// splitting a tensor product is just the row-major reinterpretation of its component
+// index, so there is nothing to look up; this inlines to direct access of the same
+// components of the operand.
+template <typename FactorTyple_, typename Scalar_>
+struct SplitIndexTable_t<TensorProductOfBasedVectorSpaces_c<FactorTyple_>,Scalar_,false>
+{
+    typedef ComponentIndex_t<DimensionOf_f<TensorProductOfBasedVectorSpaces_c<FactorTyple_>>::V> SourceFactorComponentIndex;
+
+    static SplitIndexTable_t const &instance ()
+    {
+        static SplitIndexTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    bool component_is_procedural_zero (Uint32) const { return false; }
+    SourceFactorComponentIndex vector_index (Uint32 i) const { return SourceFactorComponentIndex(i, CheckRange::FALSE); }
+    Scalar_ scalar_factor (Uint32) const { return Scalar_(1); }
 };
 
 // not an expression template, but just something that handles the split indices
@@ -527,28 +748,30 @@ struct IndexSplitter_t
 
     static_assert(Length_f<FactorTyple>::V == Length_f<DimIndexTyple>::V, "must have same number of factors and indices");
 
-    IndexSplitter_t (Operand const &operand) : m_operand(operand) { }
+    typedef SplitIndexTable_t<SourceFactor,Scalar> SplitIndexTable;
+
+    IndexSplitter_t (Operand const &operand)
+        :
+        m_operand(operand),
+        m_split_index_table(SplitIndexTable::instance())
+    { }
 
     Scalar operator [] (MultiIndex const &m) const
     {
         typedef typename DimIndexTypleOf_f<typename FactorTypleOf_f<typename AS_EMBEDDABLE_IN_TENSOR_PRODUCT_OF_VECTOR_SPACES(SourceFactor)::TensorProductOfVectorSpaces>::T,
                                            SplitAbstractIndexTyple>::T SourceFactorDimIndexTyple;
-        typedef ComponentIndex_t<DimensionOf_f<SourceFactor>::V> SourceFactorComponentIndex;
         typedef MultiIndex_t<SourceFactorDimIndexTyple> SourceFactorMultiIndex;
-        // TODO: the use of UseMemberArray_t<ComponentsAreConst::FALSE> here is arbitrary because it's just used to access a
-        // static method.  figure out if this is a problem
-        typedef ImplementationOf_t<SourceFactor,Scalar,UseMemberArray_t<ComponentsAreConst::FALSE>> ImplementationOfSourceFactor;
 
-        SourceFactorMultiIndex s(m.template range<SOURCE_INDEX_TYPE_INDEX,SOURCE_INDEX_TYPE_INDEX+Length_f<SplitAbstractIndexTyple>::V>());
-        if (ImplementationOfSourceFactor::component_is_procedural_zero(s))
+        // the row-major component index of the split indices is all that's needed to look up the split.
+        Uint32 s = SourceFactorMultiIndex(m.template range<SOURCE_INDEX_TYPE_INDEX,SOURCE_INDEX_TYPE_INDEX+Length_f<SplitAbstractIndexTyple>::V>()).value();
+        if (m_split_index_table.component_is_procedural_zero(s))
             return Scalar(0);
 
-        SourceFactorComponentIndex i(ImplementationOfSourceFactor::vector_index_of(s));
         // this replaces the SplitAbstractIndexTyple portion with SourceAbstractIndexType
         typename Operand::MultiIndex c_rebundled(m.template leading_tuple<SOURCE_INDEX_TYPE_INDEX>()
                                                  |
-                                                 (i >>= m.template trailing_tuple<SOURCE_INDEX_TYPE_INDEX+Length_f<SplitAbstractIndexTyple>::V>()));
-        return ImplementationOfSourceFactor::scalar_factor_for_component(s) * m_operand[c_rebundled];
+                                                 (m_split_index_table.vector_index(s) >>= m.template trailing_tuple<SOURCE_INDEX_TYPE_INDEX+Length_f<SplitAbstractIndexTyple>::V>()));
+        return m_split_index_table.scalar_factor(s) * m_operand[c_rebundled];
     }
 
     bool overlaps_memory_range (Uint8 const *ptr, Uint32 range) const
@@ -563,6 +786,7 @@ private:
     void operator = (IndexSplitter_t const &);
 
     Operand m_operand;
+    SplitIndexTable const &m_split_index_table;
 };
 
 // not an expression template, but just something that handles the split indices
@@ -597,27 +821,26 @@ struct IndexSplitToIndex_t
 
     static_assert(Length_f<FactorTyple>::V == Length_f<DimIndexTyple>::V, "must have same number of factors and indices");
 
-    IndexSplitToIndex_t (Operand const &operand) : m_operand(operand) { }
+    typedef SplitIndexTable_t<SourceFactor,Scalar> SplitIndexTable;
+
+    IndexSplitToIndex_t (Operand const &operand)
+        :
+        m_operand(operand),
+        m_split_index_table(SplitIndexTable::instance())
+    { }
 
     Scalar operator [] (MultiIndex const &m) const
     {
-        typedef ComponentIndex_t<DimensionOf_f<SourceFactor>::V> SourceFactorComponentIndex;
-        // TODO: the use of UseMemberArray_t<ComponentsAreConst::FALSE> here is arbitrary because it's just used to access a
-        // static method.  figure out if this is a problem
-        typedef ImplementationOf_t<SourceFactor,Scalar,UseMemberArray_t<ComponentsAreConst::FALSE>> ImplementationOfSourceFactor;
-        typedef typename ImplementationOfSourceFactor::MultiIndex SourceFactorMultiIndex;
-
-        // this does the vector-index to multi-index conversion
-        SourceFactorMultiIndex s(m.template el<SOURCE_INDEX_TYPE_INDEX>());
-        if (ImplementationOfSourceFactor::component_is_procedural_zero(s))
+        // the split index is already the row-major component index of the tensor product.
+        Uint32 s = m.template el<SOURCE_INDEX_TYPE_INDEX>().value();
+        if (m_split_index_table.component_is_procedural_zero(s))
             return Scalar(0);
 
-        SourceFactorComponentIndex i(ImplementationOfSourceFactor::vector_index_of(s));
         // this replaces the SplitAbstractIndexType_ portion with SourceAbstractIndexType
         typename Operand::MultiIndex c_rebundled(m.template leading_tuple<SOURCE_INDEX_TYPE_INDEX>()
                                                  |
-                                                 (i >>= m.template trailing_tuple<SOURCE_INDEX_TYPE_INDEX+1>()));
-        return ImplementationOfSourceFactor::scalar_factor_for_component(s) * m_operand[c_rebundled];
+                                                 (m_split_index_table.vector_index(s) >>= m.template trailing_tuple<SOURCE_INDEX_TYPE_INDEX+1>()));
+        return m_split_index_table.scalar_factor(s) * m_operand[c_rebundled];
     }
 
     bool overlaps_memory_range (Uint8 const *ptr, Uint32 range) const
@@ -632,6 +855,7 @@ private:
     void operator = (IndexSplitToIndex_t const &);
 
     Operand m_operand;
+    SplitIndexTable const &m_split_index_table;
 };
 
 // not an expression template, but just something that handles the embedded indices
@@ -650,10 +874,13 @@ struct IndexEmbedder_t
     static_assert(Contains_f<OperandFreeAbstractIndexTyple,SourceAbstractIndexType_>::V, "source index must be free");
     static_assert(!TypesAreEqual_f<SourceAbstractIndexType_,EmbeddedAbstractIndexType_>::V, "source and embedded indices must be distinct");
 
+    typedef Operand_ Operand;
     typedef typename Operand_::Scalar Scalar;
     // we must replace SourceAbstractIndexType_ with EmbeddedAbstractIndexType_ in the index typle
     static Uint32 const SOURCE_INDEX_TYPE_INDEX = IndexOfFirstOccurrence_f<OperandFreeAbstractIndexTyple,SourceAbstractIndexType_>::V;
     typedef typename Element_f<typename Operand_::FreeFactorTyple,SOURCE_INDEX_TYPE_INDEX>::T EmbeddingDomain;
+    typedef EmbeddingCodomain_ EmbeddingCodomain;
+    typedef EmbeddingId_ EmbeddingId;
 
     typedef typename ConcatTyples_f<
         typename LeadingTyple_f<typename Operand_::FreeFactorTyple,SOURCE_INDEX_TYPE_INDEX>::T,
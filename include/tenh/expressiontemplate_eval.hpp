@@ -8,6 +8,9 @@
 
 #include "tenh/core.hpp"
 
+#include <bitset>
+#include <memory>
+
 #include "tenh/implementation/tensor.hpp"
 #include "tenh/interface/expressiontemplate.hpp"
 
@@ -56,21 +59,6 @@ struct ExpressionTemplate_Eval_t
 //         return operator[](MultiIndex());
 //     }
 
-    // requires InnerProduct_t to be implemented for all free-indexed types
-    // NOTE: will not currently work for complex types
-    typename AssociatedFloatingPointType_t<Scalar>::T squared_norm () const
-    {
-        ensure_tensor_is_cached();
-        return m_cached_tensor.squared_norm();
-    }
-    // requires InnerProduct_t to be implemented for all free-indexed types
-    // NOTE: will not currently work for complex types
-    typename AssociatedFloatingPointType_t<Scalar>::T norm () const
-    {
-        this->ensure_tensor_is_cached();
-        return m_cached_tensor.norm();
-    }
-
     Scalar const &operator [] (MultiIndex const &m) const
     {
         this->ensure_tensor_is_cached();
@@ -130,18 +118,117 @@ private:
     IsExpressionTemplate_f();
 };
 
-// definitions of the squared_norm and norm methods of ExpressionTemplate_i had to wait until ExpressionTemplate_Eval_t was defined.
-template <typename Derived, typename Scalar, typename FreeFactorTyple, typename FreeIndexTyple, typename UsedIndexTyple>
-typename AssociatedFloatingPointType_t<Scalar>::T ExpressionTemplate_i<Derived,Scalar,FreeFactorTyple,FreeIndexTyple,UsedIndexTyple>::squared_norm () const
+// ////////////////////////////////////////////////////////////////////////////
+// component-level memoization of an indexed expression
+// ////////////////////////////////////////////////////////////////////////////
+
+// this is an expression template which evaluates the components of its operand
+// only as they are accessed, caching each one the first time it is computed.
+// this is meant for expensive intermediates of which only a few components are
+// read, where ExpressionTemplate_Eval_t would evaluate every component.  unlike
+// ExpressionTemplate_Eval_t, the operand is held by value (as the other expression
+// templates do), so the memoized expression may outlive the full-expression which
+// created it, e.g.
+//   auto m = (a(i*j)*b(j*k)).memoize();
+// the cache is held by a shared handle, so copies (including the ones made when the
+// memoized expression is used as an operand of a larger expression) share the cached
+// components.  storage for the components is allocated in blocks of BLOCK_SIZE, each
+// on the first access of one of its components, so the memory used is proportional
+// to the spread of the components which are read, not to COMPONENT_COUNT.
+// NOTE: the objects referenced by the operand must not change while components
+// are cached; call invalidate() if they do.
+template <typename Operand>
+struct ExpressionTemplate_Memoize_t
+    :
+    public ExpressionTemplate_i<ExpressionTemplate_Memoize_t<Operand>,
+                                typename Operand::Scalar,
+                                typename Operand::FreeFactorTyple,
+                                typename Operand::FreeDimIndexTyple,
+                                typename Operand::UsedDimIndexTyple>
 {
-    return eval().squared_norm();
-}
+    static_assert(IsExpressionTemplate_f<Operand>::V, "Operand must be an ExpressionTemplate_i");
 
-template <typename Derived, typename Scalar, typename FreeFactorTyple, typename FreeIndexTyple, typename UsedIndexTyple>
-typename AssociatedFloatingPointType_t<Scalar>::T ExpressionTemplate_i<Derived,Scalar,FreeFactorTyple,FreeIndexTyple,UsedIndexTyple>::norm () const
+    typedef ExpressionTemplate_i<ExpressionTemplate_Memoize_t<Operand>,
+                                 typename Operand::Scalar,
+                                 typename Operand::FreeFactorTyple,
+                                 typename Operand::FreeDimIndexTyple,
+                                 typename Operand::UsedDimIndexTyple> Parent;
+    typedef typename Parent::Derived Derived;
+    typedef typename Parent::Scalar Scalar;
+    typedef typename Parent::FreeFactorTyple FreeFactorTyple;
+    typedef typename Parent::FreeDimIndexTyple FreeDimIndexTyple;
+    typedef typename Parent::UsedDimIndexTyple UsedDimIndexTyple;
+    typedef typename Parent::MultiIndex MultiIndex;
+
+    static Uint32 const COMPONENT_COUNT = MultiIndex::COMPONENT_COUNT;
+    static Uint32 const BLOCK_SIZE = 64;
+    static Uint32 const BLOCK_COUNT = (COMPONENT_COUNT + BLOCK_SIZE - 1) / BLOCK_SIZE;
+
+    ExpressionTemplate_Memoize_t (Operand const &operand)
+        :
+        m_operand(operand),
+        m_cache(std::make_shared<Cache>())
+    { }
+
+    Scalar const &operator [] (MultiIndex const &m) const
+    {
+        Uint32 i = m.value();
+        std::unique_ptr<Scalar[]> &block = m_cache->blocks[i / BLOCK_SIZE];
+        if (!m_cache->component_is_cached[i])
+        {
+            if (!block)
+            {
+                // the last block may be partial
+                Uint32 remaining_count = COMPONENT_COUNT - i / BLOCK_SIZE * BLOCK_SIZE;
+                block.reset(new Scalar[remaining_count < BLOCK_SIZE ? remaining_count : BLOCK_SIZE]);
+            }
+            block[i % BLOCK_SIZE] = m_operand[m];
+            m_cache->component_is_cached[i] = true;
+        }
+        return block[i % BLOCK_SIZE];
+    }
+
+    bool component_is_cached (MultiIndex const &m) const { return m_cache->component_is_cached[m.value()]; }
+    Uint32 cached_component_count () const { return m_cache->component_is_cached.count(); }
+    // discards all cached components (for every copy of this expression), e.g. after the
+    // objects referenced by the operand have changed.
+    void invalidate () const { m_cache->component_is_cached.reset(); }
+
+    // the components are computed from the operand lazily, so assignment to an object
+    // the operand reads from must be checked for aliasing just as the operand would be.
+    bool overlaps_memory_range (Uint8 const *ptr, Uint32 range) const
+    {
+        return m_operand.overlaps_memory_range(ptr, range);
+    }
+
+    Operand const &operand () const { return m_operand; }
+
+    static std::string type_as_string (bool verbose)
+    {
+        return "ExpressionTemplate_Memoize_t<" + type_string_of<Operand>() + '>';
+    }
+
+private:
+
+    struct Cache
+    {
+        std::bitset<COMPONENT_COUNT> component_is_cached;
+        std::unique_ptr<Scalar[]> blocks[BLOCK_COUNT];
+    };
+
+    void operator = (ExpressionTemplate_Memoize_t const &);
+
+    Operand m_operand;
+    std::shared_ptr<Cache> m_cache;
+};
+
+template <typename Operand_>
+struct IsExpressionTemplate_f<ExpressionTemplate_Memoize_t<Operand_>>
 {
-    return eval().norm();
-}
+    static bool const V = true;
+private:
+    IsExpressionTemplate_f();
+};
 
 } // end of namespace Tenh
 
@@ -0,0 +1,309 @@
+// ///////////////////////////////////////////////////////////////////////////
+// tenh/expressiontemplate_plan.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#ifndef TENH_EXPRESSIONTEMPLATE_PLAN_HPP_
+#define TENH_EXPRESSIONTEMPLATE_PLAN_HPP_
+
+#include "tenh/core.hpp"
+
+#include <vector>
+
+#include "tenh/expression_templates.hpp"
+#include "tenh/expressiontemplate_eval.hpp"
+
+namespace Tenh {
+
+// ////////////////////////////////////////////////////////////////////////////
+// counting the scalar operations of an expression template
+// ////////////////////////////////////////////////////////////////////////////
+
+// the number of terms in a summation over the given summed indices (1 if there are none).
+template <typename SummedDimIndexTyple_>
+struct SummationTermCount_f
+{
+    static Uint32 const V = Length_f<SummedDimIndexTyple_>::V == 0 ? 1 : MultiIndex_t<SummedDimIndexTyple_>::COMPONENT_COUNT;
+private:
+    SummationTermCount_f();
+};
+
+// the numbers of scalar additions and multiplications (subtractions and divisions are
+// counted as such) done in evaluating a single component of Expression_.  index maps
+// (the tables or computations of split and bundle, and the linear embeddings of embed
+// and coembed) aren't counted, but their scale factors are.  because the number of
+// terms in a component of a coembed varies, the average over its components is used.
+template <typename Expression_>
+struct OperationCountOf_f
+{
+    static_assert(TypesAreEqual_f<Expression_,Expression_>::V && false, "OperationCountOf_f is not implemented for this expression template");
+private:
+    OperationCountOf_f();
+};
+
+// the cost of a sum of TERM_COUNT_ terms, each of which takes OPERAND_ADDITIONS_ and
+// OPERAND_MULTIPLICATIONS_, scaled by SCALE_MULTIPLICATIONS_ extra multiplications.
+template <Uint32 TERM_COUNT_, Uint32 OPERAND_ADDITIONS_, Uint32 OPERAND_MULTIPLICATIONS_, Uint32 SCALE_MULTIPLICATIONS_>
+struct SumOperationCount_t
+{
+    static Uint32 const TERM_COUNT = TERM_COUNT_;
+    static Uint32 const ADDITIONS = TERM_COUNT*OPERAND_ADDITIONS_ + (TERM_COUNT - 1);
+    static Uint32 const MULTIPLICATIONS = TERM_COUNT*(OPERAND_MULTIPLICATIONS_ + SCALE_MULTIPLICATIONS_);
+private:
+    SumOperationCount_t();
+};
+
+// helper for the expression templates which are summations of an operand's components
+// (e.g. a trace) over the given summed indices.
+template <typename SummedDimIndexTyple_, Uint32 OPERAND_ADDITIONS_, Uint32 OPERAND_MULTIPLICATIONS_, Uint32 SCALE_MULTIPLICATIONS_>
+struct SummedOperationCount_t
+    :
+    public SumOperationCount_t<SummationTermCount_f<SummedDimIndexTyple_>::V,OPERAND_ADDITIONS_,OPERAND_MULTIPLICATIONS_,SCALE_MULTIPLICATIONS_>
+{ };
+
+// a terminal object, possibly with summed indices (e.g. a trace)
+template <typename Object_,
+          typename FactorTyple_,
+          typename DimIndexTyple_,
+          typename SummedDimIndexTyple_,
+          ForceConst FORCE_CONST_,
+          CheckForAliasing CHECK_FOR_ALIASING_>
+struct OperationCountOf_f<ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,SummedDimIndexTyple_,FORCE_CONST_,CHECK_FOR_ALIASING_,NullType>>
+    :
+    public SummedOperationCount_t<SummedDimIndexTyple_,0,0,0>
+{ };
+
+template <typename Operand_, typename BundleAbstractIndexTyple_, typename ResultingFactorType_, typename ResultingAbstractIndexType_, CheckFactorTypes CHECK_FACTOR_TYPES_>
+struct OperationCountOf_f<ExpressionTemplate_IndexBundle_t<Operand_,BundleAbstractIndexTyple_,ResultingFactorType_,ResultingAbstractIndexType_,CHECK_FACTOR_TYPES_>>
+    :
+    public SummedOperationCount_t<typename ExpressionTemplate_IndexBundle_t<Operand_,BundleAbstractIndexTyple_,ResultingFactorType_,ResultingAbstractIndexType_,CHECK_FACTOR_TYPES_>::SummedDimIndexTyple,
+                                  OperationCountOf_f<Operand_>::ADDITIONS,
+                                  OperationCountOf_f<Operand_>::MULTIPLICATIONS,
+                                  0>
+{ };
+
+template <typename Operand_, typename SourceAbstractIndexType_, typename SplitAbstractIndexTyple_>
+struct OperationCountOf_f<ExpressionTemplate_IndexSplit_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexTyple_>>
+    :
+    public SummedOperationCount_t<typename ExpressionTemplate_IndexSplit_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexTyple_>::SummedDimIndexTyple,
+                                  OperationCountOf_f<Operand_>::ADDITIONS,
+                                  OperationCountOf_f<Operand_>::MULTIPLICATIONS,
+                                  1>
+{ };
+
+template <typename Operand_, typename SourceAbstractIndexType_, typename SplitAbstractIndexType_>
+struct OperationCountOf_f<ExpressionTemplate_IndexSplitToIndex_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexType_>>
+    :
+    public SummedOperationCount_t<typename ExpressionTemplate_IndexSplitToIndex_t<Operand_,SourceAbstractIndexType_,SplitAbstractIndexType_>::SummedDimIndexTyple,
+                                  OperationCountOf_f<Operand_>::ADDITIONS,
+                                  OperationCountOf_f<Operand_>::MULTIPLICATIONS,
+                                  1>
+{ };
+
+template <typename Operand_, typename SourceAbstractIndexType_, typename EmbeddingCodomain_, typename EmbeddedAbstractIndexType_, typename EmbeddingId_>
+struct OperationCountOf_f<ExpressionTemplate_IndexEmbed_t<Operand_,SourceAbstractIndexType_,EmbeddingCodomain_,EmbeddedAbstractIndexType_,EmbeddingId_>>
+    :
+    public SummedOperationCount_t<typename ExpressionTemplate_IndexEmbed_t<Operand_,SourceAbstractIndexType_,EmbeddingCodomain_,EmbeddedAbstractIndexType_,EmbeddingId_>::SummedDimIndexTyple,
+                                  OperationCountOf_f<Operand_>::ADDITIONS,
+                                  OperationCountOf_f<Operand_>::MULTIPLICATIONS,
+                                  1>
+{ };
+
+// the cost of a component of an IndexCoembedder_t, which is a sum over the terms of the
+// coembedding.  each component of CoembeddingDomain_ contributes to at most one component
+// of CoembeddingCodomain_, so the average number of terms is at most the ratio of their
+// dimensions (rounded up here).
+template <typename Operand_, typename CoembeddingDomain_, typename CoembeddingCodomain_>
+struct CoembedderOperationCount_t
+    :
+    public SumOperationCount_t<(DimensionOf_f<CoembeddingDomain_>::V + DimensionOf_f<CoembeddingCodomain_>::V - 1) / DimensionOf_f<CoembeddingCodomain_>::V,
+                               OperationCountOf_f<Operand_>::ADDITIONS,
+                               OperationCountOf_f<Operand_>::MULTIPLICATIONS,
+                               1>
+{ };
+
+template <typename Operand_, typename SourceAbstractIndexType_, typename CoembeddingCodomain_, typename CoembeddedAbstractIndexType_, typename EmbeddingId_>
+struct OperationCountOf_f<ExpressionTemplate_IndexCoembed_t<Operand_,SourceAbstractIndexType_,CoembeddingCodomain_,CoembeddedAbstractIndexType_,EmbeddingId_>>
+    :
+    public SummedOperationCount_t<typename ExpressionTemplate_IndexCoembed_t<Operand_,SourceAbstractIndexType_,CoembeddingCodomain_,CoembeddedAbstractIndexType_,EmbeddingId_>::SummedDimIndexTyple,
+                                  CoembedderOperationCount_t<Operand_,
+                                                             typename IndexCoembedder_t<Operand_,SourceAbstractIndexType_,CoembeddingCodomain_,CoembeddedAbstractIndexType_,EmbeddingId_>::CoembeddingDomain,
+                                                             CoembeddingCodomain_>::ADDITIONS,
+                                  CoembedderOperationCount_t<Operand_,
+                                                             typename IndexCoembedder_t<Operand_,SourceAbstractIndexType_,CoembeddingCodomain_,CoembeddedAbstractIndexType_,EmbeddingId_>::CoembeddingDomain,
+                                                             CoembeddingCodomain_>::MULTIPLICATIONS,
+                                  0>
+{ };
+
+// the given counts.  the specializations pass the counts of their operands as base
+// class arguments, so that instantiating the count of an expression also instantiates
+// (and so checks) the counts of all of its subexpressions.
+template <Uint32 ADDITIONS_, Uint32 MULTIPLICATIONS_>
+struct OperationCount_t
+{
+    static Uint32 const ADDITIONS = ADDITIONS_;
+    static Uint32 const MULTIPLICATIONS = MULTIPLICATIONS_;
+private:
+    OperationCount_t();
+};
+
+template <typename LeftOperand_, typename RightOperand_, char OPERATOR_>
+struct OperationCountOf_f<ExpressionTemplate_Addition_t<LeftOperand_,RightOperand_,OPERATOR_>>
+    :
+    public OperationCount_t<OperationCountOf_f<LeftOperand_>::ADDITIONS + OperationCountOf_f<RightOperand_>::ADDITIONS + 1,
+                            OperationCountOf_f<LeftOperand_>::MULTIPLICATIONS + OperationCountOf_f<RightOperand_>::MULTIPLICATIONS>
+{ };
+
+template <typename Operand_, typename Scalar_, char OPERATOR_>
+struct OperationCountOf_f<ExpressionTemplate_ScalarMultiplication_t<Operand_,Scalar_,OPERATOR_>>
+    :
+    public OperationCount_t<OperationCountOf_f<Operand_>::ADDITIONS,
+                            OperationCountOf_f<Operand_>::MULTIPLICATIONS + 1>
+{ };
+
+template <typename LeftOperand_, typename RightOperand_, typename SummationPolicy_>
+struct OperationCountOf_f<ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_,SummationPolicy_>>
+    :
+    public SummedOperationCount_t<typename ExpressionTemplate_Multiplication_t<LeftOperand_,RightOperand_,SummationPolicy_>::SummedDimIndexTyple,
+                                  OperationCountOf_f<LeftOperand_>::ADDITIONS + OperationCountOf_f<RightOperand_>::ADDITIONS,
+                                  OperationCountOf_f<LeftOperand_>::MULTIPLICATIONS + OperationCountOf_f<RightOperand_>::MULTIPLICATIONS,
+                                  1>
+{ };
+
+// eval() and memoize() cache the components they compute, and eval() references its
+// (usually temporary) operand, so they can't be part of an expression which is kept
+// and executed repeatedly.  these specializations exist only to say so.
+template <typename Operand_>
+struct OperationCountOf_f<ExpressionTemplate_Eval_t<Operand_>>
+{
+    static_assert(TypesAreEqual_f<Operand_,Operand_>::V && false, "eval() can't be used in a planned assignment, since its cache would be stale on repeated execution");
+private:
+    OperationCountOf_f();
+};
+
+template <typename Operand_>
+struct OperationCountOf_f<ExpressionTemplate_Memoize_t<Operand_>>
+{
+    static_assert(TypesAreEqual_f<Operand_,Operand_>::V && false, "memoize() can't be used in a planned assignment, since its cache would be stale on repeated execution");
+private:
+    OperationCountOf_f();
+};
+
+// ////////////////////////////////////////////////////////////////////////////
+// capturing an indexed assignment for repeated execution
+// ////////////////////////////////////////////////////////////////////////////
+
+// an indexed assignment destination(...) = expression which has been analyzed once,
+// so that it can be executed repeatedly (e.g. once per frame) without redoing the
+// aliasing analysis of the assignment operator.  the objects referenced by the
+// expression are referenced by the plan, so if they use UsePreallocatedArray_t,
+// they can be pointed at new data (via set_pointer_to_allocation) between executions.
+// if doing so could change whether the destination memory overlaps that of the
+// expression, call analyze_aliasing() after rebinding -- execute() asserts this.
+template <typename Destination_, typename Expression_>
+struct AssignmentPlan_t;
+
+template <typename Object_,
+          typename FactorTyple_,
+          typename DimIndexTyple_,
+          CheckForAliasing CHECK_FOR_ALIASING_,
+          typename Expression_>
+struct AssignmentPlan_t<ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,Typle_t<>,ForceConst::FALSE,CHECK_FOR_ALIASING_,NullType>,
+                        Expression_>
+{
+    typedef ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,Typle_t<>,ForceConst::FALSE,CHECK_FOR_ALIASING_,NullType> Destination;
+    typedef ExpressionTemplate_IndexedObject_t<Object_,FactorTyple_,DimIndexTyple_,Typle_t<>,ForceConst::FALSE,CheckForAliasing::FALSE,NullType> UncheckedDestination;
+    typedef typename Destination::Scalar Scalar;
+    typedef typename Destination::MultiIndex MultiIndex;
+
+    static_assert(IsExpressionTemplate_f<Expression_>::V, "Expression_ must be an ExpressionTemplate_i");
+    static_assert(TypesAreEqual_f<Scalar,typename Expression_::Scalar>::V, "operand scalar types must be equal");
+    static_assert(AreEqualAsSets_f<typename Destination::FreeDimIndexTyple,typename Expression_::FreeDimIndexTyple>::V, "operands must have same free indices");
+    // this instantiates OperationCountOf_f<Expression_>, which rejects eval() and memoize()
+    static_assert(sizeof(OperationCountOf_f<Expression_>) > 0, "Expression_ must be countable");
+
+    static Uint32 const COMPONENT_COUNT = MultiIndex::COMPONENT_COUNT;
+
+    AssignmentPlan_t (Destination const &destination, Expression_ const &expression)
+        :
+        m_object(destination.object()),
+        m_expression(expression),
+        m_uses_temporary(false)
+    {
+        analyze_aliasing();
+    }
+
+    void execute () const
+    {
+        assert(m_uses_temporary == is_unsafely_aliased() && "aliasing has changed since the plan was made; call analyze_aliasing()");
+        if (m_uses_temporary)
+        {
+            // the temporary is kept by the plan, so repeated execution doesn't allocate.
+            typedef MultiIndexMap_t<typename Destination::FreeDimIndexTyple,typename Expression_::FreeDimIndexTyple> ExpressionIndexMap;
+            typename ExpressionIndexMap::EvalMapType expression_index_map = ExpressionIndexMap::eval;
+            for (MultiIndex m; m.is_not_at_end(); ++m)
+                m_temporary[m.value()] = m_expression[expression_index_map(m)];
+            for (MultiIndex m; m.is_not_at_end(); ++m)
+                m_object[m] = m_temporary[m.value()];
+        }
+        else
+        {
+            UncheckedDestination destination(m_object);
+            destination = m_expression;
+        }
+    }
+
+    // redoes the aliasing analysis, e.g. after the objects have been rebound to other memory.
+    void analyze_aliasing ()
+    {
+        m_uses_temporary = is_unsafely_aliased();
+        if (m_uses_temporary)
+            m_temporary.resize(COMPONENT_COUNT);
+    }
+    // true iff the expression is evaluated into a temporary before being assigned.
+    bool uses_temporary () const { return m_uses_temporary; }
+
+    // the numbers of scalar operations done by each execution (not counting the copy out
+    // of the temporary, if one is used).
+    static Uint32 addition_count () { return COMPONENT_COUNT*OperationCountOf_f<Expression_>::ADDITIONS; }
+    static Uint32 multiplication_count () { return COMPONENT_COUNT*OperationCountOf_f<Expression_>::MULTIPLICATIONS; }
+    static Uint32 operation_count () { return addition_count() + multiplication_count(); }
+
+    Object_ &object () const { return m_object; }
+    Expression_ const &expression () const { return m_expression; }
+
+    static std::string type_as_string (bool verbose)
+    {
+        return "AssignmentPlan_t<" + type_string_of<Destination>() + ',' + type_string_of<Expression_>() + '>';
+    }
+
+private:
+
+    bool is_unsafely_aliased () const
+    {
+        if (!bool(CHECK_FOR_ALIASING_))
+            return false;
+
+        AliasingDestination_t destination(m_object);
+        return !ElementwiseAliasing_t<Expression_,Object_,FactorTyple_,DimIndexTyple_>::is_safe(m_expression, destination);
+    }
+
+    void operator = (AssignmentPlan_t const &);
+
+    Object_ &m_object;
+    Expression_ m_expression;
+    bool m_uses_temporary;
+    mutable std::vector<Scalar> m_temporary;
+};
+
+// convenience function for making an AssignmentPlan_t, e.g.
+//   auto plan = plan_assignment(y(i), a(i*j)*x(j));
+//   plan.execute();
+template <typename Destination_, typename Expression_>
+AssignmentPlan_t<Destination_,Expression_> plan_assignment (Destination_ const &destination, Expression_ const &expression)
+{
+    return AssignmentPlan_t<Destination_,Expression_>(destination, expression);
+}
+
+} // end of namespace Tenh
+
+#endif // TENH_EXPRESSIONTEMPLATE_PLAN_HPP_
@@ -94,16 +94,16 @@ typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
     reindexed (ExpressionTemplate_ScalarMultiplication_t<Operand,Scalar_,OPERATOR> &e);
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
-          typename LeftOperand, typename RightOperand>
+          typename LeftOperand, typename RightOperand, typename SummationPolicy>
 typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>::T
-    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand> const &e);
+         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>::T
+    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy> const &e);
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
-          typename LeftOperand, typename RightOperand>
+          typename LeftOperand, typename RightOperand, typename SummationPolicy>
 typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>::T
-    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand> &e);
+         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>::T
+    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy> &e);
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
           typename Operand, typename BundleAbstractIndexTyple, typename ResultingFactorType, typename ResultingAbstractIndexType, CheckFactorTypes CHECK_FACTOR_TYPES_>
@@ -173,6 +173,12 @@ typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
          ::template Eval_f<ExpressionTemplate_Eval_t<Operand>>::T
     reindexed (ExpressionTemplate_Eval_t<Operand> &e);
 
+template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
+          typename Operand>
+typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
+         ::template Eval_f<ExpressionTemplate_Memoize_t<Operand>>::T
+    reindexed (ExpressionTemplate_Memoize_t<Operand> const &e);
+
 // ///////////////////////////////////////////////////////////////////////////
 // Reindex_e<...>::Eval_f and reindexed<...>() for all the templates
 // in tenh/expression_templates.hpp -- they parallel each expression template
@@ -377,40 +383,41 @@ typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
 // ///////////////////////////////////////////////////////////////////////////
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_>
-template <typename LeftOperand, typename RightOperand>
+template <typename LeftOperand, typename RightOperand, typename SummationPolicy>
 struct Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-    ::Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>
+    ::Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>
 {
 private:
     typedef Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_> Reindex;
     Eval_f();
 public:
     typedef ExpressionTemplate_Multiplication_t<typename Reindex::template Eval_f<LeftOperand>::T,
-                                                typename Reindex::template Eval_f<RightOperand>::T> T;
+                                                typename Reindex::template Eval_f<RightOperand>::T,
+                                                SummationPolicy> T;
 };
 
 // unfortunately you have to make a const and a non-const version of each
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
-          typename LeftOperand, typename RightOperand>
+          typename LeftOperand, typename RightOperand, typename SummationPolicy>
 typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>::T
-    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand> const &e)
+         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>::T
+    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy> const &e)
 {
     typedef typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-                     ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>::T Reindexed;
+                     ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>::T Reindexed;
     return Reindexed(reindexed<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>(e.left_operand()),
                      reindexed<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>(e.right_operand()));
 }
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
-          typename LeftOperand, typename RightOperand>
+          typename LeftOperand, typename RightOperand, typename SummationPolicy>
 typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>::T
-    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand> &e)
+         ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>::T
+    reindexed (ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy> &e)
 {
     typedef typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-                     ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand>>::T Reindexed;
+                     ::template Eval_f<ExpressionTemplate_Multiplication_t<LeftOperand,RightOperand,SummationPolicy>>::T Reindexed;
     return Reindexed(reindexed<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>(e.left_operand()),
                      reindexed<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>(e.right_operand()));
 }
@@ -609,9 +616,9 @@ typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
 // ///////////////////////////////////////////////////////////////////////////
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_>
-template <typename Tensor, typename TensorDimIndexTyple, typename SummedDimIndexTyple>
+template <typename Tensor, typename TensorDimIndexTyple, typename SummedDimIndexTyple, typename SummationPolicy>
 struct Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-    ::Eval_f<UnarySummation_t<Tensor,TensorDimIndexTyple,SummedDimIndexTyple>>
+    ::Eval_f<UnarySummation_t<Tensor,TensorDimIndexTyple,SummedDimIndexTyple,SummationPolicy>>
 {
 private:
     typedef Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_> Reindex;
@@ -619,7 +626,8 @@ private:
 public:
     typedef UnarySummation_t<typename Reindex::template Eval_f<Tensor>::T,
                              typename Reindex::template Eval_f<TensorDimIndexTyple>::T,
-                             typename Reindex::template Eval_f<SummedDimIndexTyple>::T> T;
+                             typename Reindex::template Eval_f<SummedDimIndexTyple>::T,
+                             SummationPolicy> T;
 };
 
 // no reindex<...> function is necessary because this is made by the expression template
@@ -629,9 +637,9 @@ public:
 // ///////////////////////////////////////////////////////////////////////////
 
 template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_>
-template <typename LeftOperand, typename RightOperand, typename FreeDimIndexTyple, typename SummedDimIndexTyple>
+template <typename LeftOperand, typename RightOperand, typename FreeDimIndexTyple, typename SummedDimIndexTyple, typename SummationPolicy>
 struct Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
-    ::Eval_f<BinarySummation_t<LeftOperand,RightOperand,FreeDimIndexTyple,SummedDimIndexTyple>>
+    ::Eval_f<BinarySummation_t<LeftOperand,RightOperand,FreeDimIndexTyple,SummedDimIndexTyple,SummationPolicy>>
 {
 private:
     typedef Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_> Reindex;
@@ -640,7 +648,8 @@ public:
     typedef BinarySummation_t<typename Reindex::template Eval_f<LeftOperand>::T,
                               typename Reindex::template Eval_f<RightOperand>::T,
                               typename Reindex::template Eval_f<FreeDimIndexTyple>::T,
-                              typename Reindex::template Eval_f<SummedDimIndexTyple>::T> T;
+                              typename Reindex::template Eval_f<SummedDimIndexTyple>::T,
+                              SummationPolicy> T;
 };
 
 // no reindex<...> function is necessary because this is made by the expression template
@@ -751,6 +760,34 @@ typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
     return Reindexed(reindexed<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>(e.operand()));
 }
 
+// ///////////////////////////////////////////////////////////////////////////
+// Reindex_e<...>::Eval_f and reindexed<...>() for ExpressionTemplate_Memoize_t
+// ///////////////////////////////////////////////////////////////////////////
+
+template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_>
+template <typename Operand>
+struct Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
+    ::Eval_f<ExpressionTemplate_Memoize_t<Operand>>
+{
+private:
+    typedef Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_> Reindex;
+    Eval_f();
+public:
+    typedef ExpressionTemplate_Memoize_t<typename Reindex::template Eval_f<Operand>::T> T;
+};
+
+// the reindexed expression starts with no cached components.
+template <typename DomainAbstractIndexTyple_, typename CodomainAbstractIndexTyple_,
+          typename Operand>
+typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
+         ::template Eval_f<ExpressionTemplate_Memoize_t<Operand>>::T
+    reindexed (ExpressionTemplate_Memoize_t<Operand> const &e)
+{
+    typedef typename Reindex_e<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>
+                     ::template Eval_f<ExpressionTemplate_Memoize_t<Operand>>::T Reindexed;
+    return Reindexed(reindexed<DomainAbstractIndexTyple_,CodomainAbstractIndexTyple_>(e.operand()));
+}
+
 } // end of namespace Tenh
 
 #endif // TENH_EXPRESSIONTEMPLATE_REINDEX_HPP_
@@ -156,6 +156,13 @@ struct ImplementationOf_t<Diagonal2TensorProductOfBasedVectorSpaces_c<Factor0_,F
         static_assert(IsUsePreallocatedArray_f<UseArrayType_>::V, "UseArrayType_ must be a UsePreallocatedArray_t type");
     }
 
+    // see PreallocatedArray_t::set_pointer_to_allocation
+    void set_pointer_to_allocation (QualifiedComponent *pointer_to_allocation)
+    {
+        static_assert(IsUsePreallocatedArray_f<UseArrayType_>::V, "UseArrayType_ must be a UsePreallocatedArray_t type");
+        Parent_Array_i::set_pointer_to_allocation(pointer_to_allocation);
+    }
+
     // only use this if UseProceduralArray_t<...> is specified
     ImplementationOf_t ()
         :
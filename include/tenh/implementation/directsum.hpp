@@ -178,6 +178,13 @@ struct ImplementationOf_t<DirectSumOfBasedVectorSpaces_c<SummandTyple_>,Scalar_,
         static_assert(IsUsePreallocatedArray_f<UseArrayType_>::V, "UseArrayType_ must be a UsePreallocatedArray_t type");
     }
 
+    // see PreallocatedArray_t::set_pointer_to_allocation
+    void set_pointer_to_allocation (QualifiedComponent *pointer_to_allocation)
+    {
+        static_assert(IsUsePreallocatedArray_f<UseArrayType_>::V, "UseArrayType_ must be a UsePreallocatedArray_t type");
+        Parent_Array_i::set_pointer_to_allocation(pointer_to_allocation);
+    }
+
     // only use this if UseProceduralArray_t<...> is specified or if the vector space is 0-dimensional
     ImplementationOf_t ()
         :
@@ -268,8 +275,34 @@ struct DualOf_f<ImplementationOf_t<DirectSumOfBasedVectorSpaces_c<SummandTyple_>
 // direct sum of procedural 2-tensors (essentially gives a block-diag matrix)
 // ///////////////////////////////////////////////////////////////////////////
 
+// true iff each concept in the typle is a diagonal 2-tensor whose factors have
+// equal dimension (a direct sum of those is itself a diagonal 2-tensor).
+template <typename ConceptTyple_>
+struct EachTypeIsASquareDiagonal2Tensor_f
+{
+private:
+    typedef typename Head_f<ConceptTyple_>::T HeadConcept;
+    typedef typename FactorTypleOf_f<HeadConcept>::T HeadFactorTyple;
+    static bool const HEAD_IS_SQUARE_DIAGONAL =
+        IsDiagonal2TensorProductOfBasedVectorSpaces_f<HeadConcept>::V &&
+        (DimensionOf_f<typename Element_f<HeadFactorTyple,0>::T>::V == DimensionOf_f<typename Element_f<HeadFactorTyple,1>::T>::V);
+    EachTypeIsASquareDiagonal2Tensor_f();
+public:
+    static bool const V = HEAD_IS_SQUARE_DIAGONAL && EachTypeIsASquareDiagonal2Tensor_f<typename BodyTyple_f<ConceptTyple_>::T>::V;
+};
+
+template <>
+struct EachTypeIsASquareDiagonal2Tensor_f<Typle_t<>>
+{
+    static bool const V = true; // vacuously true
+private:
+    EachTypeIsASquareDiagonal2Tensor_f();
+};
+
+// the (dense) tensor product of the direct sums of the factors -- this is the "block matrix"
+// type which is always valid for a direct sum of 2-tensors.
 template <typename Procedural2TensorImplementationTyple_>
-struct ConceptualTypeOfDirectSumOfProcedural2Tensors_f
+struct BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f
 {
 private:
     typedef typename ConceptOfEachTypeIn_f<Procedural2TensorImplementationTyple_>::T ConceptTyple;
@@ -283,11 +316,29 @@ private:
     typedef typename FactorNOfEachTypeIn_f<1,ConceptTyple>::T SummandTyple1;
     typedef DirectSumOfBasedVectorSpaces_c<SummandTyple0> Factor0DirectSum;
     typedef DirectSumOfBasedVectorSpaces_c<SummandTyple1> Factor1DirectSum;
-    ConceptualTypeOfDirectSumOfProcedural2Tensors_f();
+    BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f();
 public:
     typedef TensorProductOfBasedVectorSpaces_c<Typle_t<Factor0DirectSum,Factor1DirectSum>> T;
 };
 
+// a direct sum of square diagonal 2-tensors is a diagonal 2-tensor, so only the diagonal
+// is stored/generated in that case.  otherwise it is the full block matrix.
+template <typename Procedural2TensorImplementationTyple_>
+struct ConceptualTypeOfDirectSumOfProcedural2Tensors_f
+{
+private:
+    typedef typename ConceptOfEachTypeIn_f<Procedural2TensorImplementationTyple_>::T ConceptTyple;
+    typedef typename BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_>::T BlockMatrix;
+    typedef typename FactorTypleOf_f<BlockMatrix>::T FactorTyple;
+    ConceptualTypeOfDirectSumOfProcedural2Tensors_f();
+public:
+    static bool const IS_DIAGONAL = EachTypeIsASquareDiagonal2Tensor_f<ConceptTyple>::V;
+    typedef typename If_f<IS_DIAGONAL,
+                          Diagonal2TensorProductOfBasedVectorSpaces_c<typename Element_f<FactorTyple,0>::T,
+                                                                      typename Element_f<FactorTyple,1>::T>,
+                          BlockMatrix>::T T;
+};
+
 namespace ComponentGeneratorEvaluator {
 
 template <typename Procedural2TensorImplementationTyple_,
@@ -296,7 +347,7 @@ template <typename Procedural2TensorImplementationTyple_,
 struct DirectSumOf2TensorsHelper_t
 {
     typedef ComponentIndex_t<DimensionOf_f<ConceptualTypeOfDirectSum_>::V> ComponentIndex;
-    typedef typename ConceptualTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_>::T ConceptualTypeOfDirectSum;
+    typedef typename BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_>::T ConceptualTypeOfDirectSum;
     static_assert(TypesAreEqual_f<ConceptualTypeOfDirectSum_,ConceptualTypeOfDirectSum>::V, "types must be equal");
     typedef typename FactorTypleOf_f<ConceptualTypeOfDirectSum_>::T FactorTyple;
     typedef typename Element_f<FactorTyple,0>::T Factor0;
@@ -333,7 +384,7 @@ struct DirectSumOf2TensorsHelper_t
         else // body block
         {
             typedef typename BodyTyple_f<Procedural2TensorImplementationTyple_>::T Procedural2TensorImplementationBodyTyple;
-            typedef typename ConceptualTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationBodyTyple>::T ConceptualTypeOfDirectSumBody;
+            typedef typename BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationBodyTyple>::T ConceptualTypeOfDirectSumBody;
             typedef DirectSumOf2TensorsHelper_t<Procedural2TensorImplementationBodyTyple,
                                                 ConceptualTypeOfDirectSumBody,
                                                 Scalar_> DirectSumOf2TensorsHelper;
@@ -366,18 +417,164 @@ struct DirectSumOf2TensorsHelper_t<Typle_t<HeadProcedural2TensorImplementation_>
     }
 };
 
+// the diagonal of a direct sum of square diagonal 2-tensors is the concatenation of the
+// diagonals, so each component is a single component of exactly one summand.
+template <typename Procedural2TensorImplementationTyple_, typename Scalar_>
+struct DirectSumOfDiagonal2TensorsHelper_t
+{
+    typedef typename Head_f<Procedural2TensorImplementationTyple_>::T HeadImplementation;
+    typedef typename BodyTyple_f<Procedural2TensorImplementationTyple_>::T BodyImplementationTyple;
+
+    template <Uint32 DIM_>
+    static Scalar_ evaluate (ComponentIndex_t<DIM_> const &i) { return component(i.value()); }
+
+    static Scalar_ component (Uint32 i)
+    {
+        if (i < HeadImplementation::DIM)
+            return HeadImplementation()[typename HeadImplementation::ComponentIndex(i, CheckRange::FALSE)];
+        else
+            return DirectSumOfDiagonal2TensorsHelper_t<BodyImplementationTyple,Scalar_>::component(i - HeadImplementation::DIM);
+    }
+};
+
+template <typename HeadImplementation_, typename Scalar_>
+struct DirectSumOfDiagonal2TensorsHelper_t<Typle_t<HeadImplementation_>,Scalar_>
+{
+    template <Uint32 DIM_>
+    static Scalar_ evaluate (ComponentIndex_t<DIM_> const &i) { return component(i.value()); }
+
+    static Scalar_ component (Uint32 i)
+    {
+        return HeadImplementation_()[typename HeadImplementation_::ComponentIndex(i, CheckRange::FALSE)];
+    }
+};
+
 template <typename Procedural2TensorImplementationTyple_,
           typename ConceptualTypeOfDirectSum_,
           typename Scalar_>
 Scalar_ direct_sum_of_2tensors (ComponentIndex_t<DimensionOf_f<ConceptualTypeOfDirectSum_>::V> const &i)
 {
-    return DirectSumOf2TensorsHelper_t<Procedural2TensorImplementationTyple_,
-                                       ConceptualTypeOfDirectSum_,
-                                       Scalar_>::evaluate(i);
+    typedef typename If_f<ConceptualTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_>::IS_DIAGONAL,
+                          DirectSumOfDiagonal2TensorsHelper_t<Procedural2TensorImplementationTyple_,Scalar_>,
+                          DirectSumOf2TensorsHelper_t<Procedural2TensorImplementationTyple_,
+                                                      ConceptualTypeOfDirectSum_,
+                                                      Scalar_>>::T Helper;
+    return Helper::evaluate(i);
 }
 
 } // end of namespace ComponentGeneratorEvaluator
 
+// block-aware operations on a direct sum of procedural 2-tensors.  generic expression template
+// evaluation of the direct sum visits every component of the (sum n_k)^2 block matrix, whereas
+// these only visit the diagonal blocks (O(sum n_k^2)), using OffsetForComponent_f to locate them.
+template <typename Procedural2TensorImplementationTyple_,
+          Uint32 N_ = 0,
+          bool IS_AT_END_ = (N_ == Length_f<Procedural2TensorImplementationTyple_>::V)>
+struct DirectSumOf2TensorsBlocks_t
+{
+private:
+    typedef typename ConceptOfEachTypeIn_f<Procedural2TensorImplementationTyple_>::T ConceptTyple;
+    typedef typename FactorNOfEachTypeIn_f<0,ConceptTyple>::T SummandTyple0;
+    typedef typename FactorNOfEachTypeIn_f<1,ConceptTyple>::T SummandTyple1;
+    typedef typename Element_f<Procedural2TensorImplementationTyple_,N_>::T BlockImplementation;
+    typedef typename BlockImplementation::MultiIndex BlockMultiIndex;
+    typedef typename FactorTypleOf_f<typename BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_>::T>::T FactorTyple;
+    typedef DirectSumOf2TensorsBlocks_t<Procedural2TensorImplementationTyple_,N_+1> NextBlocks;
+
+    static Uint32 const ROW_OFFSET = OffsetForComponent_f<SummandTyple0,N_>::V;
+    static Uint32 const COL_OFFSET = OffsetForComponent_f<SummandTyple1,N_>::V;
+    static Uint32 const ROW_COUNT = DimensionOf_f<typename Element_f<SummandTyple0,N_>::T>::V;
+    static Uint32 const COL_COUNT = DimensionOf_f<typename Element_f<SummandTyple1,N_>::T>::V;
+    static Uint32 const BLOCK_MATRIX_COL_COUNT = DimensionOf_f<typename Element_f<FactorTyple,1>::T>::V;
+
+    // this is what IndexSplitter_t does for a single component, minus the expression template.
+    static typename BlockImplementation::Scalar block_component (BlockImplementation const &block, BlockMultiIndex const &m)
+    {
+        if (BlockImplementation::component_is_procedural_zero(m))
+            return typename BlockImplementation::Scalar(0);
+        return BlockImplementation::scalar_factor_for_component(m) * block[BlockImplementation::vector_index_of(m)];
+    }
+
+    DirectSumOf2TensorsBlocks_t();
+
+public:
+
+    typedef typename BlockImplementation::Scalar Scalar;
+    typedef typename BlockMatrixTypeOfDirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_>::T BlockMatrix;
+    typedef typename Element_f<FactorTyple,0>::T Factor0;
+    typedef typename Element_f<FactorTyple,1>::T Factor1;
+
+    // computes out(i) = D(i|j)*v(j), where D is the direct sum of the procedural 2-tensors.
+    template <typename OutDerived_, ComponentQualifier OUT_COMPONENT_QUALIFIER_,
+              typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_>
+    static void contract (Vector_i<OutDerived_,Scalar,Factor0,OUT_COMPONENT_QUALIFIER_> &out,
+                          Vector_i<VDerived_,Scalar,typename DualOf_f<Factor1>::T,V_COMPONENT_QUALIFIER_> const &v)
+    {
+        typedef typename Vector_i<OutDerived_,Scalar,Factor0,OUT_COMPONENT_QUALIFIER_>::ComponentIndex OutComponentIndex;
+        typedef typename Vector_i<VDerived_,Scalar,typename DualOf_f<Factor1>::T,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+        BlockImplementation block;
+        for (BlockMultiIndex m; m.is_not_at_end(); )
+        {
+            Uint32 row = m.template el<0>().value();
+            Scalar sum(0);
+            for ( ; m.is_not_at_end() && m.template el<0>().value() == row; ++m)
+                sum += block_component(block, m) * v[VComponentIndex(COL_OFFSET + m.template el<1>().value(), CheckRange::FALSE)];
+            out[OutComponentIndex(ROW_OFFSET + row, CheckRange::FALSE)] = sum;
+        }
+        NextBlocks::contract(out, v);
+    }
+
+    // computes u(i)*D(i|j)*v(j), where D is the direct sum of the procedural 2-tensors.
+    template <typename UDerived_, ComponentQualifier U_COMPONENT_QUALIFIER_,
+              typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_>
+    static Scalar bilinear_form (Vector_i<UDerived_,Scalar,typename DualOf_f<Factor0>::T,U_COMPONENT_QUALIFIER_> const &u,
+                                 Vector_i<VDerived_,Scalar,typename DualOf_f<Factor1>::T,V_COMPONENT_QUALIFIER_> const &v)
+    {
+        typedef typename Vector_i<UDerived_,Scalar,typename DualOf_f<Factor0>::T,U_COMPONENT_QUALIFIER_>::ComponentIndex UComponentIndex;
+        typedef typename Vector_i<VDerived_,Scalar,typename DualOf_f<Factor1>::T,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+        BlockImplementation block;
+        Scalar retval(0);
+        for (BlockMultiIndex m; m.is_not_at_end(); ++m)
+        {
+            if (BlockImplementation::component_is_procedural_zero(m))
+                continue;
+            retval += u[UComponentIndex(ROW_OFFSET + m.template el<0>().value(), CheckRange::FALSE)] *
+                      block_component(block, m) *
+                      v[VComponentIndex(COL_OFFSET + m.template el<1>().value(), CheckRange::FALSE)];
+        }
+        return retval + NextBlocks::bilinear_form(u, v);
+    }
+
+    // writes the block matrix into t, evaluating only the diagonal blocks.
+    template <typename TDerived_, ComponentQualifier T_COMPONENT_QUALIFIER_>
+    static void assign_to (Vector_i<TDerived_,Scalar,BlockMatrix,T_COMPONENT_QUALIFIER_> &t)
+    {
+        typedef typename Vector_i<TDerived_,Scalar,BlockMatrix,T_COMPONENT_QUALIFIER_>::ComponentIndex TComponentIndex;
+        if (N_ == 0)
+            for (TComponentIndex i; i.is_not_at_end(); ++i)
+                t[i] = Scalar(0);
+        BlockImplementation block;
+        for (BlockMultiIndex m; m.is_not_at_end(); ++m)
+            t[TComponentIndex((ROW_OFFSET + m.template el<0>().value())*BLOCK_MATRIX_COL_COUNT + COL_OFFSET + m.template el<1>().value(),
+                              CheckRange::FALSE)] = block_component(block, m);
+        NextBlocks::assign_to(t);
+    }
+};
+
+template <typename Procedural2TensorImplementationTyple_, Uint32 N_>
+struct DirectSumOf2TensorsBlocks_t<Procedural2TensorImplementationTyple_,N_,true>
+{
+    template <typename OutVector_, typename VVector_>
+    static void contract (OutVector_ &, VVector_ const &) { }
+    template <typename UVector_, typename VVector_>
+    static typename Head_f<typename ScalarOfEachTypeIn_f<Procedural2TensorImplementationTyple_>::T>::T
+        bilinear_form (UVector_ const &, VVector_ const &) { return 0; }
+    template <typename TVector_>
+    static void assign_to (TVector_ &) { }
+private:
+    DirectSumOf2TensorsBlocks_t();
+};
+
 template <typename Procedural2TensorImplementationTyple_>
 struct DirectSumOfProcedural2Tensors_f
 {
@@ -400,6 +597,38 @@ private:
     DirectSumOfProcedural2Tensors_f();
 public:
     typedef ImplementationOf_t<ConceptualTypeOfDirectSum,Scalar,UseProceduralArray_t<ComponentGenerator>> T;
+    // block-aware contraction/assignment which avoids the off-diagonal blocks entirely.
+    // this is also used by indexed assignment (see BlockStructureOf_f).
+    typedef DirectSumOf2TensorsBlocks_t<Procedural2TensorImplementationTyple_> Blocks;
+};
+
+// a (non-diagonal) direct sum of procedural 2-tensors is identified by the Id of its component generator.
+template <typename FactorTyple_,
+          typename Scalar_,
+          Uint32 COMPONENT_COUNT_,
+          Scalar_ (*evaluator_)(ComponentIndex_t<COMPONENT_COUNT_> const &),
+          typename Procedural2TensorImplementationTyple_,
+          typename Derived_>
+struct BlockStructureOf_f<ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<FactorTyple_>,
+                                             Scalar_,
+                                             UseProceduralArray_t<ComponentGenerator_t<Scalar_,
+                                                                                       COMPONENT_COUNT_,
+                                                                                       evaluator_,
+                                                                                       DirectSum_c<Procedural2TensorImplementationTyple_>>>,
+                                             Derived_>>
+{
+    typedef DirectSumOf2TensorsBlocks_t<Procedural2TensorImplementationTyple_> T;
+private:
+    BlockStructureOf_f();
+};
+
+// d.split(i*j) indexes d as a Vector_i before splitting it.
+template <typename Derived_, typename Scalar_, typename BasedVectorSpace_, ComponentQualifier COMPONENT_QUALIFIER_>
+struct BlockStructureOf_f<Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_>>
+{
+    typedef typename BlockStructureOf_f<Derived_>::T T;
+private:
+    BlockStructureOf_f();
 };
 
 } // end of namespace Tenh
@@ -152,6 +152,13 @@ struct ImplementationOf_t<SymmetricPowerOfBasedVectorSpace_c<ORDER_,Factor_>,Sca
         static_assert(IsUsePreallocatedArray_f<UseArrayType_>::V, "UseArrayType_ must be a UsePreallocatedArray_t type");
     }
 
+    // see PreallocatedArray_t::set_pointer_to_allocation
+    void set_pointer_to_allocation (QualifiedComponent *pointer_to_allocation)
+    {
+        static_assert(IsUsePreallocatedArray_f<UseArrayType_>::V, "UseArrayType_ must be a UsePreallocatedArray_t type");
+        Parent_Array_i::set_pointer_to_allocation(pointer_to_allocation);
+    }
+
     // only use this if UseProceduralArray_t<...> is specified
     ImplementationOf_t ()
         :
@@ -250,6 +257,261 @@ struct DualOf_f<ImplementationOf_t<SymmetricPowerOfBasedVectorSpace_c<ORDER,Fact
     typedef ImplementationOf_t<typename DualOf_f<SymmetricPowerOfBasedVectorSpace_c<ORDER,Factor>>::T,Scalar,typename DualOf_f<UseArrayType_>::T,typename DualOf_f<Derived_>::T> T;
 };
 
+// ///////////////////////////////////////////////////////////////////////////
+// kernels which operate directly on the packed storage of symmetric 2-tensors
+// ///////////////////////////////////////////////////////////////////////////
+
+// the components of Sym^2(F) are stored as the lower triangle of the corresponding
+// symmetric matrix, row by row; the component for the unordered pair {a,b}, where
+// a >= b, is at a*(a+1)/2 + b, and has scalar factor 1.  these kernels iterate
+// through that storage linearly, which avoids the per-component embed/coembed done
+// by the split(i*j) expression templates.
+
+inline Uint32 sym2_packed_index (Uint32 a, Uint32 b)
+{
+    return a >= b ? a*(a+1)/2 + b : b*(b+1)/2 + a;
+}
+
+// out(a) = s(a*b)*v(b).  out is written while v is still being read, so out must not
+// share memory with s or v.
+template <typename SymDerived_, typename Factor_, typename Scalar_, ComponentQualifier SYM_COMPONENT_QUALIFIER_,
+          typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_,
+          typename OutDerived_>
+void sym2_times_vector (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_> const &s,
+                        Vector_i<VDerived_,Scalar_,typename DualOf_f<Factor_>::T,V_COMPONENT_QUALIFIER_> const &v,
+                        Vector_i<OutDerived_,Scalar_,Factor_,ComponentQualifier::NONCONST_MEMORY> &out)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_i<VDerived_,Scalar_,typename DualOf_f<Factor_>::T,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+    typedef typename Vector_i<OutDerived_,Scalar_,Factor_,ComponentQualifier::NONCONST_MEMORY>::ComponentIndex OutComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+    assert(!v.overlaps_memory_range(reinterpret_cast<Uint8 const *>(out.pointer_to_allocation()), out.allocation_size_in_bytes()) && "out must not alias v");
+    assert(!s.overlaps_memory_range(reinterpret_cast<Uint8 const *>(out.pointer_to_allocation()), out.allocation_size_in_bytes()) && "out must not alias s");
+
+    Uint32 k = 0;
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Scalar_ v_a(v[VComponentIndex(a, CheckRange::FALSE)]);
+        Scalar_ out_a(0);
+        for (Uint32 b = 0; b < a; ++b, ++k)
+        {
+            Scalar_ s_ab(s[SymComponentIndex(k, CheckRange::FALSE)]);
+            out_a += s_ab * v[VComponentIndex(b, CheckRange::FALSE)];
+            // the upper triangle contribution to an earlier component
+            out[OutComponentIndex(b, CheckRange::FALSE)] += s_ab * v_a;
+        }
+        out[OutComponentIndex(a, CheckRange::FALSE)] = out_a + s[SymComponentIndex(k, CheckRange::FALSE)] * v_a;
+        ++k;
+    }
+}
+
+// returns s(a*b)*u(a)*v(b)
+template <typename SymDerived_, typename Factor_, typename Scalar_, ComponentQualifier SYM_COMPONENT_QUALIFIER_,
+          typename UDerived_, ComponentQualifier U_COMPONENT_QUALIFIER_,
+          typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_>
+Scalar_ sym2_bilinear_form (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_> const &s,
+                            Vector_i<UDerived_,Scalar_,typename DualOf_f<Factor_>::T,U_COMPONENT_QUALIFIER_> const &u,
+                            Vector_i<VDerived_,Scalar_,typename DualOf_f<Factor_>::T,V_COMPONENT_QUALIFIER_> const &v)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_i<UDerived_,Scalar_,typename DualOf_f<Factor_>::T,U_COMPONENT_QUALIFIER_>::ComponentIndex UComponentIndex;
+    typedef typename Vector_i<VDerived_,Scalar_,typename DualOf_f<Factor_>::T,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    Scalar_ retval(0);
+    Uint32 k = 0;
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Scalar_ u_a(u[UComponentIndex(a, CheckRange::FALSE)]);
+        Scalar_ v_a(v[VComponentIndex(a, CheckRange::FALSE)]);
+        Scalar_ row(0);
+        for (Uint32 b = 0; b < a; ++b, ++k)
+            row += s[SymComponentIndex(k, CheckRange::FALSE)] * (u_a * v[VComponentIndex(b, CheckRange::FALSE)] + u[UComponentIndex(b, CheckRange::FALSE)] * v_a);
+        retval += row + s[SymComponentIndex(k, CheckRange::FALSE)] * u_a * v_a;
+        ++k;
+    }
+    return retval;
+}
+
+// returns s(a*b)*v(a)*v(b) -- each off-diagonal component is read once and doubled
+template <typename SymDerived_, typename Factor_, typename Scalar_, ComponentQualifier SYM_COMPONENT_QUALIFIER_,
+          typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_>
+Scalar_ sym2_quadratic_form (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_> const &s,
+                             Vector_i<VDerived_,Scalar_,typename DualOf_f<Factor_>::T,V_COMPONENT_QUALIFIER_> const &v)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_i<VDerived_,Scalar_,typename DualOf_f<Factor_>::T,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    Scalar_ retval(0);
+    Uint32 k = 0;
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Scalar_ v_a(v[VComponentIndex(a, CheckRange::FALSE)]);
+        Scalar_ row(0);
+        for (Uint32 b = 0; b < a; ++b, ++k)
+            row += s[SymComponentIndex(k, CheckRange::FALSE)] * v[VComponentIndex(b, CheckRange::FALSE)];
+        retval += v_a * (Scalar_(2) * row + s[SymComponentIndex(k, CheckRange::FALSE)] * v_a);
+        ++k;
+    }
+    return retval;
+}
+
+// s(a*b) += alpha*u(a)*u(b)
+template <typename SymDerived_, typename Factor_, typename Scalar_,
+          typename UDerived_, ComponentQualifier U_COMPONENT_QUALIFIER_>
+void sym2_rank1_update (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY> &s,
+                        Scalar_ alpha,
+                        Vector_i<UDerived_,Scalar_,Factor_,U_COMPONENT_QUALIFIER_> const &u)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_i<UDerived_,Scalar_,Factor_,U_COMPONENT_QUALIFIER_>::ComponentIndex UComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    Uint32 k = 0;
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Scalar_ alpha_u_a(alpha * u[UComponentIndex(a, CheckRange::FALSE)]);
+        for (Uint32 b = 0; b <= a; ++b, ++k)
+            s[SymComponentIndex(k, CheckRange::FALSE)] += alpha_u_a * u[UComponentIndex(b, CheckRange::FALSE)];
+    }
+}
+
+// s(a*b) += alpha*(u(a)*v(b) + v(a)*u(b))
+template <typename SymDerived_, typename Factor_, typename Scalar_,
+          typename UDerived_, ComponentQualifier U_COMPONENT_QUALIFIER_,
+          typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_>
+void sym2_rank2_update (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY> &s,
+                        Scalar_ alpha,
+                        Vector_i<UDerived_,Scalar_,Factor_,U_COMPONENT_QUALIFIER_> const &u,
+                        Vector_i<VDerived_,Scalar_,Factor_,V_COMPONENT_QUALIFIER_> const &v)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_i<UDerived_,Scalar_,Factor_,U_COMPONENT_QUALIFIER_>::ComponentIndex UComponentIndex;
+    typedef typename Vector_i<VDerived_,Scalar_,Factor_,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    Uint32 k = 0;
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Scalar_ alpha_u_a(alpha * u[UComponentIndex(a, CheckRange::FALSE)]);
+        Scalar_ alpha_v_a(alpha * v[VComponentIndex(a, CheckRange::FALSE)]);
+        for (Uint32 b = 0; b <= a; ++b, ++k)
+            s[SymComponentIndex(k, CheckRange::FALSE)] += alpha_u_a * v[VComponentIndex(b, CheckRange::FALSE)]
+                                                        + alpha_v_a * u[UComponentIndex(b, CheckRange::FALSE)];
+    }
+}
+
+// s(a*b) += alpha*sum_{n < count} us[n](a)*us[n](b) -- the accumulation over the
+// vectors is done per component, so s is traversed only once.  Vector_ should be
+// an implementation of a vector in Factor_ (e.g. ImplementationOf_t<Factor_,Scalar_>).
+template <typename SymDerived_, typename Factor_, typename Scalar_, typename Vector_>
+void sym2_rank_k_update (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY> &s,
+                         Scalar_ alpha,
+                         Vector_ const *us,
+                         Uint32 count)
+{
+    static_assert(TypesAreEqual_f<typename Vector_::BasedVectorSpace,Factor_>::V, "Vector_ must be a vector in Factor_");
+    static_assert(TypesAreEqual_f<typename Vector_::Scalar,Scalar_>::V, "Vector_ must have the same Scalar type");
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_::ComponentIndex UComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    assert((us != nullptr || count == 0) && "us must point to count vectors");
+    Uint32 k = 0;
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        for (Uint32 b = 0; b <= a; ++b, ++k)
+        {
+            Scalar_ sum(0);
+            for (Uint32 n = 0; n < count; ++n)
+                sum += us[n][UComponentIndex(a, CheckRange::FALSE)] * us[n][UComponentIndex(b, CheckRange::FALSE)];
+            s[SymComponentIndex(k, CheckRange::FALSE)] += alpha * sum;
+        }
+    }
+}
+
+// factors s = L*D*L^T in place, where L is unit lower triangular and D is diagonal;
+// the strictly lower triangle of L overwrites that of s, and the diagonal of D
+// overwrites the diagonal of s.  no pivoting is done, so this is meant for matrices
+// which are expected to be positive definite (e.g. the Hessian in Newton's method).
+// returns true iff each pivot (diagonal component of D) is greater than min_pivot,
+// i.e. s is positive definite up to min_pivot; otherwise the factorization stops at
+// the first pivot which isn't, leaving s partially factored.  costs about DIM^3/6
+// multiplications.
+template <typename SymDerived_, typename Factor_, typename Scalar_>
+bool sym2_ldlt_factor (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY> &s,
+                       Scalar_ min_pivot)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,ComponentQualifier::NONCONST_MEMORY>::ComponentIndex SymComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Uint32 row_a = a*(a+1)/2;
+        // first store w(b) = L(a,b)*D(b) in the row, computed using the previous
+        // rows (which are already factored) and the earlier w's in this row.
+        for (Uint32 b = 0; b < a; ++b)
+        {
+            Uint32 row_b = b*(b+1)/2;
+            Scalar_ w(s[SymComponentIndex(row_a + b, CheckRange::FALSE)]);
+            for (Uint32 k = 0; k < b; ++k)
+                w -= s[SymComponentIndex(row_a + k, CheckRange::FALSE)] * s[SymComponentIndex(row_b + k, CheckRange::FALSE)];
+            s[SymComponentIndex(row_a + b, CheckRange::FALSE)] = w;
+        }
+        // then scale the w's into L(a,b) and compute the pivot D(a).
+        Scalar_ d(s[SymComponentIndex(row_a + a, CheckRange::FALSE)]);
+        for (Uint32 b = 0; b < a; ++b)
+        {
+            Scalar_ w(s[SymComponentIndex(row_a + b, CheckRange::FALSE)]);
+            Scalar_ l(w / s[SymComponentIndex(b*(b+1)/2 + b, CheckRange::FALSE)]);
+            s[SymComponentIndex(row_a + b, CheckRange::FALSE)] = l;
+            d -= w * l;
+        }
+        // written this way so that NaN fails
+        if (!(d > min_pivot))
+            return false;
+        s[SymComponentIndex(row_a + a, CheckRange::FALSE)] = d;
+    }
+    return true;
+}
+
+// solves s(a*b)*out(b) = v(a) for out, where ldlt is the factorization of s
+// computed by a successful sym2_ldlt_factor.  costs about DIM^2 multiplications.
+template <typename SymDerived_, typename Factor_, typename Scalar_, ComponentQualifier SYM_COMPONENT_QUALIFIER_,
+          typename VDerived_, ComponentQualifier V_COMPONENT_QUALIFIER_,
+          typename OutDerived_>
+void sym2_ldlt_solve (Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_> const &ldlt,
+                      Vector_i<VDerived_,Scalar_,Factor_,V_COMPONENT_QUALIFIER_> const &v,
+                      Vector_i<OutDerived_,Scalar_,typename DualOf_f<Factor_>::T,ComponentQualifier::NONCONST_MEMORY> &out)
+{
+    typedef typename Vector_i<SymDerived_,Scalar_,SymmetricPowerOfBasedVectorSpace_c<2,Factor_>,SYM_COMPONENT_QUALIFIER_>::ComponentIndex SymComponentIndex;
+    typedef typename Vector_i<VDerived_,Scalar_,Factor_,V_COMPONENT_QUALIFIER_>::ComponentIndex VComponentIndex;
+    typedef typename Vector_i<OutDerived_,Scalar_,typename DualOf_f<Factor_>::T,ComponentQualifier::NONCONST_MEMORY>::ComponentIndex OutComponentIndex;
+    static Uint32 const DIM = DimensionOf_f<Factor_>::V;
+
+    // solve L*y = v, reading the rows of L
+    for (Uint32 a = 0; a < DIM; ++a)
+    {
+        Uint32 row_a = a*(a+1)/2;
+        Scalar_ y(v[VComponentIndex(a, CheckRange::FALSE)]);
+        for (Uint32 b = 0; b < a; ++b)
+            y -= ldlt[SymComponentIndex(row_a + b, CheckRange::FALSE)] * out[OutComponentIndex(b, CheckRange::FALSE)];
+        out[OutComponentIndex(a, CheckRange::FALSE)] = y;
+    }
+    // solve D*z = y
+    for (Uint32 a = 0; a < DIM; ++a)
+        out[OutComponentIndex(a, CheckRange::FALSE)] /= ldlt[SymComponentIndex(a*(a+1)/2 + a, CheckRange::FALSE)];
+    // solve L^T*out = z, reading the columns of L
+    for (Uint32 a = DIM; a-- > 0; )
+    {
+        Scalar_ x(out[OutComponentIndex(a, CheckRange::FALSE)]);
+        for (Uint32 b = a+1; b < DIM; ++b)
+            x -= ldlt[SymComponentIndex(b*(b+1)/2 + a, CheckRange::FALSE)] * out[OutComponentIndex(b, CheckRange::FALSE)];
+        out[OutComponentIndex(a, CheckRange::FALSE)] = x;
+    }
+}
+
 } // end of namespace Tenh
 
 #endif // TENH_IMPLEMENTATION_VEE_HPP_
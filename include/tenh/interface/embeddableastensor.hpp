@@ -83,6 +83,30 @@ typename IndexedParameterTupleReturnType_f<Typle_t<HeadParameter>,Typle_t<HeadAb
     return p.head()(HeadAbstractIndex());
 }
 
+// the product v_1[m_1]*...*v_k[m_k] of the components of the vectors in a
+// parameter tuple at the factor multi-index m.
+template <typename ParameterTyple_>
+struct ParameterTupleComponentProduct_t
+{
+    template <typename MultiIndex_>
+    static typename Head_f<ParameterTyple_>::T::Scalar eval (Tuple_t<ParameterTyple_> const &p, MultiIndex_ const &m)
+    {
+        typedef typename Head_f<ParameterTyple_>::T HeadParameter;
+        return p.head()[typename HeadParameter::ComponentIndex(m.head().value(), CheckRange::FALSE)] *
+               ParameterTupleComponentProduct_t<typename BodyTyple_f<ParameterTyple_>::T>::eval(p.body(), m.body());
+    }
+};
+
+template <typename HeadParameter_>
+struct ParameterTupleComponentProduct_t<Typle_t<HeadParameter_>>
+{
+    template <typename MultiIndex_>
+    static typename HeadParameter_::Scalar eval (Tuple_t<Typle_t<HeadParameter_>> const &p, MultiIndex_ const &m)
+    {
+        return p.head()[typename HeadParameter_::ComponentIndex(m.head().value(), CheckRange::FALSE)];
+    }
+};
+
 // ///////////////////////////////////////////////////////////////////////////
 // EmbeddableAsTensor_i
 // ///////////////////////////////////////////////////////////////////////////
@@ -154,7 +178,12 @@ struct EmbeddableAsTensor_i
     //   X(u, v)
     // is equivalent to
     //   X.split(i*j)*u(i)*v(j)
-    // though is implemented using coembed, which should be close to optimally efficient.
+    // though is computed directly from the components of this object, walking the
+    // coembedding of each component into the tensor product (i.e. its scale factor
+    // and the tensor components it is stored as), without building the intermediate
+    // bundle/coembed expression templates.  if v0 and v1 are the same object (e.g.
+    // a quadratic form), the product is computed once for each set of tensor
+    // components which are permutations of one another, weighted by its multiplicity.
     // this is a special case for when ORDER == 2, i.e. it is a bilinear form.
     template <typename Derived0_,
               typename BasedVectorSpace0_,
@@ -166,13 +195,62 @@ struct EmbeddableAsTensor_i
                          Vector_i<Derived1_,Scalar_,BasedVectorSpace1_,COMPONENT_QUALIFIER1_> const &v1) const
     {
         static_assert(ORDER == 2, "ORDER must be exactly 2");
-        TensorProductOfBasedVectorSpaces upstairs;
-        EmbeddableInTensorProductOfBasedVectorSpaces_ downstairs;
-        AbstractIndex_c<'i'> i;
-        AbstractIndex_c<'j'> j;
-        AbstractIndex_c<'p'> p;
-        AbstractIndex_c<'q'> q;
-        return operator()(p) * (v0(i)*v1(j)).bundle(i*j,dual(upstairs),q).coembed(q,dual(downstairs),p);
+        typedef typename Vector_i<Derived0_,Scalar_,BasedVectorSpace0_,COMPONENT_QUALIFIER0_>::ComponentIndex ComponentIndex0;
+        typedef typename Vector_i<Derived1_,Scalar_,BasedVectorSpace1_,COMPONENT_QUALIFIER1_>::ComponentIndex ComponentIndex1;
+        typedef typename CoembedIndexIterator_f<typename DualOf_f<EmbeddableInTensorProductOfBasedVectorSpaces_>::T,
+                                                typename DualOf_f<TensorProductOfBasedVectorSpaces>::T,
+                                                Scalar_,
+                                                NaturalEmbedding,
+                                                WithExceptions::DISABLED>::T CoembedIndexIterator;
+        bool arguments_are_identical = TypesAreEqual_f<Derived0_,Derived1_>::V &&
+                                       static_cast<void const *>(&v0) == static_cast<void const *>(&v1);
+        Scalar_ retval(0);
+        for (ComponentIndex c; c.is_not_at_end(); ++c)
+        {
+            CoembedIndexIterator it(c);
+            if (!it.is_not_at_end())
+                continue;
+
+            Scalar_ component(operator[](c));
+            if (arguments_are_identical)
+            {
+                // only the tensor components which are a permutation of the first
+                // one share its product (this is all of them for symmetric forms,
+                // but e.g. not for the diagonal components of a scalar multiple of
+                // the identity).
+                MultiIndex first(it.component_index());
+                Uint32 a = first.head().value();
+                Uint32 b = first.body().head().value();
+                Scalar_ product(v0[ComponentIndex0(a, CheckRange::FALSE)] *
+                                v1[ComponentIndex1(b, CheckRange::FALSE)]);
+                Scalar_ multiplicity(0);
+                Scalar_ sum(0);
+                for ( ; it.is_not_at_end(); ++it)
+                {
+                    MultiIndex m(it.component_index());
+                    Uint32 p = m.head().value();
+                    Uint32 q = m.body().head().value();
+                    if ((p == a && q == b) || (p == b && q == a))
+                        multiplicity += it.scale_factor();
+                    else
+                        sum += it.scale_factor() * (v0[ComponentIndex0(p, CheckRange::FALSE)] *
+                                                    v1[ComponentIndex1(q, CheckRange::FALSE)]);
+                }
+                retval += component * (multiplicity * product + sum);
+            }
+            else
+            {
+                Scalar_ sum(0);
+                for ( ; it.is_not_at_end(); ++it)
+                {
+                    MultiIndex m(it.component_index());
+                    sum += it.scale_factor() * (v0[ComponentIndex0(m.head().value(), CheckRange::FALSE)] *
+                                                v1[ComponentIndex1(m.body().head().value(), CheckRange::FALSE)]);
+                }
+                retval += component * sum;
+            }
+        }
+        return retval;
     }
     // this is for using this object as a multilinear form.
     // e.g. if X is this object, and v_1, ..., v_k are vectors dual to the factor
@@ -180,18 +258,30 @@ struct EmbeddableAsTensor_i
     //   X(tuple(v_1, ..., v_k))
     // is equivalent to
     //   X.split(i_1*...*i_k)*v_1(i_1)*...*v_k(i_k)
-    // though is implemented using coembed, which should be close to optimally efficient.
+    // though is computed directly from the components of this object, as in the
+    // bilinear form case above.
     template <typename ParameterTyple_>
     Scalar_ operator () (Tuple_t<ParameterTyple_> const &l) const
     {
         static_assert(Length_f<ParameterTyple_>::V == ORDER, "argument count must match ORDER");
-        typedef typename AbstractIndexRangeTyple_f<Length_f<ParameterTyple_>::V,667>::T AbstractIndexTyple;
-        TensorProductOfBasedVectorSpaces upstairs;
-        EmbeddableInTensorProductOfBasedVectorSpaces_ downstairs;
-        AbstractIndex_c<'p'> p;
-        AbstractIndex_c<'q'> q;
-        AbstractIndexTyple a;
-        return operator()(p) * indexed_parameter_tuple(l,a).bundle(a,dual(upstairs),q).coembed(q,dual(downstairs),p);
+        typedef typename CoembedIndexIterator_f<typename DualOf_f<EmbeddableInTensorProductOfBasedVectorSpaces_>::T,
+                                                typename DualOf_f<TensorProductOfBasedVectorSpaces>::T,
+                                                Scalar_,
+                                                NaturalEmbedding,
+                                                WithExceptions::DISABLED>::T CoembedIndexIterator;
+        Scalar_ retval(0);
+        for (ComponentIndex c; c.is_not_at_end(); ++c)
+        {
+            CoembedIndexIterator it(c);
+            if (!it.is_not_at_end())
+                continue;
+
+            Scalar_ sum(0);
+            for ( ; it.is_not_at_end(); ++it)
+                sum += it.scale_factor() * ParameterTupleComponentProduct_t<ParameterTyple_>::eval(l, MultiIndex(it.component_index()));
+            retval += operator[](c) * sum;
+        }
+        return retval;
     }
 
     static bool component_is_procedural_zero (MultiIndex const &m) { return as_derived().component_is_procedural_zero(m); }
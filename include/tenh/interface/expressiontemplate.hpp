@@ -13,6 +13,7 @@
 #include "tenh/dimindex.hpp"
 #include "tenh/multiindex.hpp"
 #include "tenh/print_multiindexable.hpp"
+#include "tenh/reduction.hpp"
 
 namespace Tenh {
 
@@ -55,6 +56,9 @@ struct ExpressionTemplate_IndexCoembed_t;
 template <typename Operand>
 struct ExpressionTemplate_Eval_t;
 
+template <typename Operand>
+struct ExpressionTemplate_Memoize_t;
+
 // this is essentially a compile-time interface, requiring:
 // - a Derived type (should be the type of the thing that ultimately inherits this)
 // - a Scalar type (should be the scalar type of the expression template's tensor operand)
@@ -95,15 +99,23 @@ struct ExpressionTemplate_i // _i is for "compile-time interface"
     Derived const &as_derived () const { return *static_cast<Derived const *>(this); }
     Derived &as_derived () { return *static_cast<Derived *>(this); }
 
-    // convenience methods for squared_norm and norm
-    // requires InnerProduct_t to be implemented on all free-indexed types
+    // reductions of the components of this expression, which are computed as they are
+    // accumulated, so the expression is never evaluated into a temporary.  squared_norm
+    // and norm use the standard inner product on the components, i.e. they assume that
+    // the bases of the free factors are orthonormal.
     // NOTE: will not currently work for complex types
-    // NOTE: you must include tenh/expressiontemplate_eval.hpp for the definition of this method
-    typename AssociatedFloatingPointType_t<Scalar>::T squared_norm () const;
-    // requires InnerProduct_t<Derived> to be implemented
+    typename AssociatedFloatingPointType_t<Scalar>::T squared_norm () const
+    {
+        typedef typename AssociatedFloatingPointType_t<Scalar>::T Float;
+        return reduce_components<SquaredSumReduction_t<Scalar,Float>,MultiIndex>(as_derived());
+    }
     // NOTE: will not currently work for complex types
-    // NOTE: you must include tenh/expressiontemplate_eval.hpp for the definition of this method
-    typename AssociatedFloatingPointType_t<Scalar>::T norm () const; // definition is in expressiontemplate_eval.hpp
+    // (sqrt is looked up unqualified so that user-defined scalar types can supply it)
+    typename AssociatedFloatingPointType_t<Scalar>::T norm () const { using std::sqrt; return sqrt(squared_norm()); }
+    // the largest absolute value of the components
+    Scalar max_abs () const { return reduce_components<MaxAbsReduction_t<Scalar>,MultiIndex>(as_derived()); }
+    // the sum of the components
+    Scalar sum () const { return reduce_components<SumReduction_t<Scalar>,MultiIndex>(as_derived()); }
 
     template <CheckFactorTypes CHECK_FACTOR_TYPES_,
               typename ResultingFactorType,
@@ -346,6 +358,13 @@ struct ExpressionTemplate_i // _i is for "compile-time interface"
     {
         return ExpressionTemplate_Eval_t<Derived>(as_derived());
     }
+    // method for evaluating an expression template one component at a time, as the
+    // components are accessed, caching each computed component.
+    // NOTE: you must include tenh/expressiontemplate_eval.hpp for the definition of ExpressionTemplate_Memoize_t
+    ExpressionTemplate_Memoize_t<Derived> memoize () const
+    {
+        return ExpressionTemplate_Memoize_t<Derived>(as_derived());
+    }
 
     static std::string type_as_string (bool verbose)
     {
@@ -87,6 +87,8 @@ struct PreallocatedArray_t
     }
 
     // the existence of this method is a necessary corollary of the WithoutInitialization constructor.
+    // it also rebinds this array to other memory, so that expressions referring to it (e.g. an
+    // AssignmentPlan_t) operate on the new memory.
     void set_pointer_to_allocation (QualifiedComponent *pointer_to_allocation) { m_pointer_to_allocation = pointer_to_allocation; }
 
     ComponentAccessConstReturnType operator [] (ComponentIndex const &i) const
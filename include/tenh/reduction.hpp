@@ -0,0 +1,98 @@
+// ///////////////////////////////////////////////////////////////////////////
+// tenh/reduction.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#ifndef TENH_REDUCTION_HPP_
+#define TENH_REDUCTION_HPP_
+
+#include "tenh/core.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+namespace Tenh {
+
+// ///////////////////////////////////////////////////////////////////////////
+// reductions of a sequence of components to a single value
+// ///////////////////////////////////////////////////////////////////////////
+
+// each reduction has an Accumulator type, the value to start accumulating from,
+// and methods for accumulating a component and combining two partial accumulations.
+
+template <typename Scalar_>
+struct SumReduction_t
+{
+    typedef Scalar_ Accumulator;
+    static Accumulator identity () { return Accumulator(0); }
+    static Accumulator accumulate (Accumulator const &a, Scalar_ const &x) { return a + x; }
+    static Accumulator combine (Accumulator const &a, Accumulator const &b) { return a + b; }
+};
+
+// NOTE: will not currently work for complex types
+template <typename Scalar_, typename Accumulator_ = Scalar_>
+struct SquaredSumReduction_t
+{
+    typedef Accumulator_ Accumulator;
+    static Accumulator identity () { return Accumulator(0); }
+    static Accumulator accumulate (Accumulator const &a, Scalar_ const &x) { return a + Accumulator(x)*Accumulator(x); }
+    static Accumulator combine (Accumulator const &a, Accumulator const &b) { return a + b; }
+};
+
+template <typename Scalar_>
+struct MaxAbsReduction_t
+{
+    typedef Scalar_ Accumulator;
+    static Accumulator identity () { return Accumulator(0); }
+    static Accumulator accumulate (Accumulator const &a, Scalar_ const &x) { return std::max(a, Accumulator(std::abs(x))); }
+    static Accumulator combine (Accumulator const &a, Accumulator const &b) { return std::max(a, b); }
+};
+
+// the number of independent partial accumulations a reduction uses.  accumulating
+// into each of them in turn breaks the dependency of each step on the previous one,
+// so the floating point pipeline stays full and the compiler is free to vectorize.
+static Uint32 const REDUCTION_LANE_COUNT = 4;
+
+template <typename Reduction_>
+typename Reduction_::Accumulator combine_reduction_lanes (typename Reduction_::Accumulator const *lane)
+{
+    static_assert(REDUCTION_LANE_COUNT == 4, "this is written for 4 lanes");
+    return Reduction_::combine(Reduction_::combine(lane[0], lane[1]), Reduction_::combine(lane[2], lane[3]));
+}
+
+// reduces the components of something indexed by MultiIndex_ (e.g. an expression
+// template), computing each component as it is accumulated.
+template <typename Reduction_, typename MultiIndex_, typename Indexable_>
+typename Reduction_::Accumulator reduce_components (Indexable_ const &x)
+{
+    typename Reduction_::Accumulator lane[REDUCTION_LANE_COUNT];
+    for (Uint32 l = 0; l < REDUCTION_LANE_COUNT; ++l)
+        lane[l] = Reduction_::identity();
+    Uint32 l = 0;
+    for (MultiIndex_ m; m.is_not_at_end(); ++m)
+    {
+        lane[l] = Reduction_::accumulate(lane[l], x[m]);
+        if (++l == REDUCTION_LANE_COUNT)
+            l = 0;
+    }
+    return combine_reduction_lanes<Reduction_>(lane);
+}
+
+// reduces COMPONENT_COUNT_ contiguous components in memory.
+template <typename Reduction_, Uint32 COMPONENT_COUNT_, typename Component_>
+typename Reduction_::Accumulator reduce_array (Component_ const *components)
+{
+    typename Reduction_::Accumulator lane[REDUCTION_LANE_COUNT];
+    for (Uint32 l = 0; l < REDUCTION_LANE_COUNT; ++l)
+        lane[l] = Reduction_::identity();
+    Uint32 i = 0;
+    for ( ; i + REDUCTION_LANE_COUNT <= COMPONENT_COUNT_; i += REDUCTION_LANE_COUNT)
+        for (Uint32 l = 0; l < REDUCTION_LANE_COUNT; ++l)
+            lane[l] = Reduction_::accumulate(lane[l], components[i+l]);
+    for ( ; i < COMPONENT_COUNT_; ++i)
+        lane[0] = Reduction_::accumulate(lane[0], components[i]);
+    return combine_reduction_lanes<Reduction_>(lane);
+}
+
+} // end of namespace Tenh
+
+#endif // TENH_REDUCTION_HPP_
@@ -0,0 +1,186 @@
+// ///////////////////////////////////////////////////////////////////////////
+// tenh/summationpolicy.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#ifndef TENH_SUMMATIONPOLICY_HPP_
+#define TENH_SUMMATIONPOLICY_HPP_
+
+#include "tenh/core.hpp"
+
+#include <complex>
+#include <string>
+
+namespace Tenh {
+
+// ///////////////////////////////////////////////////////////////////////////
+// policies for accumulating the terms of a summation (e.g. a contraction)
+// ///////////////////////////////////////////////////////////////////////////
+
+// each policy has a nested Accumulator_t<Scalar_> which starts at zero, takes
+// each term via add, and produces the sum (in Scalar_) via value.
+
+// the type to accumulate in for WideAccumulatorSummation.
+template <typename Scalar_>
+struct WiderScalar_f
+{
+    typedef Scalar_ T;
+private:
+    WiderScalar_f();
+};
+
+template <>
+struct WiderScalar_f<float>
+{
+    typedef double T;
+private:
+    WiderScalar_f();
+};
+
+template <>
+struct WiderScalar_f<double>
+{
+    typedef long double T;
+private:
+    WiderScalar_f();
+};
+
+template <typename RealScalar_>
+struct WiderScalar_f<std::complex<RealScalar_>>
+{
+    typedef std::complex<typename WiderScalar_f<RealScalar_>::T> T;
+private:
+    WiderScalar_f();
+};
+
+// adds each term to a running sum.  the error grows linearly in the number of terms.
+struct NaiveSummation
+{
+    template <typename Scalar_>
+    class Accumulator_t
+    {
+    public:
+        Accumulator_t () : m_sum(0) { }
+        void add (Scalar_ const &term) { m_sum += term; }
+        Scalar_ value () const { return m_sum; }
+    private:
+        Scalar_ m_sum;
+    };
+
+    static std::string type_as_string (bool verbose) { return "NaiveSummation"; }
+};
+
+// sums blocks of BLOCK_SIZE terms naively, then adds the block sums pairwise, as
+// in a binary tree, so the error grows logarithmically in the number of terms.
+// the tree is built as the terms stream in, keeping one partial sum per level.
+struct PairwiseSummation
+{
+    static Uint32 const BLOCK_SIZE = 8;
+
+    template <typename Scalar_>
+    class Accumulator_t
+    {
+    public:
+        Accumulator_t () : m_block_sum(0), m_block_term_count(0), m_block_count(0), m_level_count(0) { }
+        void add (Scalar_ const &term)
+        {
+            m_block_sum += term;
+            if (++m_block_term_count == BLOCK_SIZE)
+            {
+                // the levels are the binary digits of the number of blocks so far, so
+                // adding a block carries into the next level while the digit is 1.
+                Scalar_ sum(m_block_sum);
+                for (Uint32 carry = m_block_count++; (carry & 1) != 0; carry >>= 1)
+                    sum = m_level_sum[--m_level_count] + sum;
+                m_level_sum[m_level_count++] = sum;
+                m_block_sum = Scalar_(0);
+                m_block_term_count = 0;
+            }
+        }
+        Scalar_ value () const
+        {
+            // the levels are in decreasing order of size, so add the smallest first
+            Scalar_ retval(m_block_sum);
+            for (Uint32 l = m_level_count; l > 0; --l)
+                retval = m_level_sum[l-1] + retval;
+            return retval;
+        }
+    private:
+        Scalar_ m_level_sum[32];
+        Scalar_ m_block_sum;
+        Uint32 m_block_term_count;
+        Uint32 m_block_count;
+        Uint32 m_level_count;
+    };
+
+    static std::string type_as_string (bool verbose) { return "PairwiseSummation"; }
+};
+
+// Kahan's compensated summation, which carries the low-order bits lost in each
+// addition into the next one, so the error doesn't grow with the number of terms
+// (to first order).  costs 4 additions per term instead of 1.  NOTE: this relies
+// on the compiler not reassociating floating point arithmetic (e.g. -ffast-math).
+struct KahanSummation
+{
+    template <typename Scalar_>
+    class Accumulator_t
+    {
+    public:
+        Accumulator_t () : m_sum(0), m_compensation(0) { }
+        void add (Scalar_ const &term)
+        {
+            Scalar_ y(term - m_compensation);
+            Scalar_ t(m_sum + y);
+            m_compensation = (t - m_sum) - y;
+            m_sum = t;
+        }
+        Scalar_ value () const { return m_sum; }
+    private:
+        Scalar_ m_sum;
+        Scalar_ m_compensation;
+    };
+
+    static std::string type_as_string (bool verbose) { return "KahanSummation"; }
+};
+
+// accumulates in WiderScalar_f<Scalar_>::T (e.g. double for float) and rounds
+// the sum back to Scalar_ at the end.
+struct WideAccumulatorSummation
+{
+    template <typename Scalar_>
+    class Accumulator_t
+    {
+    public:
+        typedef typename WiderScalar_f<Scalar_>::T Wide;
+        Accumulator_t () : m_sum(0) { }
+        void add (Scalar_ const &term) { m_sum += Wide(term); }
+        Scalar_ value () const { return Scalar_(m_sum); }
+    private:
+        Wide m_sum;
+    };
+
+    static std::string type_as_string (bool verbose) { return "WideAccumulatorSummation"; }
+};
+
+// the default policy used by the summations in expression templates having scalar
+// type Scalar_.  a single contraction can use a different one via summed_using, e.g.
+//   y(i) = (a(i*j)*x(j)).summed_using<KahanSummation>();
+// which is preferable to changing the default.  the default can be changed by
+// specializing this, e.g. to use float storage for long contractions without losing
+// accuracy:
+//   namespace Tenh {
+//   template <> struct SummationPolicy_f<float> { typedef WideAccumulatorSummation T; };
+//   }
+// NOTE: such a specialization must be visible in every translation unit that uses
+// expression templates with that scalar type, before any of them are instantiated;
+// otherwise the program violates the one-definition rule.
+template <typename Scalar_>
+struct SummationPolicy_f
+{
+    typedef NaiveSummation T;
+private:
+    SummationPolicy_f();
+};
+
+} // end of namespace Tenh
+
+#endif // TENH_SUMMATIONPOLICY_HPP_
@@ -0,0 +1,550 @@
+// ///////////////////////////////////////////////////////////////////////////
+// tenh/utility/automaticdifferentiation.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#ifndef TENH_UTILITY_AUTOMATICDIFFERENTIATION_HPP_
+#define TENH_UTILITY_AUTOMATICDIFFERENTIATION_HPP_
+
+#include "tenh/core.hpp"
+
+#include <cmath>
+#include <ostream>
+#include <string>
+
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/meta/typestringof.hpp"
+#include "tenh/utility/functions.hpp"
+
+namespace Tenh {
+
+// ///////////////////////////////////////////////////////////////////////////
+// forward-mode automatic differentiation
+// ///////////////////////////////////////////////////////////////////////////
+
+// Dual_t<Scalar_,DIM_> carries a value along with its derivatives with respect to
+// DIM_ variables, and HyperDual_t<Scalar_,DIM_> additionally carries the second
+// derivatives, packed as the components of a Sym^2 tensor are (see sym2_packed_index).
+// all the derivatives are propagated at once, so a function written generically in
+// its scalar type yields its whole gradient (and Hessian) from a single evaluation.
+// both types can be used as the Scalar_ of ImplementationOf_t and in expression
+// templates, though all the tensors in an expression must have the same scalar type.
+// the elementary functions below are found by argument-dependent lookup, so generic
+// code should call them unqualified after e.g. `using std::sqrt;`.
+
+template <typename Scalar_, Uint32 DIM_>
+class Dual_t
+{
+public:
+
+    static Uint32 const DIM = DIM_;
+
+    // this leaves the components uninitialized, like the builtin scalar types do
+    Dual_t () { }
+    // a constant, i.e. having zero derivatives.  this is deliberately not explicit,
+    // so that constants mix freely with Dual_t values.
+    Dual_t (Scalar_ value)
+        :
+        m_value(value)
+    {
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] = Scalar_(0);
+    }
+
+    // the variable having the given index, i.e. having derivative 1 with respect to
+    // itself and 0 with respect to the others.
+    static Dual_t variable (Scalar_ value, Uint32 index)
+    {
+        assert(index < DIM_ && "index out of range");
+        Dual_t retval(value);
+        retval.m_derivative[index] = Scalar_(1);
+        return retval;
+    }
+
+    Scalar_ const &value () const { return m_value; }
+    Scalar_ &value () { return m_value; }
+    Scalar_ const &derivative (Uint32 a) const { assert(a < DIM_); return m_derivative[a]; }
+    Scalar_ &derivative (Uint32 a) { assert(a < DIM_); return m_derivative[a]; }
+
+    // returns g(*this), given g and g' evaluated at value().  this is how the
+    // elementary functions are defined, and can be used to define others.
+    Dual_t chain_rule (Scalar_ g, Scalar_ dg) const
+    {
+        Dual_t retval;
+        retval.m_value = g;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            retval.m_derivative[a] = dg * m_derivative[a];
+        return retval;
+    }
+
+    Dual_t &operator += (Dual_t const &x)
+    {
+        m_value += x.m_value;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] += x.m_derivative[a];
+        return *this;
+    }
+    Dual_t &operator -= (Dual_t const &x)
+    {
+        m_value -= x.m_value;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] -= x.m_derivative[a];
+        return *this;
+    }
+    Dual_t &operator *= (Dual_t const &x) { return *this = *this * x; }
+    Dual_t &operator /= (Dual_t const &x) { return *this = *this / x; }
+    Dual_t &operator += (Scalar_ x) { m_value += x; return *this; }
+    Dual_t &operator -= (Scalar_ x) { m_value -= x; return *this; }
+    Dual_t &operator *= (Scalar_ x)
+    {
+        m_value *= x;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] *= x;
+        return *this;
+    }
+    Dual_t &operator /= (Scalar_ x) { return *this *= Scalar_(1) / x; }
+
+    friend Dual_t operator + (Dual_t const &x) { return x; }
+    friend Dual_t operator - (Dual_t const &x) { return x.chain_rule(-x.m_value, Scalar_(-1)); }
+
+    friend Dual_t operator + (Dual_t x, Dual_t const &y) { return x += y; }
+    friend Dual_t operator + (Dual_t x, Scalar_ y) { return x += y; }
+    friend Dual_t operator + (Scalar_ x, Dual_t y) { return y += x; }
+    friend Dual_t operator - (Dual_t x, Dual_t const &y) { return x -= y; }
+    friend Dual_t operator - (Dual_t x, Scalar_ y) { return x -= y; }
+    friend Dual_t operator - (Scalar_ x, Dual_t const &y) { return -y + x; }
+    friend Dual_t operator * (Dual_t const &x, Dual_t const &y)
+    {
+        Dual_t retval;
+        retval.m_value = x.m_value * y.m_value;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            retval.m_derivative[a] = x.m_derivative[a] * y.m_value + x.m_value * y.m_derivative[a];
+        return retval;
+    }
+    friend Dual_t operator * (Dual_t x, Scalar_ y) { return x *= y; }
+    friend Dual_t operator * (Scalar_ x, Dual_t y) { return y *= x; }
+    friend Dual_t operator / (Dual_t const &x, Dual_t const &y)
+    {
+        Scalar_ reciprocal = Scalar_(1) / y.m_value;
+        Dual_t retval;
+        retval.m_value = x.m_value * reciprocal;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            retval.m_derivative[a] = (x.m_derivative[a] - retval.m_value * y.m_derivative[a]) * reciprocal;
+        return retval;
+    }
+    friend Dual_t operator / (Dual_t x, Scalar_ y) { return x /= y; }
+    friend Dual_t operator / (Scalar_ x, Dual_t const &y)
+    {
+        Scalar_ reciprocal = Scalar_(1) / y.m_value;
+        return y.chain_rule(x * reciprocal, -x * reciprocal * reciprocal);
+    }
+
+    // comparisons are of the values only
+    friend bool operator == (Dual_t const &x, Dual_t const &y) { return x.m_value == y.m_value; }
+    friend bool operator != (Dual_t const &x, Dual_t const &y) { return x.m_value != y.m_value; }
+    friend bool operator < (Dual_t const &x, Dual_t const &y) { return x.m_value < y.m_value; }
+    friend bool operator <= (Dual_t const &x, Dual_t const &y) { return x.m_value <= y.m_value; }
+    friend bool operator > (Dual_t const &x, Dual_t const &y) { return x.m_value > y.m_value; }
+    friend bool operator >= (Dual_t const &x, Dual_t const &y) { return x.m_value >= y.m_value; }
+
+    friend std::ostream &operator << (std::ostream &out, Dual_t const &x)
+    {
+        out << '(' << x.m_value << "; ";
+        for (Uint32 a = 0; a < DIM_; ++a)
+            out << (a == 0 ? "" : ", ") << x.m_derivative[a];
+        return out << ')';
+    }
+
+    static std::string type_as_string (bool verbose)
+    {
+        return "Dual_t<" + type_string_of<Scalar_>() + ',' + FORMAT(DIM_) + '>';
+    }
+
+private:
+
+    Scalar_ m_value;
+    Scalar_ m_derivative[DIM_];
+};
+
+template <typename Scalar_, Uint32 DIM_>
+class HyperDual_t
+{
+public:
+
+    static Uint32 const DIM = DIM_;
+    static Uint32 const SECOND_DERIVATIVE_COUNT = DIM_*(DIM_+1)/2;
+
+    // this leaves the components uninitialized, like the builtin scalar types do
+    HyperDual_t () { }
+    // a constant, i.e. having zero derivatives.  this is deliberately not explicit,
+    // so that constants mix freely with HyperDual_t values.
+    HyperDual_t (Scalar_ value)
+        :
+        m_value(value)
+    {
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] = Scalar_(0);
+        for (Uint32 k = 0; k < SECOND_DERIVATIVE_COUNT; ++k)
+            m_second_derivative[k] = Scalar_(0);
+    }
+
+    // the variable having the given index, i.e. having derivative 1 with respect to
+    // itself and 0 with respect to the others.
+    static HyperDual_t variable (Scalar_ value, Uint32 index)
+    {
+        assert(index < DIM_ && "index out of range");
+        HyperDual_t retval(value);
+        retval.m_derivative[index] = Scalar_(1);
+        return retval;
+    }
+
+    Scalar_ const &value () const { return m_value; }
+    Scalar_ &value () { return m_value; }
+    Scalar_ const &derivative (Uint32 a) const { assert(a < DIM_); return m_derivative[a]; }
+    Scalar_ &derivative (Uint32 a) { assert(a < DIM_); return m_derivative[a]; }
+    Scalar_ const &second_derivative (Uint32 a, Uint32 b) const { assert(a < DIM_ && b < DIM_); return m_second_derivative[sym2_packed_index(a, b)]; }
+    Scalar_ &second_derivative (Uint32 a, Uint32 b) { assert(a < DIM_ && b < DIM_); return m_second_derivative[sym2_packed_index(a, b)]; }
+    // the second derivatives, in the order of the components of a Sym^2 tensor
+    Scalar_ const &packed_second_derivative (Uint32 k) const { assert(k < SECOND_DERIVATIVE_COUNT); return m_second_derivative[k]; }
+
+    // returns g(*this), given g, g' and g'' evaluated at value().  this is how the
+    // elementary functions are defined, and can be used to define others.
+    HyperDual_t chain_rule (Scalar_ g, Scalar_ dg, Scalar_ d2g) const
+    {
+        HyperDual_t retval;
+        retval.m_value = g;
+        for (Uint32 a = 0, k = 0; a < DIM_; ++a)
+        {
+            retval.m_derivative[a] = dg * m_derivative[a];
+            for (Uint32 b = 0; b <= a; ++b, ++k)
+                retval.m_second_derivative[k] = dg * m_second_derivative[k] + d2g * m_derivative[a] * m_derivative[b];
+        }
+        return retval;
+    }
+
+    HyperDual_t &operator += (HyperDual_t const &x)
+    {
+        m_value += x.m_value;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] += x.m_derivative[a];
+        for (Uint32 k = 0; k < SECOND_DERIVATIVE_COUNT; ++k)
+            m_second_derivative[k] += x.m_second_derivative[k];
+        return *this;
+    }
+    HyperDual_t &operator -= (HyperDual_t const &x)
+    {
+        m_value -= x.m_value;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] -= x.m_derivative[a];
+        for (Uint32 k = 0; k < SECOND_DERIVATIVE_COUNT; ++k)
+            m_second_derivative[k] -= x.m_second_derivative[k];
+        return *this;
+    }
+    HyperDual_t &operator *= (HyperDual_t const &x) { return *this = *this * x; }
+    HyperDual_t &operator /= (HyperDual_t const &x) { return *this = *this / x; }
+    HyperDual_t &operator += (Scalar_ x) { m_value += x; return *this; }
+    HyperDual_t &operator -= (Scalar_ x) { m_value -= x; return *this; }
+    HyperDual_t &operator *= (Scalar_ x)
+    {
+        m_value *= x;
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_derivative[a] *= x;
+        for (Uint32 k = 0; k < SECOND_DERIVATIVE_COUNT; ++k)
+            m_second_derivative[k] *= x;
+        return *this;
+    }
+    HyperDual_t &operator /= (Scalar_ x) { return *this *= Scalar_(1) / x; }
+
+    friend HyperDual_t operator + (HyperDual_t const &x) { return x; }
+    friend HyperDual_t operator - (HyperDual_t x) { return x *= Scalar_(-1); }
+
+    friend HyperDual_t operator + (HyperDual_t x, HyperDual_t const &y) { return x += y; }
+    friend HyperDual_t operator + (HyperDual_t x, Scalar_ y) { return x += y; }
+    friend HyperDual_t operator + (Scalar_ x, HyperDual_t y) { return y += x; }
+    friend HyperDual_t operator - (HyperDual_t x, HyperDual_t const &y) { return x -= y; }
+    friend HyperDual_t operator - (HyperDual_t x, Scalar_ y) { return x -= y; }
+    friend HyperDual_t operator - (Scalar_ x, HyperDual_t const &y) { return -y + x; }
+    friend HyperDual_t operator * (HyperDual_t const &x, HyperDual_t const &y)
+    {
+        HyperDual_t retval;
+        retval.m_value = x.m_value * y.m_value;
+        for (Uint32 a = 0, k = 0; a < DIM_; ++a)
+        {
+            retval.m_derivative[a] = x.m_derivative[a] * y.m_value + x.m_value * y.m_derivative[a];
+            for (Uint32 b = 0; b <= a; ++b, ++k)
+                retval.m_second_derivative[k] = x.m_second_derivative[k] * y.m_value
+                                              + x.m_value * y.m_second_derivative[k]
+                                              + x.m_derivative[a] * y.m_derivative[b]
+                                              + x.m_derivative[b] * y.m_derivative[a];
+        }
+        return retval;
+    }
+    friend HyperDual_t operator * (HyperDual_t x, Scalar_ y) { return x *= y; }
+    friend HyperDual_t operator * (Scalar_ x, HyperDual_t y) { return y *= x; }
+    friend HyperDual_t operator / (HyperDual_t const &x, HyperDual_t const &y) { return x * (Scalar_(1) / y); }
+    friend HyperDual_t operator / (HyperDual_t x, Scalar_ y) { return x /= y; }
+    friend HyperDual_t operator / (Scalar_ x, HyperDual_t const &y)
+    {
+        Scalar_ reciprocal = Scalar_(1) / y.m_value;
+        Scalar_ g = x * reciprocal;
+        return y.chain_rule(g, -g * reciprocal, Scalar_(2) * g * reciprocal * reciprocal);
+    }
+
+    // comparisons are of the values only
+    friend bool operator == (HyperDual_t const &x, HyperDual_t const &y) { return x.m_value == y.m_value; }
+    friend bool operator != (HyperDual_t const &x, HyperDual_t const &y) { return x.m_value != y.m_value; }
+    friend bool operator < (HyperDual_t const &x, HyperDual_t const &y) { return x.m_value < y.m_value; }
+    friend bool operator <= (HyperDual_t const &x, HyperDual_t const &y) { return x.m_value <= y.m_value; }
+    friend bool operator > (HyperDual_t const &x, HyperDual_t const &y) { return x.m_value > y.m_value; }
+    friend bool operator >= (HyperDual_t const &x, HyperDual_t const &y) { return x.m_value >= y.m_value; }
+
+    friend std::ostream &operator << (std::ostream &out, HyperDual_t const &x)
+    {
+        out << '(' << x.m_value << "; ";
+        for (Uint32 a = 0; a < DIM_; ++a)
+            out << (a == 0 ? "" : ", ") << x.m_derivative[a];
+        out << "; ";
+        for (Uint32 k = 0; k < SECOND_DERIVATIVE_COUNT; ++k)
+            out << (k == 0 ? "" : ", ") << x.m_second_derivative[k];
+        return out << ')';
+    }
+
+    static std::string type_as_string (bool verbose)
+    {
+        return "HyperDual_t<" + type_string_of<Scalar_>() + ',' + FORMAT(DIM_) + '>';
+    }
+
+private:
+
+    Scalar_ m_value;
+    Scalar_ m_derivative[DIM_];
+    Scalar_ m_second_derivative[SECOND_DERIVATIVE_COUNT];
+};
+
+// the derivatives of e.g. a squared norm are wanted too, so reductions are done in
+// the dual types themselves.
+template <typename Scalar_, Uint32 DIM_>
+struct AssociatedFloatingPointType_t<Dual_t<Scalar_,DIM_>> { typedef Dual_t<Scalar_,DIM_> T; };
+
+template <typename Scalar_, Uint32 DIM_>
+struct AssociatedFloatingPointType_t<HyperDual_t<Scalar_,DIM_>> { typedef HyperDual_t<Scalar_,DIM_> T; };
+
+// ///////////////////////////////////////////////////////////////////////////
+// elementary functions
+// ///////////////////////////////////////////////////////////////////////////
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> sqrt (Dual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ g = std::sqrt(x.value());
+    return x.chain_rule(g, Scalar_(1) / (Scalar_(2) * g));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> sqrt (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ g = std::sqrt(x.value());
+    Scalar_ dg = Scalar_(1) / (Scalar_(2) * g);
+    return x.chain_rule(g, dg, -dg / (Scalar_(2) * x.value()));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> exp (Dual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ g = std::exp(x.value());
+    return x.chain_rule(g, g);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> exp (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ g = std::exp(x.value());
+    return x.chain_rule(g, g, g);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> log (Dual_t<Scalar_,DIM_> const &x)
+{
+    return x.chain_rule(std::log(x.value()), Scalar_(1) / x.value());
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> log (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ reciprocal = Scalar_(1) / x.value();
+    return x.chain_rule(std::log(x.value()), reciprocal, -reciprocal * reciprocal);
+}
+
+// x^p for a constant exponent p.  the value and each derivative are computed with
+// their own power of x (and a derivative whose coefficient is zero is exactly zero),
+// so that e.g. pow(x, 1) is well-defined at x = 0.
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> pow (Dual_t<Scalar_,DIM_> const &x, Scalar_ p)
+{
+    Scalar_ dg = p == Scalar_(0) ? Scalar_(0) : p * std::pow(x.value(), p - Scalar_(1));
+    return x.chain_rule(std::pow(x.value(), p), dg);
+}
+
+// x^p for a constant exponent p (see the Dual_t version)
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> pow (HyperDual_t<Scalar_,DIM_> const &x, Scalar_ p)
+{
+    Scalar_ dg = p == Scalar_(0) ? Scalar_(0) : p * std::pow(x.value(), p - Scalar_(1));
+    Scalar_ ddg = p == Scalar_(0) || p == Scalar_(1) ? Scalar_(0) : p * (p - Scalar_(1)) * std::pow(x.value(), p - Scalar_(2));
+    return x.chain_rule(std::pow(x.value(), p), dg, ddg);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> sin (Dual_t<Scalar_,DIM_> const &x)
+{
+    return x.chain_rule(std::sin(x.value()), std::cos(x.value()));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> sin (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ s = std::sin(x.value());
+    return x.chain_rule(s, std::cos(x.value()), -s);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> cos (Dual_t<Scalar_,DIM_> const &x)
+{
+    return x.chain_rule(std::cos(x.value()), -std::sin(x.value()));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> cos (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ c = std::cos(x.value());
+    return x.chain_rule(c, -std::sin(x.value()), -c);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> sinh (Dual_t<Scalar_,DIM_> const &x)
+{
+    return x.chain_rule(std::sinh(x.value()), std::cosh(x.value()));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> sinh (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ s = std::sinh(x.value());
+    return x.chain_rule(s, std::cosh(x.value()), s);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> cosh (Dual_t<Scalar_,DIM_> const &x)
+{
+    return x.chain_rule(std::cosh(x.value()), std::sinh(x.value()));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> cosh (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ c = std::cosh(x.value());
+    return x.chain_rule(c, std::sinh(x.value()), c);
+}
+
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> atan (Dual_t<Scalar_,DIM_> const &x)
+{
+    return x.chain_rule(std::atan(x.value()), Scalar_(1) / (Scalar_(1) + x.value()*x.value()));
+}
+
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> atan (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ dg = Scalar_(1) / (Scalar_(1) + x.value()*x.value());
+    return x.chain_rule(std::atan(x.value()), dg, Scalar_(-2) * x.value() * dg * dg);
+}
+
+// the derivative at 0 is taken to be 0
+template <typename Scalar_, Uint32 DIM_>
+Dual_t<Scalar_,DIM_> abs (Dual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ sign = x.value() > Scalar_(0) ? Scalar_(1) : (x.value() < Scalar_(0) ? Scalar_(-1) : Scalar_(0));
+    return x.chain_rule(std::abs(x.value()), sign);
+}
+
+// the derivative at 0 is taken to be 0
+template <typename Scalar_, Uint32 DIM_>
+HyperDual_t<Scalar_,DIM_> abs (HyperDual_t<Scalar_,DIM_> const &x)
+{
+    Scalar_ sign = x.value() > Scalar_(0) ? Scalar_(1) : (x.value() < Scalar_(0) ? Scalar_(-1) : Scalar_(0));
+    return x.chain_rule(std::abs(x.value()), sign, Scalar_(0));
+}
+
+// ///////////////////////////////////////////////////////////////////////////
+// deriving D_function and D2_function
+// ///////////////////////////////////////////////////////////////////////////
+
+// supplies D_function and D2_function for a scalar-valued function object whose
+// `function` method accepts vectors of any scalar type, e.g.
+//
+//     template <typename Derived_, typename S_, ComponentQualifier COMPONENT_QUALIFIER_>
+//     S_ function (Vector_i<Derived_,S_,ParameterSpace_,COMPONENT_QUALIFIER_> const &x) const;
+//
+// D_function evaluates it once with Dual_t components and D2_function evaluates it
+// once with HyperDual_t components, seeded so that the derivatives are with respect
+// to the components of x.  the differentials are with respect to the basis of
+// ParameterSpace_, as the hand-written ones are.
+template <typename Function_, typename ParameterSpace_, typename Scalar_>
+struct AutomaticallyDifferentiated_t : public Function_
+{
+    typedef FunctionObjectType_m<ParameterSpace_,Scalar_,Scalar_> FunctionObjectType;
+
+    typedef typename FunctionObjectType::DualOfBasedVectorSpace DualOfBasedVectorSpace;
+    typedef typename FunctionObjectType::Sym2Dual Sym2Dual;
+    typedef typename FunctionObjectType::Differential1 Differential1;
+    typedef typename FunctionObjectType::Differential2 Differential2;
+    typedef typename FunctionObjectType::Domain Domain;
+    typedef typename FunctionObjectType::CoDomain CoDomain;
+    typedef typename FunctionObjectType::Scalar Scalar;
+
+    typedef typename FunctionObjectType::V V;
+    typedef typename FunctionObjectType::DualOfV DualOfV;
+    typedef typename FunctionObjectType::Sym2_DualOfV Sym2_DualOfV;
+    typedef typename FunctionObjectType::In In;
+    typedef typename FunctionObjectType::Out Out;
+    typedef typename FunctionObjectType::D1 D1;
+    typedef typename FunctionObjectType::D2 D2;
+
+    static Uint32 const DIM = DimensionOf_f<ParameterSpace_>::V;
+    typedef Dual_t<Scalar_,DIM> Dual;
+    typedef HyperDual_t<Scalar_,DIM> HyperDual;
+
+    AutomaticallyDifferentiated_t () { }
+    AutomaticallyDifferentiated_t (Function_ const &f) : Function_(f) { }
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        typedef ImplementationOf_t<Domain,Dual> DualVector;
+        DualVector dual_x(Static<WithoutInitialization>::SINGLETON);
+        for (typename DualVector::ComponentIndex c; c.is_not_at_end(); ++c)
+            dual_x[c] = Dual::variable(x[typename V::ComponentIndex(c.value(), CheckRange::FALSE)], c.value());
+        Dual y(this->function(dual_x));
+        D1 retval(Static<WithoutInitialization>::SINGLETON);
+        for (typename D1::ComponentIndex c; c.is_not_at_end(); ++c)
+            retval[c] = y.derivative(c.value());
+        return retval;
+    }
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        typedef ImplementationOf_t<Domain,HyperDual> HyperDualVector;
+        HyperDualVector hyperdual_x(Static<WithoutInitialization>::SINGLETON);
+        for (typename HyperDualVector::ComponentIndex c; c.is_not_at_end(); ++c)
+            hyperdual_x[c] = HyperDual::variable(x[typename V::ComponentIndex(c.value(), CheckRange::FALSE)], c.value());
+        HyperDual y(this->function(hyperdual_x));
+        D2 retval(Static<WithoutInitialization>::SINGLETON);
+        for (typename D2::ComponentIndex c; c.is_not_at_end(); ++c)
+            retval[c] = y.packed_second_derivative(c.value());
+        return retval;
+    }
+};
+
+} // end of namespace Tenh
+
+#endif // TENH_UTILITY_AUTOMATICDIFFERENTIATION_HPP_
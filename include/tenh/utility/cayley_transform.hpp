@@ -137,6 +137,7 @@ public:
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
     J_t ()
         :
@@ -171,6 +172,12 @@ public:
         return m_D2;
     }
 
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        return Jet(function(x), D_function(x), m_D2);
+    }
+
 private:
 
     typename InnerProduct_f<BasedVectorSpace_,StandardInnerProduct,Scalar_>::T m_inner_product;
@@ -198,6 +205,7 @@ struct K_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
     K_t ()
         :
@@ -243,6 +251,24 @@ struct K_t
         return retval;
     }
 
+    // with f = function(x), D_function(x) = -f^2*w, where w = m_form.split(i*j)*x(i),
+    // so D2_function(x) = f^2*(2*f*w*w - m_form) = (2/f)*D_function(x)^2 - f^2*m_form,
+    // and f only needs to be computed once.
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        AbstractIndex_c<'i'> i;
+        AbstractIndex_c<'j'> j;
+        AbstractIndex_c<'p'> p;
+        Scalar_ f_of_x(function(x));
+        Scalar_ f_of_x_squared(sqr(f_of_x));
+        Jet retval(f_of_x);
+        retval.D1(j).no_alias() = -f_of_x_squared*x(i)*m_form.split(i*j);
+        retval.D2(p).no_alias() = -f_of_x_squared*m_form(p);
+        sym2_rank1_update(retval.D2, Scalar_(2)/f_of_x, retval.D1);
+        return retval;
+    }
+
 private:
 
     typename InnerProduct_f<BasedVectorSpace_,StandardInnerProduct,Scalar_>::T m_inner_product;
@@ -271,21 +297,76 @@ struct N_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
+
+    // N is quadratic, so its second derivative is constant and is computed once
+    N_t ()
+        :
+        m_D2(Static<WithoutInitialization>::SINGLETON)
+    {
+        AbstractIndex_c<'i'> i;
+        AbstractIndex_c<'j'> j;
+        AbstractIndex_c<'k'> k;
+        AbstractIndex_c<'l'> l;
+        AbstractIndex_c<'p'> p;
+        AbstractIndex_c<'B'> B;
+        AbstractIndex_c<'C'> C;
+        // J_t's second derivative doesn't depend on the point
+        V zero(fill_with(Scalar_(0)));
+        m_D2(C*p) = m_identity(B).split(B,C)*m_J.D2_function(zero)(p)
+                    + Scalar_(2)
+                      * (  (m_identity.split(i*k)*m_inner_product.split(j*l))
+                        .bundle(i*j,typename Out::Concept(),C)
+                        .bundle(k*l,typename Sym2_DualOfV::Concept(),p)
+                    + (m_identity.split(i*l)*m_inner_product.split(j*k))
+                      .bundle(i*j,typename Out::Concept(),C)
+                      .bundle(k*l,typename Sym2_DualOfV::Concept(),p));
+    }
 
     template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
     Out function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        return function(x, m_J.function(x));
+    }
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        return D_function(x, m_J.D_function(x));
+    }
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        return m_D2;
+    }
+
+    // the jet of J is evaluated once
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        typename J_t<BasedVectorSpace_,Scalar_>::Jet J_jet(m_J.evaluate_jet(x));
+        return Jet(function(x, J_jet.value), D_function(x, J_jet.D1), m_D2);
+    }
+
+private:
+
+    // the value and differential of N at x, given those of J at x
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x, Scalar_ J_of_x) const
     {
         AbstractIndex_c<'i'> i;
         AbstractIndex_c<'j'> j;
         AbstractIndex_c<'p'> p;
         Out retval(Static<WithoutInitialization>::SINGLETON);
-        retval(i*j).no_alias() =   m_J.function(x)*m_identity.split(i*j)
+        retval(i*j).no_alias() =   J_of_x*m_identity.split(i*j)
                                  + Scalar_(2) * (x(i)*m_inner_product.split(j*p)*x(p) + hat(x)(i*j));
         return retval;
     }
 
     template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
-    D1 D_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    D1 D_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x,
+                   typename J_t<BasedVectorSpace_,Scalar_>::D1 const &D_J_of_x) const
     {
         AbstractIndex_c<'i'> i;
         AbstractIndex_c<'j'> j;
@@ -294,7 +375,7 @@ struct N_t
         AbstractIndex_c<'A'> A;
         AbstractIndex_c<'B'> B;
         D1 retval(Static<WithoutInitialization>::SINGLETON);
-        retval(B*k).no_alias() = (  m_identity.split(i*j)*m_J.D_function(x)(k)
+        retval(B*k).no_alias() = (  m_identity.split(i*j)*D_J_of_x(k)
                                   + Scalar_(2) * (  m_identity.split(i*k)*m_inner_product.split(j*p)*x(p)
                                                   + x(i)*m_inner_product.split(j*k)
                                                   + m_hat_tensor(A*k).split(A,i*j)))
@@ -302,35 +383,12 @@ struct N_t
         return retval;
     }
 
-    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
-    D2 D2_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
-    {
-        AbstractIndex_c<'i'> i;
-        AbstractIndex_c<'j'> j;
-        AbstractIndex_c<'k'> k;
-        AbstractIndex_c<'l'> l;
-        AbstractIndex_c<'p'> p;
-        AbstractIndex_c<'B'> B;
-        AbstractIndex_c<'C'> C;
-        D2 retval(Static<WithoutInitialization>::SINGLETON);
-        retval(C*p).no_alias() = m_identity(B).split(B,C)*m_J.D2_function(x)(p)
-                                 + Scalar_(2)
-                                   * (  (m_identity.split(i*k)*m_inner_product.split(j*l))
-                                     .bundle(i*j,typename Out::Concept(),C)
-                                     .bundle(k*l,typename Sym2_DualOfV::Concept(),p)
-                                 + (m_identity.split(i*l)*m_inner_product.split(j*k))
-                                   .bundle(i*j,typename Out::Concept(),C)
-                                   .bundle(k*l,typename Sym2_DualOfV::Concept(),p));
-        return retval;
-    }
-
-private:
-
     J_t<BasedVectorSpace_,Scalar_> m_J;
     typename Identity_f<BasedVectorSpace_,Scalar_>::T m_identity;
     typename InnerProduct_f<BasedVectorSpace_,StandardInnerProduct,Scalar_>::T m_inner_product;
     typename InnerProduct_f<DualOfBasedVectorSpace,StandardInnerProduct,Scalar_>::T m_inner_product_inverse;
     typename HatTensor_f<BasedVectorSpace_,Scalar_>::T m_hat_tensor;
+    D2 m_D2;
 };
 
 template <typename BasedVectorSpace_, typename Scalar_>
@@ -355,15 +413,32 @@ struct CayleyTransform_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
+    // K(x)*N(x) written out in components, where with s = x(i)*x(i),
+    //     K(x)*N(x) = ((1 - s)*I + 2*x*x^T + 2*hat(x)) / (1 + s).
     template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
     Out function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
     {
-        AbstractIndex_c<'i'> i;
+        typedef typename Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_>::ComponentIndex c;
+        typedef typename Out::ComponentIndex C;
+        Scalar_ x0(x[c(0)]);
+        Scalar_ x1(x[c(1)]);
+        Scalar_ x2(x[c(2)]);
+        Scalar_ s(x0*x0 + x1*x1 + x2*x2);
+        Scalar_ k(Scalar_(1) / (Scalar_(1) + s));
+        Scalar_ diagonal((Scalar_(1) - s) * k);
+        Scalar_ two_k(Scalar_(2) * k);
         Out retval(Static<WithoutInitialization>::SINGLETON);
-
-        retval(i).no_alias() = m_K.function(x) * m_N.function(x)(i);
-
+        retval[C(0)] = diagonal + two_k*x0*x0;
+        retval[C(1)] = two_k*(x0*x1 - x2);
+        retval[C(2)] = two_k*(x0*x2 + x1);
+        retval[C(3)] = two_k*(x1*x0 + x2);
+        retval[C(4)] = diagonal + two_k*x1*x1;
+        retval[C(5)] = two_k*(x1*x2 - x0);
+        retval[C(6)] = two_k*(x2*x0 - x1);
+        retval[C(7)] = two_k*(x2*x1 + x0);
+        retval[C(8)] = diagonal + two_k*x2*x2;
         return retval;
     }
 
@@ -372,35 +447,54 @@ struct CayleyTransform_t
     {
         AbstractIndex_c<'i'> i;
         AbstractIndex_c<'j'> j;
+        typename K::Jet K_jet(m_K.evaluate_jet(x));
+        typename N::Out N_of_x(m_N.function(x));
         D1 retval(Static<WithoutInitialization>::SINGLETON);
 
         //retval(i*j).no_alias() = D_K(x)(j)*N(x)(i) + K(x)*D_N(x)(i*j); // this should work but Tenh complains about the ordering
-        retval(i*j).no_alias() =   m_N.function(x)(i)*m_K.D_function(x)(j) 
-                                 + m_K.function(x)*m_N.D_function(x).split(i*j);
+        retval(i*j).no_alias() =   N_of_x(i)*K_jet.D1(j)
+                                 + K_jet.value*m_N.D_function(x).split(i*j);
 
         return retval;
     }
+
     template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
     D2 D2_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
     {
+        return evaluate_jet(x).D2;
+    }
+
+    // the jets of K and N are each evaluated once, and the product rule is applied to them
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        AbstractIndex_c<'i'> i;
         AbstractIndex_c<'j'> j;
         AbstractIndex_c<'k'> k;
         AbstractIndex_c<'p'> p;
         AbstractIndex_c<'C'> C;
-        D2 retval(Static<WithoutInitialization>::SINGLETON);
-
-        retval(C*p).no_alias() =   m_N.function(x)(C)*m_K.D2_function(x)(p)
-                                 + (m_N.D_function(x)(C*k)*m_K.D_function(x)(j)).bundle(j*k,typename Sym2_DualOfV::Concept(),p)
-                                 + (m_K.D_function(x)(k)*m_N.D_function(x)(C*j)).bundle(j*k,typename Sym2_DualOfV::Concept(),p)
-                                 + m_K.function(x)*m_N.D2_function(x)(C*p);
-
+        typename K::Jet K_jet(m_K.evaluate_jet(x));
+        typename N::Jet N_jet(m_N.evaluate_jet(x));
+        Out value(Static<WithoutInitialization>::SINGLETON);
+        value(i).no_alias() = K_jet.value * N_jet.value(i);
+        Jet retval(value);
+
+        retval.D1(i*j).no_alias() =   N_jet.value(i)*K_jet.D1(j)
+                                    + K_jet.value*N_jet.D1.split(i*j);
+        retval.D2(C*p).no_alias() =   N_jet.value(C)*K_jet.D2(p)
+                                    + (N_jet.D1(C*k)*K_jet.D1(j)).bundle(j*k,typename Sym2_DualOfV::Concept(),p)
+                                    + (K_jet.D1(k)*N_jet.D1(C*j)).bundle(j*k,typename Sym2_DualOfV::Concept(),p)
+                                    + K_jet.value*N_jet.D2(C*p);
         return retval;
     }
 
 private:
 
-    K_t<BasedVectorSpace_,Scalar_> m_K;
-    N_t<BasedVectorSpace_,Scalar_> m_N;
+    typedef K_t<BasedVectorSpace_,Scalar_> K;
+    typedef N_t<BasedVectorSpace_,Scalar_> N;
+
+    K m_K;
+    N m_N;
     typename Identity_f<BasedVectorSpace_,Scalar_>::T m_identity;
     typename InnerProduct_f<BasedVectorSpace_,StandardInnerProduct,Scalar_>::T m_inner_product;
     typename InnerProduct_f<DualOfBasedVectorSpace,StandardInnerProduct,Scalar_>::T m_inner_product_inverse;
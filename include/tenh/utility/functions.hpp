@@ -8,12 +8,39 @@
 
 #include "tenh/core.hpp"
 
+#include <utility>
+
 #include "tenh/implementation/identity.hpp"
 #include "tenh/implementation/innerproduct.hpp"
 #include "tenh/utility/optimization.hpp"
 
 namespace Tenh {
 
+// the value, first derivative (D1) and second derivative (D2) of a function object
+// at a single point, as computed together by evaluate_jet, so that the intermediate
+// quantities they have in common only need to be computed once.  D1_ and D2_ are
+// always tensor types, so they can be left uninitialized when only the value is known.
+template <typename Out_, typename D1_, typename D2_>
+struct Jet_t
+{
+    explicit Jet_t (Out_ const &value_)
+        :
+        value(value_),
+        D1(Static<WithoutInitialization>::SINGLETON),
+        D2(Static<WithoutInitialization>::SINGLETON)
+    { }
+    Jet_t (Out_ const &value_, D1_ const &D1_value, D2_ const &D2_value)
+        :
+        value(value_),
+        D1(D1_value),
+        D2(D2_value)
+    { }
+
+    Out_ value;
+    D1_ D1;
+    D2_ D2;
+};
+
 // for arbitrary codomain
 template <typename ParameterSpace_, typename CodomainSpace_, typename Scalar_>
 struct FunctionObjectType_m
@@ -33,6 +60,7 @@ struct FunctionObjectType_m
     typedef ImplementationOf_t<CoDomain,Scalar_,UseMemberArray_t<ComponentsAreConst::FALSE>> Out;
     typedef ImplementationOf_t<Differential1,Scalar_,UseMemberArray_t<ComponentsAreConst::FALSE>> D1;
     typedef ImplementationOf_t<Differential2,Scalar_,UseMemberArray_t<ComponentsAreConst::FALSE>> D2;
+    typedef Jet_t<Out,D1,D2> Jet;
 };
 
 // template specialization for when CodomainSpace_ is Scalar_
@@ -55,8 +83,52 @@ struct FunctionObjectType_m<ParameterSpace_,Scalar_,Scalar_>
     typedef Scalar_ Out;
     typedef DualOfV D1;
     typedef Sym2_DualOfV D2;
+    typedef Jet_t<Out,D1,D2> Jet;
+};
+
+// the type of the jet of FunctionObject_, which needn't provide evaluate_jet
+template <typename FunctionObject_>
+struct JetOf_f
+{
+    typedef Jet_t<typename FunctionObject_::Out,typename FunctionObject_::D1,typename FunctionObject_::D2> T;
+private:
+    JetOf_f();
+};
+
+// true iff FunctionObject_ has an evaluate_jet method accepting its V
+template <typename FunctionObject_>
+struct HasEvaluateJet_f
+{
+private:
+    template <typename F_>
+    static Value_t<bool,true> test (decltype(std::declval<F_ const &>().evaluate_jet(std::declval<typename F_::V const &>())) *);
+    template <typename F_>
+    static Value_t<bool,false> test (...);
+    HasEvaluateJet_f();
+public:
+    static bool const V = decltype(test<FunctionObject_>(nullptr))::V;
 };
 
+template <typename FunctionObject_, typename X_>
+typename JetOf_f<FunctionObject_>::T evaluate_jet (FunctionObject_ const &f, X_ const &x, Value_t<bool,true> const &)
+{
+    return f.evaluate_jet(x);
+}
+
+template <typename FunctionObject_, typename X_>
+typename JetOf_f<FunctionObject_>::T evaluate_jet (FunctionObject_ const &f, X_ const &x, Value_t<bool,false> const &)
+{
+    return typename JetOf_f<FunctionObject_>::T(f.function(x), f.D_function(x), f.D2_function(x));
+}
+
+// the jet of f at x, using f.evaluate_jet if f has it, and otherwise calling each
+// of f.function, f.D_function and f.D2_function.
+template <typename FunctionObject_, typename X_>
+typename JetOf_f<FunctionObject_>::T evaluate_jet (FunctionObject_ const &f, X_ const &x)
+{
+    return evaluate_jet(f, x, Value_t<bool,HasEvaluateJet_f<FunctionObject_>::V>());
+}
+
 // for arbitrary codomain
 template <typename ParameterSpace_, typename CodomainSpace_, typename CodomainInnerProductId_, typename Scalar_, typename FunctionObject_>
 struct TaylorPolynomialVerifier_t
@@ -414,6 +486,7 @@ struct FunctionComposition_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
     FunctionComposition_t (OuterFunctionType_ const &outer, InnerFunctionType_ const &inner)
         :
@@ -492,6 +565,55 @@ struct FunctionComposition_t
         return retval;
     }
 
+    // the inner and outer functions' jets are each evaluated once
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        typedef AbstractIndex_c<'c'> C;
+        typedef AbstractIndex_c<'i'> I;
+        typedef AbstractIndex_c<'j'> J;
+        typedef AbstractIndex_c<'k'> K;
+        typedef AbstractIndex_c<'l'> L;
+        typedef AbstractIndex_c<'p'> P;
+        typedef AbstractIndex_c<'q'> Q;
+
+        I i;
+        J j;
+        K k;
+        L l;
+        P p;
+        Q q;
+
+        // depending on what OuterFunctionType_::Out is (Scalar or vector), the number of indices must be different
+        typename If_f<TypesAreEqual_f<typename OuterFunctionType_::Out,Scalar>::V,
+                      Typle_t<J>,
+                      Typle_t<C,J>>::T outer_D1_index;
+        typename If_f<TypesAreEqual_f<typename OuterFunctionType_::Out,Scalar>::V,
+                      Typle_t<K>,
+                      Typle_t<C,K>>::T retval_D1_index;
+        typename If_f<TypesAreEqual_f<typename OuterFunctionType_::Out,Scalar>::V,
+                      Typle_t<Q>,
+                      Typle_t<C,Q>>::T retval_D2_index;
+        typename If_f<TypesAreEqual_f<typename OuterFunctionType_::Out,Scalar>::V,
+                      Typle_t<P>,
+                      Typle_t<C,P>>::T outer_index;
+
+        typename JetOf_f<InnerFunctionType_>::T inner_jet(Tenh::evaluate_jet(m_inner, x));
+        typename JetOf_f<OuterFunctionType_>::T outer_jet(Tenh::evaluate_jet(m_outer, inner_jet.value));
+        Jet retval(outer_jet.value);
+
+        // chain rule
+        retval.D1(retval_D1_index) = outer_jet.D1(outer_D1_index) * inner_jet.D1(j*k);
+        // double chain rule
+        retval.D2(retval_D2_index) = (  outer_jet.D2(outer_index).split(p,i*j)
+                                      * inner_jet.D1(i*k)
+                                      * inner_jet.D1(j*l))
+                                     .bundle(k*l,Sym2Dual(),q)
+                                   + outer_jet.D1(outer_index)
+                                     * inner_jet.D2(p*q);
+        return retval;
+    }
+
 private:
 
     OuterFunctionType_ const &m_outer;
@@ -521,6 +643,7 @@ struct FunctionDirectSum_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
     typedef ImplementationOf_t<typename LeftFunctionType_::Domain, Scalar> Left;
     typedef typename LeftFunctionType_::D1 Left_D1;
@@ -558,21 +681,64 @@ struct FunctionDirectSum_t
         AbstractIndex_c<'a'> a;
         D1 retval(Static<WithoutInitialization>::SINGLETON);
         Left left(Static<WithoutInitialization>::SINGLETON);
-        Left_D1 left_d1(Static<WithoutInitialization>::SINGLETON);
         Right right(Static<WithoutInitialization>::SINGLETON);
-        Right_D1 right_d1(Static<WithoutInitialization>::SINGLETON);
 
         left(a) = x.as_derived().template el<0>()(a);
         right(a) = x.as_derived().template el<1>()(a);
 
-        left_d1(a) = m_left.D_function(left)(a);
-        right_d1(a) = m_right.D_function(right)(a);
+        assemble_D1(m_left.D_function(left), m_right.D_function(right), retval);
+        return retval;
+    }
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        AbstractIndex_c<'a'> a;
+        D2 retval(Static<WithoutInitialization>::SINGLETON);
+        Left left(Static<WithoutInitialization>::SINGLETON);
+        Right right(Static<WithoutInitialization>::SINGLETON);
+
+        left(a) = x.as_derived().template el<0>()(a);
+        right(a) = x.as_derived().template el<1>()(a);
+
+        assemble_D2(m_left.D2_function(left), m_right.D2_function(right), retval);
+        return retval;
+    }
+
+    // the left and right functions' jets are each evaluated once
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        AbstractIndex_c<'a'> a;
+        Out value(Static<WithoutInitialization>::SINGLETON);
+        Left left(Static<WithoutInitialization>::SINGLETON);
+        Right right(Static<WithoutInitialization>::SINGLETON);
+
+        left(a) = x.as_derived().template el<0>()(a);
+        right(a) = x.as_derived().template el<1>()(a);
+
+        typename JetOf_f<LeftFunctionType_>::T left_jet(Tenh::evaluate_jet(m_left, left));
+        typename JetOf_f<RightFunctionType_>::T right_jet(Tenh::evaluate_jet(m_right, right));
+
+        value.template el<0>()(a) = left_jet.value(a);
+        value.template el<1>()(a) = right_jet.value(a);
 
+        Jet retval(value);
+        assemble_D1(left_jet.D1, right_jet.D1, retval.D1);
+        assemble_D2(left_jet.D2, right_jet.D2, retval.D2);
+        return retval;
+    }
+
+private:
+
+    // the differential of the direct sum is block diagonal
+    static void assemble_D1 (Left_D1 const &left_d1, Right_D1 const &right_d1, D1 &retval)
+    {
         //retval((i+j)*(k+l)) = right_d1(i*k) + left_d1(j*l);
 
-        for (int i = 0; i < DimensionOf_f<CoDomain>::V; ++i)
+        for (Uint32 i = 0; i < DimensionOf_f<CoDomain>::V; ++i)
         {
-            for (int j = 0; j < DimensionOf_f<DualOfBasedVectorSpace>::V; ++j)
+            for (Uint32 j = 0; j < DimensionOf_f<DualOfBasedVectorSpace>::V; ++j)
             {
                 if (i < DimensionOf_f<typename LeftFunctionType_::CoDomain>::V && j < DimensionOf_f<typename LeftFunctionType_::DualOfBasedVectorSpace>::V)
                 {
@@ -591,11 +757,9 @@ struct FunctionDirectSum_t
                 }
             }
         }
-        return retval;
     }
 
-    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
-    D2 D2_function (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    static void assemble_D2 (Left_D2 const &left_d2, Right_D2 const &right_d2, D2 &retval)
     {
         typedef TensorProductOfBasedVectorSpaces_c<Typle_t<CoDomain,
                                                    DualOfBasedVectorSpace,
@@ -615,29 +779,18 @@ struct FunctionDirectSum_t
         AbstractIndex_c<'c'> c;
         AbstractIndex_c<'d'> d;
 
-        D2 retval(Static<WithoutInitialization>::SINGLETON);
         SplitD2 tmp(Static<WithoutInitialization>::SINGLETON);
-        Left left(Static<WithoutInitialization>::SINGLETON);
-        Left_D2 left_d2(Static<WithoutInitialization>::SINGLETON);
         LeftSplitD2 left_split_d2(Static<WithoutInitialization>::SINGLETON);
-        Right right(Static<WithoutInitialization>::SINGLETON);
-        Right_D2 right_d2(Static<WithoutInitialization>::SINGLETON);
         RightSplitD2 right_split_d2(Static<WithoutInitialization>::SINGLETON);
 
-        left(a) = x.as_derived().template el<0>()(a);
-        right(a) = x.as_derived().template el<1>()(a);
-
-        left_d2(a) = m_left.D2_function(left)(a);
-        right_d2(a) = m_right.D2_function(right)(a);
-
         left_split_d2(a*b*c) = left_d2(a*d).split(d,b*c);
         right_split_d2(a*b*c) = right_d2(a*d).split(d,b*c);
 
-        for (int i = 0; i < DimensionOf_f<CoDomain>::V; ++i)
+        for (Uint32 i = 0; i < DimensionOf_f<CoDomain>::V; ++i)
         {
-            for (int j = 0; j < DimensionOf_f<DualOfBasedVectorSpace>::V; ++j)
+            for (Uint32 j = 0; j < DimensionOf_f<DualOfBasedVectorSpace>::V; ++j)
             {
-                for (int k = 0; k < DimensionOf_f<DualOfBasedVectorSpace>::V; ++k)
+                for (Uint32 k = 0; k < DimensionOf_f<DualOfBasedVectorSpace>::V; ++k)
                 {
                     if (i < DimensionOf_f<typename LeftFunctionType_::CoDomain>::V && j < DimensionOf_f<typename LeftFunctionType_::DualOfBasedVectorSpace>::V && k < DimensionOf_f<typename LeftFunctionType_::DualOfBasedVectorSpace>::V)
                     {
@@ -659,11 +812,8 @@ struct FunctionDirectSum_t
             }
         }
         retval(a*b) = tmp(a*c*d).bundle(c*d,Sym2Dual(),b);
-        return retval;
     }
 
-private:
-
     LeftFunctionType_ const &m_left;
     RightFunctionType_ const &m_right;
 };
@@ -689,6 +839,7 @@ struct DiagonalFunction_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
     template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
     Out function (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
@@ -706,11 +857,11 @@ struct DiagonalFunction_t
     D1 D_function (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
     {
         D1 retval(Static<WithoutInitialization>::SINGLETON);
-        for (int i = 0; i < DimensionOf_f<CoDomain>::V; ++i)
+        for (Uint32 i = 0; i < DimensionOf_f<CoDomain>::V; ++i)
         {
-            for (int j = 0; j < DimensionOf_f<DualOfBasedVectorSpace>::V; ++j)
+            for (Uint32 j = 0; j < DimensionOf_f<DualOfBasedVectorSpace>::V; ++j)
             {
-                if (i == j || i - DimensionOf_f<DualOfBasedVectorSpace>::V == j)
+                if (i == j || i == j + DimensionOf_f<DualOfBasedVectorSpace>::V)
                 {
                     retval[typename D1::MultiIndex(i,j,CheckRange::FALSE)] = Scalar(1);
                 }
@@ -728,6 +879,13 @@ struct DiagonalFunction_t
     {
         return D2(fill_with(0));
     }
+
+    // the derivatives are constant, so there's nothing to share
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        return Jet(function(x), D_function(x), D2_function(x));
+    }
 };
 
 
@@ -750,6 +908,7 @@ struct IdentityFunction_t
     typedef typename FunctionObjectType::Out Out;
     typedef typename FunctionObjectType::D1 D1;
     typedef typename FunctionObjectType::D2 D2;
+    typedef typename FunctionObjectType::Jet Jet;
 
     IdentityFunction_t ()
         :
@@ -782,6 +941,12 @@ struct IdentityFunction_t
         return D2(FillWith_t<Scalar_>(0));
     }
 
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Jet evaluate_jet (Vector_i<Derived_,Scalar,Domain,COMPONENT_QUALIFIER_> const &x) const
+    {
+        return Jet(x.as_derived(), m_D1, D2(FillWith_t<Scalar_>(0)));
+    }
+
 private:
 
     D1 m_D1;
@@ -8,6 +8,8 @@
 
 #include "tenh/core.hpp"
 
+#include <algorithm>
+
 #include "tenh/conceptual/symmetricpower.hpp"
 #include "tenh/conceptual/tensorproduct.hpp"
 #include "tenh/conceptual/vectorspace.hpp"
@@ -19,6 +21,216 @@
 
 namespace Tenh {
 
+// for each component of the packed storage of Sym^DEGREE_(BasedVectorSpace_), this
+// holds the (nonincreasing) factor indices of the corresponding monomial and the
+// number of distinct orderings of those indices, DEGREE_!/multiplicity.  the
+// coefficient of a monomial in a HomogeneousPolynomial is the packed coefficient
+// times its ordering count.  the table is computed once per type.
+template <Uint32 DEGREE_, typename BasedVectorSpace_>
+struct HomogeneousPolynomialMonomialTable_t
+{
+    static_assert(DEGREE_ > 0, "DEGREE_ must be positive");
+    typedef SymmetricPowerOfBasedVectorSpace_c<DEGREE_,BasedVectorSpace_> SymmetricPower;
+    static Uint32 const DIMENSION = DimensionOf_f<SymmetricPower>::V;
+    static Uint32 const FACTOR_DIMENSION = DimensionOf_f<BasedVectorSpace_>::V;
+
+    static HomogeneousPolynomialMonomialTable_t const &instance ()
+    {
+        static HomogeneousPolynomialMonomialTable_t const INSTANCE;
+        return INSTANCE;
+    }
+
+    Uint32 const *factor_indices (Uint32 component) const
+    {
+        assert(component < DIMENSION);
+        return m_factor_index[component];
+    }
+    Uint32 ordering_count (Uint32 component) const
+    {
+        assert(component < DIMENSION);
+        return m_ordering_count[component];
+    }
+    // index_offsets(p)[n] is the number of components of Sym^(DEGREE_-p) of the
+    // first n variables, i.e. where the block of components whose p-th factor
+    // index is n begins, relative to the block for the preceding factor indices.
+    Uint32 const *index_offsets (Uint32 p) const
+    {
+        assert(p < DEGREE_);
+        return m_index_offset[p];
+    }
+    // inverse of factor_indices; the indices must be nonincreasing.  this is the
+    // combinatorial number system used by the Sym implementation, with the
+    // binomial coefficients looked up instead of computed.
+    Uint32 packed_index_of (Uint32 const *nonincreasing_factor_indices) const
+    {
+        Uint32 retval = 0;
+        for (Uint32 p = 0; p < DEGREE_; ++p)
+        {
+            assert(p == 0 || nonincreasing_factor_indices[p] <= nonincreasing_factor_indices[p-1]);
+            retval += m_index_offset[p][nonincreasing_factor_indices[p]];
+        }
+        return retval;
+    }
+
+private:
+
+    typedef ImplementationOf_t<SymmetricPower,Uint32> Sym;
+
+    HomogeneousPolynomialMonomialTable_t ()
+    {
+        for (Uint32 p = 0; p < DEGREE_; ++p)
+            for (Uint32 n = 0; n < FACTOR_DIMENSION; ++n)
+                m_index_offset[p][n] = binomial_coefficient(n + DEGREE_ - 1 - p, DEGREE_ - p);
+
+        for (typename Sym::ComponentIndex it; it.is_not_at_end(); ++it)
+        {
+            // bundle_index_map produces the nonincreasing ordering
+            typename Sym::MultiIndex m = Sym::template bundle_index_map<typename Sym::MultiIndex::IndexTyple, typename Sym::ComponentIndex>(it);
+            for (Uint32 p = 0; p < DEGREE_; ++p)
+                m_factor_index[it.value()][p] = m.value_of_index(p, CheckRange::FALSE);
+            m_ordering_count[it.value()] = Factorial_t<DEGREE_>::V / MultiIndexMultiplicity_t<typename Sym::MultiIndex>::eval(m);
+            assert(packed_index_of(m_factor_index[it.value()]) == it.value());
+        }
+    }
+
+    Uint32 m_factor_index[DIMENSION][DEGREE_];
+    Uint32 m_ordering_count[DIMENSION];
+    Uint32 m_index_offset[DEGREE_][FACTOR_DIMENSION];
+};
+
+// accumulates the terms of a HomogeneousPolynomial whose leading factor indices
+// are fixed, given the product of the variables for those indices.  the packed
+// components are ordered so that the block for each leading factor index is
+// contiguous, so each monomial is formed with one multiply from that of its block
+// (multivariate Horner's method, without the factoring-out, so that the terms are
+// formed and summed in the same order as contracting with the outer power would).
+template <Uint32 DEGREE_, Uint32 REMAINING_DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+struct HomogeneousPolynomialEvaluator_t
+{
+    typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> Table;
+
+    static void accumulate (Table const &table,
+                            Scalar_ const *coefficients,
+                            Uint32 component,
+                            Scalar_ const *x,
+                            Uint32 variable_count,
+                            Scalar_ const &leading_product,
+                            Scalar_ &sum)
+    {
+        Uint32 const *index_offsets = table.index_offsets(DEGREE_ - REMAINING_DEGREE_);
+        for (Uint32 n = 0; n < variable_count; ++n)
+        {
+            HomogeneousPolynomialEvaluator_t<DEGREE_,REMAINING_DEGREE_-1,BasedVectorSpace_,Scalar_>
+                ::accumulate(table, coefficients, component + index_offsets[n], x, n + 1, leading_product * x[n], sum);
+        }
+    }
+};
+
+template <Uint32 DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+struct HomogeneousPolynomialEvaluator_t<DEGREE_,0,BasedVectorSpace_,Scalar_>
+{
+    typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> Table;
+
+    static void accumulate (Table const &table,
+                            Scalar_ const *coefficients,
+                            Uint32 component,
+                            Scalar_ const *x,
+                            Uint32 variable_count,
+                            Scalar_ const &monomial,
+                            Scalar_ &sum)
+    {
+        sum += coefficients[component] * (monomial * static_cast<Scalar_>(table.ordering_count(component)));
+    }
+};
+
+// the batch version of HomogeneousPolynomialEvaluator_t, which evaluates at a
+// chunk of up to CHUNK_SIZE points given in structure-of-arrays form
+// (x[i][p] is the ith coordinate of the pth point).  the loops over the points
+// are innermost, so that they can be vectorized.  if gradients is non-null, the
+// partial derivatives are also accumulated, using the sum of the terms below each
+// node of the recursion (suffix_sum); the partial derivative for the edge to
+// the child for factor index n is leading_product * suffix_sum(child).
+template <Uint32 DEGREE_, Uint32 REMAINING_DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+struct HomogeneousPolynomialBatchEvaluator_t
+{
+    typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> Table;
+    static Uint32 const CHUNK_SIZE = 64;
+    // how many Scalar_s of scratch space accumulate needs
+    static Uint32 const SCRATCH_SIZE = 2*CHUNK_SIZE*REMAINING_DEGREE_;
+
+    static void accumulate (Table const &table,
+                            Scalar_ const *coefficients,
+                            Uint32 component,
+                            Scalar_ const *const *x,
+                            Uint32 variable_count,
+                            Uint32 point_count,
+                            Scalar_ const *leading_product,
+                            Scalar_ *values,
+                            Scalar_ *const *gradients,
+                            Scalar_ *suffix_sum,
+                            Scalar_ *scratch)
+    {
+        assert(point_count <= CHUNK_SIZE);
+        Uint32 const *index_offsets = table.index_offsets(DEGREE_ - REMAINING_DEGREE_);
+        Scalar_ *child_leading_product = scratch;
+        Scalar_ *child_suffix_sum = scratch + CHUNK_SIZE;
+        if (gradients != nullptr)
+            for (Uint32 p = 0; p < point_count; ++p)
+                suffix_sum[p] = Scalar_(0);
+        for (Uint32 n = 0; n < variable_count; ++n)
+        {
+            Scalar_ const *x_n = x[n];
+            for (Uint32 p = 0; p < point_count; ++p)
+                child_leading_product[p] = leading_product[p] * x_n[p];
+            HomogeneousPolynomialBatchEvaluator_t<DEGREE_,REMAINING_DEGREE_-1,BasedVectorSpace_,Scalar_>
+                ::accumulate(table, coefficients, component + index_offsets[n], x, n + 1, point_count,
+                             child_leading_product, values, gradients, child_suffix_sum, scratch + 2*CHUNK_SIZE);
+            if (gradients != nullptr)
+            {
+                Scalar_ *gradient_n = gradients[n];
+                for (Uint32 p = 0; p < point_count; ++p)
+                {
+                    suffix_sum[p] += x_n[p] * child_suffix_sum[p];
+                    gradient_n[p] += leading_product[p] * child_suffix_sum[p];
+                }
+            }
+        }
+    }
+};
+
+template <Uint32 DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+struct HomogeneousPolynomialBatchEvaluator_t<DEGREE_,0,BasedVectorSpace_,Scalar_>
+{
+    typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> Table;
+    static Uint32 const CHUNK_SIZE = 64;
+    static Uint32 const SCRATCH_SIZE = 0;
+
+    static void accumulate (Table const &table,
+                            Scalar_ const *coefficients,
+                            Uint32 component,
+                            Scalar_ const *const *x,
+                            Uint32 variable_count,
+                            Uint32 point_count,
+                            Scalar_ const *monomial,
+                            Scalar_ *values,
+                            Scalar_ *const *gradients,
+                            Scalar_ *suffix_sum,
+                            Scalar_ *scratch)
+    {
+        Scalar_ coefficient(coefficients[component]);
+        Scalar_ ordering_count(static_cast<Scalar_>(table.ordering_count(component)));
+        // same order of operations as HomogeneousPolynomialEvaluator_t
+        for (Uint32 p = 0; p < point_count; ++p)
+            values[p] += coefficient * (monomial[p] * ordering_count);
+        if (gradients != nullptr)
+        {
+            Scalar_ weighted_coefficient(coefficient * ordering_count);
+            for (Uint32 p = 0; p < point_count; ++p)
+                suffix_sum[p] = weighted_coefficient;
+        }
+    }
+};
+
 template <Uint32 DEGREE_, typename BasedVectorSpace_, typename Scalar_ = float>
 struct HomogeneousPolynomial
 {
@@ -40,10 +252,52 @@ struct HomogeneousPolynomial
     HomogeneousPolynomial (SymDual const &term) : m_coefficients(term) { }
     HomogeneousPolynomial (HomogeneousPolynomial const &other) : m_coefficients(other.m_coefficients) { }
 
+    // the monomials are formed incrementally in packed order, with no decoding of
+    // the packed index; this costs a few multiplies per coefficient.
     Scalar_ evaluate (Vector const &at) const
     {
-        AbstractIndex_c<'i'> i;
-        return m_coefficients(i)*outer_power_of(at)(i);
+        typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> Table;
+        Scalar_ x[Vector::DIM];
+        for (typename Vector::ComponentIndex it; it.is_not_at_end(); ++it)
+            x[it.value()] = at[it];
+        Scalar_ retval(0);
+        HomogeneousPolynomialEvaluator_t<DEGREE_,DEGREE_,BasedVectorSpace_,Scalar_>
+            ::accumulate(Table::instance(), as_array().pointer_to_allocation(), 0, x, Vector::DIM, Scalar_(1), retval);
+        return retval;
+    }
+
+    static Uint32 const BATCH_CHUNK_SIZE = HomogeneousPolynomialBatchEvaluator_t<DEGREE_,DEGREE_,BasedVectorSpace_,Scalar_>::CHUNK_SIZE;
+
+    // evaluates at point_count points given in structure-of-arrays form, i.e.
+    // coordinates[i][p] is the ith coordinate of the pth point, and stores the
+    // value at the pth point in values[p].  if gradients is non-null, the ith
+    // partial derivative at the pth point is stored in gradients[i][p].  the
+    // values are identical to those of evaluate.
+    void evaluate_batch (Scalar_ const *const *coordinates,
+                         Uint32 point_count,
+                         Scalar_ *values,
+                         Scalar_ *const *gradients = nullptr) const
+    {
+        if (gradients != nullptr)
+            for (Uint32 i = 0; i < Vector::DIM; ++i)
+                for (Uint32 p = 0; p < point_count; ++p)
+                    gradients[i][p] = Scalar_(0);
+
+        Scalar_ const *x[Vector::DIM];
+        Scalar_ *g[Vector::DIM];
+        for (Uint32 start = 0; start < point_count; start += BATCH_CHUNK_SIZE)
+        {
+            for (Uint32 i = 0; i < Vector::DIM; ++i)
+            {
+                x[i] = coordinates[i] + start;
+                if (gradients != nullptr)
+                    g[i] = gradients[i] + start;
+            }
+            evaluate_batch_chunk(x,
+                                 std::min(BATCH_CHUNK_SIZE, point_count - start),
+                                 values + start,
+                                 (gradients != nullptr) ? g : nullptr);
+        }
     }
 
     // Member operators
@@ -77,33 +331,55 @@ struct HomogeneousPolynomial
         operator * (HomogeneousPolynomial<OTHER_DEGREE_,BasedVectorSpace_,Scalar_> const &rhs) const
     {
         typedef HomogeneousPolynomial<OTHER_DEGREE_ + DEGREE_,BasedVectorSpace_,Scalar_> ResultPolynomial;
-        typedef typename ResultPolynomial::SymDual ResultSymDual;
-        typedef typename ResultSymDual::MultiIndex ResultMultiIndex;
-        typedef typename ResultSymDual::ComponentIndex ResultComponentIndex;
-        typedef typename TensorPowerOfBasedVectorSpace_f<OTHER_DEGREE_ + DEGREE_,typename DualOf_f<BasedVectorSpace_>::T>::T ResultingTensorPowerType;
-
-        typedef typename Sym_f<OTHER_DEGREE_ + DEGREE_,typename DualOf_f<BasedVectorSpace_>::T,Scalar_>::T SymmetrizeType;
-
-        ResultPolynomial result(Static<WithoutInitialization>::SINGLETON);
-        SymmetrizeType symmetrize;
-
-        AbstractIndex_c<'i'> i;
-        AbstractIndex_c<'j'> j;
-        AbstractIndex_c<'k'> k;
-        AbstractIndex_c<'I'> I;
-        AbstractIndex_c<'J'> J;
-        AbstractIndex_c<'K'> K;
-
-        result.m_coefficients(i) = (m_coefficients(j).split(j,J)*rhs.m_coefficients(k).split(k,K))
-                                   .bundle_with_no_type_check(J*K,ResultingTensorPowerType(),I)*symmetrize(i*I);
-
-        for (ResultComponentIndex it; it.is_not_at_end(); ++it)
+        typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> LhsTable;
+        typedef HomogeneousPolynomialMonomialTable_t<OTHER_DEGREE_,BasedVectorSpace_> RhsTable;
+        typedef HomogeneousPolynomialMonomialTable_t<OTHER_DEGREE_ + DEGREE_,BasedVectorSpace_> ResultTable;
+        typedef typename SymDual::ComponentIndex LhsComponentIndex;
+        typedef typename HomogeneousPolynomial<OTHER_DEGREE_,BasedVectorSpace_,Scalar_>::SymDual::ComponentIndex RhsComponentIndex;
+        typedef typename ResultPolynomial::SymDual::ComponentIndex ResultComponentIndex;
+
+        LhsTable const &lhs_table = LhsTable::instance();
+        RhsTable const &rhs_table = RhsTable::instance();
+        ResultTable const &result_table = ResultTable::instance();
+
+        // the product is formed in terms of monomial coefficients (packed coefficient
+        // times ordering count), which simply multiply; each pair of packed components
+        // contributes to the component whose factor indices are the merge of theirs.
+        Scalar_ rhs_monomial_coefficient[RhsTable::DIMENSION];
+        for (Uint32 k = 0; k < RhsTable::DIMENSION; ++k)
+            rhs_monomial_coefficient[k] = rhs.m_coefficients[RhsComponentIndex(k, CheckRange::FALSE)]
+                                          * static_cast<Scalar_>(rhs_table.ordering_count(k));
+
+        ResultPolynomial result(fill_with(0));
+        Uint32 merged[OTHER_DEGREE_ + DEGREE_];
+        for (Uint32 k1 = 0; k1 < LhsTable::DIMENSION; ++k1)
         {
-            ResultMultiIndex m = ResultSymDual::template bundle_index_map<typename ResultMultiIndex::IndexTyple, ResultComponentIndex>(it);
-            result.m_coefficients[it] *= static_cast<Scalar_>(MultiIndexMultiplicity_t<ResultMultiIndex>::eval(m))
-                                         / static_cast<Scalar_>(Factorial_t<OTHER_DEGREE_ + DEGREE_>::V);
+            Uint32 const *lhs_factors = lhs_table.factor_indices(k1);
+            Scalar_ lhs_monomial_coefficient = m_coefficients[LhsComponentIndex(k1, CheckRange::FALSE)]
+                                               * static_cast<Scalar_>(lhs_table.ordering_count(k1));
+            for (Uint32 k2 = 0; k2 < RhsTable::DIMENSION; ++k2)
+            {
+                Uint32 const *rhs_factors = rhs_table.factor_indices(k2);
+                // merge the two nonincreasing sequences of factor indices
+                Uint32 a = 0;
+                Uint32 b = 0;
+                for (Uint32 p = 0; p < OTHER_DEGREE_ + DEGREE_; ++p)
+                {
+                    if (b == OTHER_DEGREE_ || (a < DEGREE_ && lhs_factors[a] >= rhs_factors[b]))
+                        merged[p] = lhs_factors[a++];
+                    else
+                        merged[p] = rhs_factors[b++];
+                }
+
+                result.m_coefficients[ResultComponentIndex(result_table.packed_index_of(merged), CheckRange::FALSE)]
+                    += lhs_monomial_coefficient * rhs_monomial_coefficient[k2];
+            }
         }
 
+        // convert the monomial coefficients back to packed coefficients
+        for (ResultComponentIndex it; it.is_not_at_end(); ++it)
+            result.m_coefficients[it] /= static_cast<Scalar_>(result_table.ordering_count(it.value()));
+
         return result;
     }
 
@@ -141,26 +417,33 @@ struct HomogeneousPolynomial
 private:
     SymDual m_coefficients;
 
-    // This should probably be a function in tensor heaven somewhere.
-    Sym outer_power_of (Vector const &input) const
+    // evaluates at up to BATCH_CHUNK_SIZE points, storing the values and adding
+    // the partial derivatives (if gradients is non-null) to gradients.
+    void evaluate_batch_chunk (Scalar_ const *const *x, Uint32 point_count, Scalar_ *values, Scalar_ *const *gradients) const
     {
-        Sym result(fill_with(1));
-
-        for (typename Sym::ComponentIndex it; it.is_not_at_end(); ++it)
+        typedef HomogeneousPolynomialMonomialTable_t<DEGREE_,BasedVectorSpace_> Table;
+        typedef HomogeneousPolynomialBatchEvaluator_t<DEGREE_,DEGREE_,BasedVectorSpace_,Scalar_> BatchEvaluator;
+        assert(point_count <= BATCH_CHUNK_SIZE);
+        Scalar_ ones[BATCH_CHUNK_SIZE];
+        Scalar_ suffix_sum[BATCH_CHUNK_SIZE];
+        Scalar_ scratch[BatchEvaluator::SCRATCH_SIZE];
+        for (Uint32 p = 0; p < point_count; ++p)
         {
-            typename Sym::MultiIndex m = Sym::template bundle_index_map<typename Sym::MultiIndex::IndexTyple, typename Sym::ComponentIndex>(it);
-            for (Uint32 i = 0; i < Sym::MultiIndex::LENGTH; ++i)
-            {
-                result[it] *= input[typename Vector::ComponentIndex(m.value_of_index(i, CheckRange::FALSE))];
-            }
-            result[it] *= Factorial_t<DEGREE_>::V / (MultiIndexMultiplicity_t<typename Sym::MultiIndex>::eval(m));
+            ones[p] = Scalar_(1);
+            values[p] = Scalar_(0);
         }
-        return result;
+        BatchEvaluator::accumulate(Table::instance(), as_array().pointer_to_allocation(), 0, x, Vector::DIM, point_count,
+                                   ones, values, gradients, suffix_sum, scratch);
     }
 
     template<Uint32,typename,typename> friend struct HomogeneousPolynomial;
+    template<Uint32,typename,typename> friend struct MultivariatePolynomial;
 };
 
+// the definition is needed because std::min takes BATCH_CHUNK_SIZE by reference
+template <Uint32 DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+Uint32 const HomogeneousPolynomial<DEGREE_,BasedVectorSpace_,Scalar_>::BATCH_CHUNK_SIZE;
+
 
 // Non-member operator overloads. These exist because they must be partially specalized, or because they cannot be written as member operator overloads.
 //    scalar operator +
@@ -14,18 +14,65 @@
 #include <cmath>
 #endif
 
+#include <algorithm>
+#include <chrono>
 #include <iostream>
+#include <limits>
+#include <random>
+#include <thread>
+#include <vector>
 
 #include "tenh/implementation/innerproduct.hpp"
 #include "tenh/implementation/vector.hpp"
 #include "tenh/implementation/vee.hpp"
-#include "tenh/interop/eigen_invert.hpp"
-#include "tenh/interop/eigen_svd.hpp"
+#include "tenh/reduction.hpp"
 
 static bool const PRINT_DEBUG_OUTPUT = true;
 
+// MSVC before 2015 doesn't support thread_local, but __declspec(thread) works for plain data.
+#if defined(_MSC_VER) && _MSC_VER < 1900
+#define TENH_THREAD_LOCAL __declspec(thread)
+#else
+#define TENH_THREAD_LOCAL thread_local
+#endif
+
+namespace Tenh {
+
+// per-thread switch for the progress output of the optimization methods.  this is a
+// runtime setting (rather than e.g. a macro) so that every translation unit sees the
+// same definitions of the templates which use it.
+inline bool &debug_output_is_suppressed ()
+{
+    static TENH_THREAD_LOCAL bool suppressed = false;
+    return suppressed;
+}
+
+// suppresses the progress output on the current thread for the lifetime of this
+// object, e.g. when timing or testing the optimization methods.
+class DebugOutputSuppression_t
+{
+public:
+
+    explicit DebugOutputSuppression_t (bool suppress)
+        :
+        m_was_suppressed(debug_output_is_suppressed())
+    {
+        debug_output_is_suppressed() = m_was_suppressed || suppress;
+    }
+    ~DebugOutputSuppression_t () { debug_output_is_suppressed() = m_was_suppressed; }
+
+private:
+
+    DebugOutputSuppression_t (DebugOutputSuppression_t const &);
+    void operator = (DebugOutputSuppression_t const &);
+
+    bool m_was_suppressed;
+};
+
+} // end of namespace Tenh
+
 #define DEBUG_OUTPUT(x) \
-if (PRINT_DEBUG_OUTPUT) \
+if (PRINT_DEBUG_OUTPUT && !Tenh::debug_output_is_suppressed()) \
 { \
     std::cerr << x; \
 }
@@ -65,6 +112,39 @@ inline bool isNaN(long double const &x)
 #endif
 }
 
+template <typename T>
+bool isFinite(T const &x)
+{
+    return true;
+}
+
+inline bool isFinite(float const &x)
+{
+#if _WIN32
+    return _finite(x) != 0;
+#else
+    return std::isfinite(x);
+#endif
+}
+
+inline bool isFinite(double const &x)
+{
+#if _WIN32
+    return _finite(x) != 0;
+#else
+    return std::isfinite(x);
+#endif
+}
+
+inline bool isFinite(long double const &x)
+{
+#if _WIN32
+    return _finite(x) != 0;
+#else
+    return std::isfinite(x);
+#endif
+}
+
 // ///////////////////////////////////////////////////////////////////////////
 // line searches
 // ///////////////////////////////////////////////////////////////////////////
@@ -137,12 +217,12 @@ bool uniform_step (ObjectiveFunction_ const &f,
 
     V current_position(position);
     V next_position(position);
+    Scalar_ current_value(f.function(current_position));
     for (Uint32 step_count = 0; step_count < substep_count; ++step_count)
     {
         next_position(i).no_alias() += partial_step(i);
         // first, check if the next value is bigger than the current value.
         // if it is, then bisect
-        Scalar_ current_value(f.function(current_position));
         Scalar_ next_value(f.function(next_position));
         if (next_value >= current_value)
         {
@@ -162,6 +242,7 @@ bool uniform_step (ObjectiveFunction_ const &f,
             }
         }
         current_position(i).no_alias() = next_position(i);
+        current_value = next_value;
     }
 
     // all steps decreased, so set the final step position and return with success
@@ -170,38 +251,335 @@ bool uniform_step (ObjectiveFunction_ const &f,
     return true;
 }
 
+// returns the minimizer of the cubic which interpolates the values and slopes of
+// a function at a and b (see Nocedal and Wright, "Numerical Optimization", (3.59)).
+// if the cubic has no minimizer, or it isn't safely inside the interval between a
+// and b (i.e. away from the endpoints by a tenth of the interval's length), the
+// midpoint is returned instead.
+template <typename Scalar_>
+Scalar_ cubic_interpolation_minimizer (Scalar_ a, Scalar_ value_a, Scalar_ slope_a,
+                                       Scalar_ b, Scalar_ value_b, Scalar_ slope_b)
+{
+    Scalar_ midpoint = (a + b) / 2;
+    Scalar_ margin = std::abs(b - a) / 10;
+    Scalar_ d1 = slope_a + slope_b - Scalar_(3) * (value_a - value_b) / (a - b);
+    Scalar_ discriminant = d1*d1 - slope_a*slope_b;
+    // this form of the comparison also catches NaN
+    if (!(discriminant >= Scalar_(0)))
+        return midpoint;
+    Scalar_ d2 = (b > a ? Scalar_(1) : Scalar_(-1)) * std::sqrt(discriminant);
+    Scalar_ t = b - (b - a) * (slope_b + d2 - d1) / (slope_b - slope_a + Scalar_(2)*d2);
+    if (!(t >= std::min(a, b) + margin && t <= std::max(a, b) - margin))
+        return midpoint;
+    return t;
+}
+
+// searches along step for a position satisfying the strong Wolfe conditions
+//     f(position + t*step) <= f(position) + sufficient_decrease_factor*t*slope(0),
+//     |slope(t)| <= curvature_factor*|slope(0)|,
+// where slope(t) is the derivative of f(position + t*step) with respect to t,
+// starting with t = 1 (which is the natural choice for Newton and quasi-Newton
+// steps).  the step length is doubled until an interval containing acceptable
+// step lengths is bracketed, which is then narrowed using cubic interpolation
+// (see Nocedal and Wright, "Numerical Optimization", algorithms 3.5 and 3.6).
+// value and gradient must be f and its differential at position on entry, and are
+// reused, so each trial costs one evaluation of each of f.function and f.D_function.
+// on success, position, value and gradient are updated to the accepted position.
+// if max_iteration_count is exceeded, the best position found which satisfies the
+// sufficient decrease condition is used.  the return value is false (and position
+// is unchanged) iff step isn't a descent direction or no such position was found.
+template <typename ObjectiveFunction_,
+          typename Derived1_,
+          typename Derived2_,
+          typename Derived3_,
+          typename Scalar_,
+          typename BasedVectorSpace_,
+          ComponentQualifier COMPONENT_QUALIFIER_>
+bool strong_wolfe_step (ObjectiveFunction_ const &f,
+                        Vector_i<Derived1_,Scalar_,BasedVectorSpace_,ComponentQualifier::NONCONST_MEMORY> &position,
+                        Vector_i<Derived2_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &step,
+                        Scalar_ &value,
+                        Vector_i<Derived3_,Scalar_,typename DualOf_f<BasedVectorSpace_>::T,ComponentQualifier::NONCONST_MEMORY> &gradient,
+                        Scalar_ sufficient_decrease_factor = Scalar_(1e-4),
+                        Scalar_ curvature_factor = Scalar_(0.9),
+                        Uint32 max_iteration_count = 20)
+{
+    assert(Scalar_(0) < sufficient_decrease_factor && sufficient_decrease_factor < curvature_factor && curvature_factor < Scalar_(1) &&
+           "must have 0 < sufficient_decrease_factor < curvature_factor < 1");
+    assert(max_iteration_count > 0 && "max_iteration_count must be positive");
+    typedef ImplementationOf_t<BasedVectorSpace_,Scalar_> V;
+    typedef ImplementationOf_t<typename DualOf_f<BasedVectorSpace_>::T,Scalar_> CoV;
+    static Scalar_ const EXPANSION_FACTOR = Scalar_(2);
+    AbstractIndex_c<'i'> i;
+
+    Scalar_ initial_value = value;
+    Scalar_ initial_slope = gradient(i)*step(i);
+    if (!(initial_slope < Scalar_(0)))
+    {
+        DEBUG_OUTPUT("    LineSearch::strong_wolfe_step failed; step is not a descent direction (slope = " << initial_slope << ")\n");
+        return false;
+    }
+
+    // [lo,hi] is the bracketing interval once bracketed is true (though hi may be
+    // less than lo).  lo is always the best step length found which satisfies the
+    // sufficient decrease condition (or is 0 if none has been found yet).
+    Scalar_ lo(0);
+    Scalar_ value_lo(initial_value);
+    Scalar_ slope_lo(initial_slope);
+    Scalar_ hi(0);
+    Scalar_ value_hi(0);
+    Scalar_ slope_hi(0);
+    bool bracketed = false;
+    Scalar_ t(1);
+
+    V trial_position(Static<WithoutInitialization>::SINGLETON);
+    CoV trial_gradient(Static<WithoutInitialization>::SINGLETON);
+    for (Uint32 iteration_count = 0; iteration_count < max_iteration_count; ++iteration_count)
+    {
+        if (bracketed)
+        {
+            // stop if the interval has collapsed (to within roundoff)
+            if (std::abs(hi - lo) <= std::numeric_limits<Scalar_>::epsilon() * std::max(lo, hi))
+                break;
+            t = cubic_interpolation_minimizer(lo, value_lo, slope_lo, hi, value_hi, slope_hi);
+        }
+
+        trial_position(i).no_alias() = position(i) + t * step(i);
+        Scalar_ trial_value(f.function(trial_position));
+        trial_gradient = f.D_function(trial_position);
+        Scalar_ trial_slope = trial_gradient(i)*step(i);
+        DEBUG_OUTPUT(   "    LineSearch::strong_wolfe_step; for t = " << t << ", function value is " << trial_value
+                     << " and slope is " << trial_slope << '\n');
+
+        if (trial_value > initial_value + sufficient_decrease_factor * t * initial_slope || trial_value >= value_lo)
+        {
+            // insufficient decrease, so t bounds the acceptable step lengths
+            hi = t;
+            value_hi = trial_value;
+            slope_hi = trial_slope;
+            bracketed = true;
+        }
+        else
+        {
+            if (std::abs(trial_slope) <= -curvature_factor * initial_slope)
+            {
+                DEBUG_OUTPUT("    LineSearch::strong_wolfe_step succeeded on iteration " << iteration_count << " with t = " << t << '\n');
+                position(i).no_alias() = trial_position(i);
+                value = trial_value;
+                gradient(i).no_alias() = trial_gradient(i);
+                return true;
+            }
+            // if the function is increasing from t toward hi (or from t onward, if
+            // not yet bracketed), then [t,lo] brackets acceptable step lengths.
+            if (bracketed ? trial_slope * (hi - lo) >= Scalar_(0) : trial_slope >= Scalar_(0))
+            {
+                hi = lo;
+                value_hi = value_lo;
+                slope_hi = slope_lo;
+                bracketed = true;
+            }
+            lo = t;
+            value_lo = trial_value;
+            slope_lo = trial_slope;
+            if (!bracketed)
+                t *= EXPANSION_FACTOR;
+        }
+    }
+
+    if (lo > Scalar_(0))
+    {
+        DEBUG_OUTPUT("    LineSearch::strong_wolfe_step using sufficient decrease only, with t = " << lo << '\n');
+        position(i).no_alias() += lo * step(i);
+        value = value_lo;
+        trial_gradient = f.D_function(position);
+        gradient(i).no_alias() = trial_gradient(i);
+        return true;
+    }
+
+    DEBUG_OUTPUT("    LineSearch::strong_wolfe_step failed after " << max_iteration_count << " iterations\n");
+    return false;
+}
+
 }
 
 // ///////////////////////////////////////////////////////////////////////////
 // optimization methods
 // ///////////////////////////////////////////////////////////////////////////
 
+// selects the line search used by minimize.  UNIFORM_STEP walks along the step in
+// equal substeps for as long as the function decreases (falling back to
+// LineSearch::geometric_step), while STRONG_WOLFE uses LineSearch::strong_wolfe_step,
+// which needs far fewer function evaluations and reuses the function value and
+// gradient at the accepted position for the next iteration.
+enum class LineSearchMethod { UNIFORM_STEP, STRONG_WOLFE };
+
+// the kinds of step that minimize takes; NONE means that no step was taken.
+enum class MinimizationStepType { NONE, NEWTONS_METHOD, CONJUGATE_GRADIENT, GRADIENT_DESCENT };
+
+// the tuning parameters of minimize.  the defaults are the values that minimize
+// has always used.
+template <typename Scalar_>
+struct MinimizationParameters_t
+{
+    MinimizationParameters_t ()
+        :
+        max_iteration_count(20),
+        line_search_method(LineSearchMethod::UNIFORM_STEP),
+        uniform_step_substep_count(50),
+        geometric_step_factor(0.5),
+        geometric_step_max_iteration_count(10),
+        sufficient_decrease_factor(1e-4),
+        curvature_factor(0.9),
+        strong_wolfe_max_iteration_count(20),
+        step_scale(1),
+        max_step_size(-1),
+        gradient_descent_step_size(0.25),
+        epsilon(1e-10)
+    { }
+
+    Uint32 max_iteration_count;
+    LineSearchMethod line_search_method;
+    // used by LineSearchMethod::UNIFORM_STEP
+    Uint32 uniform_step_substep_count;
+    Scalar_ geometric_step_factor;
+    Uint32 geometric_step_max_iteration_count;
+    // used by LineSearchMethod::STRONG_WOLFE
+    Scalar_ sufficient_decrease_factor;
+    Scalar_ curvature_factor;
+    Uint32 strong_wolfe_max_iteration_count;
+    // each step is multiplied by step_scale, and then if max_step_size is positive,
+    // steps longer than it are shortened to it.
+    Scalar_ step_scale;
+    Scalar_ max_step_size;
+    // the length of gradient descent steps
+    Scalar_ gradient_descent_step_size;
+    // the threshold below which the Hessian is not considered to be positive definite
+    Scalar_ epsilon;
+};
+
+// what minimize did, for diagnosing and tuning it.  the times are wall-clock seconds
+// spent in the objective function's function, D_function and D2_function.
+template <typename Scalar_>
+struct MinimizationStatistics_t
+{
+    MinimizationStatistics_t ()
+        :
+        iteration_count(0),
+        function_evaluation_count(0),
+        gradient_evaluation_count(0),
+        hessian_evaluation_count(0),
+        function_evaluation_seconds(0),
+        gradient_evaluation_seconds(0),
+        hessian_evaluation_seconds(0),
+        total_seconds(0),
+        newtons_method_step_count(0),
+        conjugate_gradient_step_count(0),
+        gradient_descent_step_count(0),
+        last_step_type(MinimizationStepType::NONE),
+        final_value(0),
+        final_gradient_norm(0),
+        tolerance_was_attained(false)
+    { }
+
+    Uint32 iteration_count;
+    Uint32 function_evaluation_count;
+    Uint32 gradient_evaluation_count;
+    Uint32 hessian_evaluation_count;
+    double function_evaluation_seconds;
+    double gradient_evaluation_seconds;
+    double hessian_evaluation_seconds;
+    double total_seconds;
+    Uint32 newtons_method_step_count;
+    Uint32 conjugate_gradient_step_count;
+    Uint32 gradient_descent_step_count;
+    MinimizationStepType last_step_type;
+    Scalar_ final_value;
+    Scalar_ final_gradient_norm;
+    bool tolerance_was_attained;
+};
+
+// forwards to an objective function, and if statistics is not null, counts and
+// times the calls to each of its methods.
+template <typename ObjectiveFunction_, typename Scalar_>
+struct ProfiledObjectiveFunction_t
+{
+    typedef std::chrono::steady_clock Clock;
+
+    ProfiledObjectiveFunction_t (ObjectiveFunction_ const &func, MinimizationStatistics_t<Scalar_> *statistics)
+        :
+        m_func(func),
+        m_statistics(statistics)
+    { }
+
+    template <typename Derived_, typename BasedVectorSpace_, ComponentQualifier COMPONENT_QUALIFIER_>
+    typename ObjectiveFunction_::Out function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        if (m_statistics == nullptr)
+            return m_func.function(x);
+        Clock::time_point start = Clock::now();
+        typename ObjectiveFunction_::Out retval(m_func.function(x));
+        ++m_statistics->function_evaluation_count;
+        m_statistics->function_evaluation_seconds += seconds_since(start);
+        return retval;
+    }
+    template <typename Derived_, typename BasedVectorSpace_, ComponentQualifier COMPONENT_QUALIFIER_>
+    typename ObjectiveFunction_::D1 D_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        if (m_statistics == nullptr)
+            return m_func.D_function(x);
+        Clock::time_point start = Clock::now();
+        typename ObjectiveFunction_::D1 retval(m_func.D_function(x));
+        ++m_statistics->gradient_evaluation_count;
+        m_statistics->gradient_evaluation_seconds += seconds_since(start);
+        return retval;
+    }
+    template <typename Derived_, typename BasedVectorSpace_, ComponentQualifier COMPONENT_QUALIFIER_>
+    typename ObjectiveFunction_::D2 D2_function (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        if (m_statistics == nullptr)
+            return m_func.D2_function(x);
+        Clock::time_point start = Clock::now();
+        typename ObjectiveFunction_::D2 retval(m_func.D2_function(x));
+        ++m_statistics->hessian_evaluation_count;
+        m_statistics->hessian_evaluation_seconds += seconds_since(start);
+        return retval;
+    }
+
+    static double seconds_since (Clock::time_point start)
+    {
+        return std::chrono::duration_cast<std::chrono::duration<double>>(Clock::now() - start).count();
+    }
+
+private:
+
+    ObjectiveFunction_ const &m_func;
+    MinimizationStatistics_t<Scalar_> *m_statistics;
+};
+
 // adaptive minimization which uses, in order of availability/preference,
 // 1. Newton's method, 2. conjugate gradient, and 3. gradient descent.
+// if statistics is not null, it is filled out with what was done.
 template <typename InnerProductId_, typename ObjectiveFunction_, typename BasedVectorSpace_, typename Scalar_, typename GuessUseArrayType_, typename Derived_>
-ImplementationOf_t<BasedVectorSpace_,Scalar_> minimize (ObjectiveFunction_ const &func,
+ImplementationOf_t<BasedVectorSpace_,Scalar_> minimize (ObjectiveFunction_ const &objective_function,
                                                         ImplementationOf_t<BasedVectorSpace_,Scalar_,GuessUseArrayType_,Derived_> const &guess,
                                                         Scalar_ tolerance,
-                                                        Scalar_ *minimum = nullptr)
+                                                        MinimizationParameters_t<Scalar_> const &parameters,
+                                                        MinimizationStatistics_t<Scalar_> *statistics = nullptr)
 {
     typedef ImplementationOf_t<BasedVectorSpace_,Scalar_> VectorType;
     typedef typename InnerProduct_f<BasedVectorSpace_,InnerProductId_,Scalar_>::T VectorInnerProductType;
     typedef ImplementationOf_t<typename DualOf_f<BasedVectorSpace_>::T,Scalar_> CoVectorType;
     typedef typename InnerProduct_f<typename DualOf_f<BasedVectorSpace_>::T,InnerProductId_,Scalar_>::T CoVectorInnerProductType;
     typedef typename ObjectiveFunction_::D2 HessianType;
-    typedef ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<Typle_t<typename DualOf_f<BasedVectorSpace_>::T,
-                                                                          typename DualOf_f<BasedVectorSpace_>::T>>,Scalar_> Hessian2TensorType;
+    typedef ProfiledObjectiveFunction_t<ObjectiveFunction_,Scalar_> ProfiledObjectiveFunction;
     static_assert(TypesAreEqual_f<VectorType,typename ObjectiveFunction_::V>::V, "types must match");
     static_assert(TypesAreEqual_f<Scalar_,typename ObjectiveFunction_::Out>::V, "types must match");
-    static Scalar_ const LINE_SEARCH_GEOMETRIC_STEP_FACTOR = Scalar_(0.5);
-    static Uint32 const LINE_SEARCH_GEOMETRIC_STEP_MAX_ITERATION_COUNT = 10;
-    static int const LINE_SEARCH_UNIFORM_STEP_SUBSTEP_COUNT = 50;
-    static Scalar_ const STEP_SCALE = Scalar_(1);
-    static Scalar_ const MAX_STEP_SIZE = Scalar_(-1);
-    // static Scalar_ const MAX_STEP_SIZE = Scalar_(1);
-    static int const MAX_ITERATION_COUNT = 20;
-    static Scalar_ const GRADIENT_DESCENT_STEP_SIZE = Scalar_(0.25);
-    static Scalar_ const EPSILON = 1e-10;
+    assert(parameters.uniform_step_substep_count > 0 && "uniform_step_substep_count must be positive");
+
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    if (statistics != nullptr)
+        *statistics = MinimizationStatistics_t<Scalar_>();
+    ProfiledObjectiveFunction func(objective_function, statistics);
 
     VectorInnerProductType vector_innerproduct;
     CoVectorInnerProductType covector_innerproduct;
@@ -209,20 +587,22 @@ ImplementationOf_t<BasedVectorSpace_,Scalar_> minimize (ObjectiveFunction_ const
     AbstractIndex_c<'i'> i;
     AbstractIndex_c<'j'> j;
 
-    VectorType current_approximation = guess;
-    int iteration_count = 0;
-    int gradient_descent = 0;
-    int conjugate_gradient = 0;
-    int newtons_method = 0;
-    // bool tolerance_was_attained = false;
+    VectorType current_approximation(guess);
+    Uint32 iteration_count = 0;
+    Uint32 gradient_descent = 0;
+    Uint32 conjugate_gradient = 0;
+    Uint32 newtons_method = 0;
+    MinimizationStepType last_step_type = MinimizationStepType::NONE;
+    bool tolerance_was_attained = false;
 
-    while (iteration_count < MAX_ITERATION_COUNT)
+    Scalar_ current_value = func.function(current_approximation);
+    CoVectorType g = func.D_function(current_approximation);
+    Scalar_ g_norm = std::sqrt(covector_innerproduct(g, g));
+    while (iteration_count < parameters.max_iteration_count)
     {
-        Scalar_ current_value = func.function(current_approximation);
-        CoVectorType g = func.D_function(current_approximation);
         CoVectorType minus_g(Static<WithoutInitialization>::SINGLETON);
         Scalar_ g_squared_norm = covector_innerproduct(g, g);
-        Scalar_ g_norm = std::sqrt(g_squared_norm);
+        g_norm = std::sqrt(g_squared_norm);
         minus_g(i) = -g(i);
 
         DEBUG_OUTPUT(   "minimize: iteration " << iteration_count
@@ -233,76 +613,98 @@ ImplementationOf_t<BasedVectorSpace_,Scalar_> minimize (ObjectiveFunction_ const
 
         if (g_norm <= tolerance)
         {
-            // tolerance_was_attained = true;
-            if (minimum != nullptr)
-                *minimum = current_value;
+            tolerance_was_attained = true;
             break;
         }
 
         HessianType h(func.D2_function(current_approximation));
-        Hessian2TensorType h2(Static<WithoutInitialization>::SINGLETON);
         VectorType step(Static<WithoutInitialization>::SINGLETON);
-        Scalar_ d;
-        h2(i*j) = h.split(i*j);
+        // the packed LDL^T factorization of h fails iff h isn't positive definite
+        // (up to epsilon), in which case the Newton step isn't a descent direction.
+        HessianType ldlt(h);
+        bool h_is_positive_definite = sym2_ldlt_factor(ldlt, parameters.epsilon);
 
-        // TODO; this could be replaced with something that uses symmetry of h
-        SVD_solve(h2,step,minus_g);
-        d = h(step, step);
-
-        if (isNaN(d) || d < EPSILON) // h isn't postive definite along step so fall back to conjugate gradient
+        if (!h_is_positive_definite) // h isn't postive definite so fall back to conjugate gradient
         {
             VectorType v(Static<WithoutInitialization>::SINGLETON);
             v(j).no_alias() = g(i) * covector_innerproduct.split(i*j);
-            d = h(v, v);
+            Scalar_ d = sym2_quadratic_form(h, v);
 
-            if (isNaN(d) || d < EPSILON) // h isn't positive definite along g either, gradient descent
+            if (isNaN(d) || d < parameters.epsilon) // h isn't positive definite along g either, gradient descent
             {
-                step(i).no_alias() = -GRADIENT_DESCENT_STEP_SIZE * g(i) / g_norm;
+                step(i).no_alias() = -parameters.gradient_descent_step_size * g(i) / g_norm;
                 DEBUG_OUTPUT("    Gradient descent; step = " << step << '\n');
                 ++gradient_descent;
+                last_step_type = MinimizationStepType::GRADIENT_DESCENT;
             }
             else // h is positive definite along g, use conjugate gradient
             {
                 step(i).no_alias() = (-g_squared_norm / d) * v(i);
                 DEBUG_OUTPUT("    Conjugate gradient; d = " << d << ", step = " << step << '\n');
                 ++conjugate_gradient;
+                last_step_type = MinimizationStepType::CONJUGATE_GRADIENT;
             }
         }
-        else // h is positive definite along step, use it as is.
+        else // h is positive definite, use the Newton step
         {
+            sym2_ldlt_solve(ldlt, minus_g, step);
             DEBUG_OUTPUT("    Newton's method; step = " << step << '\n');
             ++newtons_method;
+            last_step_type = MinimizationStepType::NEWTONS_METHOD;
         }
 
-        step(i).no_alias() = STEP_SCALE * step(i);
+        step(i).no_alias() = parameters.step_scale * step(i);
 
         Scalar_ step_norm = std::sqrt(vector_innerproduct(step, step)); //std::sqrt(vector_innerproduct.split(i*j)*step(i)*step(j));
 
-        if (MAX_STEP_SIZE > 0 && step_norm > MAX_STEP_SIZE)
+        if (parameters.max_step_size > 0 && step_norm > parameters.max_step_size)
         {
-            DEBUG_OUTPUT("    Clamping step length to " << MAX_STEP_SIZE << '\n');
-            step(i).no_alias() = MAX_STEP_SIZE * step(i) / step_norm;
-            step_norm = MAX_STEP_SIZE;
+            DEBUG_OUTPUT("    Clamping step length to " << parameters.max_step_size << '\n');
+            step(i).no_alias() = parameters.max_step_size * step(i) / step_norm;
+            step_norm = parameters.max_step_size;
         }
 
-        bool line_search_success =
-            LineSearch::uniform_step(func,
-                                     current_approximation,
-                                     step,
-                                     LINE_SEARCH_UNIFORM_STEP_SUBSTEP_COUNT);
-        if (!line_search_success)
+        if (parameters.line_search_method == LineSearchMethod::STRONG_WOLFE)
         {
-            step(i).no_alias() = step(i) / LINE_SEARCH_UNIFORM_STEP_SUBSTEP_COUNT;
-            line_search_success =
-                LineSearch::geometric_step(func,
-                                           current_approximation,
-                                           step,
-                                           LINE_SEARCH_GEOMETRIC_STEP_FACTOR,
-                                           LINE_SEARCH_GEOMETRIC_STEP_MAX_ITERATION_COUNT);
-            // TODO: do something if there's still a failure
+            // this updates current_value and g along with current_approximation
+            bool line_search_success =
+                LineSearch::strong_wolfe_step(func,
+                                              current_approximation,
+                                              step,
+                                              current_value,
+                                              g,
+                                              parameters.sufficient_decrease_factor,
+                                              parameters.curvature_factor,
+                                              parameters.strong_wolfe_max_iteration_count);
+            ++iteration_count;
+            // the step is always a descent direction, so failure means that no
+            // further progress can be made (e.g. due to roundoff).
+            if (!line_search_success)
+                break;
         }
-
-        ++iteration_count;
+        else
+        {
+            bool line_search_success =
+                LineSearch::uniform_step(func,
+                                         current_approximation,
+                                         step,
+                                         parameters.uniform_step_substep_count);
+            if (!line_search_success)
+            {
+                step(i).no_alias() = step(i) / Scalar_(parameters.uniform_step_substep_count);
+                line_search_success =
+                    LineSearch::geometric_step(func,
+                                               current_approximation,
+                                               step,
+                                               parameters.geometric_step_factor,
+                                               parameters.geometric_step_max_iteration_count);
+                // TODO: do something if there's still a failure
+            }
+            current_value = func.function(current_approximation);
+            g = func.D_function(current_approximation);
+            ++iteration_count;
+        }
+        g_norm = std::sqrt(covector_innerproduct(g, g));
     }
 
     DEBUG_OUTPUT(   "    minimize took " << iteration_count << " steps; "
@@ -310,6 +712,444 @@ ImplementationOf_t<BasedVectorSpace_,Scalar_> minimize (ObjectiveFunction_ const
                  << conjugate_gradient << " were conjugate gradient, and "
                  << gradient_descent << " were gradient descent." << '\n');
 
+    if (statistics != nullptr)
+    {
+        statistics->iteration_count = iteration_count;
+        statistics->newtons_method_step_count = newtons_method;
+        statistics->conjugate_gradient_step_count = conjugate_gradient;
+        statistics->gradient_descent_step_count = gradient_descent;
+        statistics->last_step_type = last_step_type;
+        statistics->final_value = current_value;
+        statistics->final_gradient_norm = g_norm;
+        statistics->tolerance_was_attained = tolerance_was_attained;
+        statistics->total_seconds = ProfiledObjectiveFunction::seconds_since(start);
+    }
+
+    return current_approximation;
+}
+
+// minimize with the default parameters.  if minimum is not null and tolerance was
+// attained, the function value at the returned approximate minimizer is stored in it.
+template <typename InnerProductId_, typename ObjectiveFunction_, typename BasedVectorSpace_, typename Scalar_, typename GuessUseArrayType_, typename Derived_>
+ImplementationOf_t<BasedVectorSpace_,Scalar_> minimize (ObjectiveFunction_ const &func,
+                                                        ImplementationOf_t<BasedVectorSpace_,Scalar_,GuessUseArrayType_,Derived_> const &guess,
+                                                        Scalar_ tolerance,
+                                                        Scalar_ *minimum = nullptr)
+{
+    if (minimum == nullptr)
+        return minimize<InnerProductId_>(func, guess, tolerance, MinimizationParameters_t<Scalar_>());
+
+    MinimizationStatistics_t<Scalar_> statistics;
+    ImplementationOf_t<BasedVectorSpace_,Scalar_> retval(minimize<InnerProductId_>(func, guess, tolerance, MinimizationParameters_t<Scalar_>(), &statistics));
+    if (statistics.tolerance_was_attained)
+        *minimum = statistics.final_value;
+    return retval;
+}
+
+// runs minimize from each of the guesses, which are the columns of a tensor in
+// BasedVectorSpace_ \otimes StartSpace_.  this is a structure-of-arrays batch of
+// DimensionOf_f<StartSpace_>::V guesses -- the same component of all the guesses is
+// contiguous, so e.g. a batch can be generated or transformed componentwise -- and
+// each guess is gathered from its column when its start is run.  the starts are split
+// across thread_count threads (or std::thread::hardware_concurrency() threads, if
+// thread_count is 0).  the progress output is suppressed when more than one thread
+// is used, since it would interleave.
+// returns the minimizer with the lowest function value, the earliest in case of a
+// tie, so the result doesn't depend on thread_count or scheduling.  if statistics
+// is not null, it must point to an array of DimensionOf_f<StartSpace_>::V elements,
+// which is filled out with the statistics of each start.  if best_start_index is not
+// null, the index of the start which gave the returned minimizer is stored in it.
+// func must be safe to call concurrently.
+template <typename InnerProductId_,
+          typename ObjectiveFunction_,
+          typename BasedVectorSpace_,
+          typename StartSpace_,
+          typename Scalar_,
+          typename GuessesUseArrayType_,
+          typename Derived_>
+ImplementationOf_t<BasedVectorSpace_,Scalar_>
+    multistart_minimize (ObjectiveFunction_ const &func,
+                         ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<Typle_t<BasedVectorSpace_,StartSpace_>>,Scalar_,GuessesUseArrayType_,Derived_> const &guesses,
+                         Scalar_ tolerance,
+                         MinimizationParameters_t<Scalar_> const &parameters,
+                         Uint32 thread_count = 0,
+                         MinimizationStatistics_t<Scalar_> *statistics = nullptr,
+                         Uint32 *best_start_index = nullptr)
+{
+    typedef ImplementationOf_t<BasedVectorSpace_,Scalar_> VectorType;
+    typedef ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<Typle_t<BasedVectorSpace_,StartSpace_>>,Scalar_,GuessesUseArrayType_,Derived_> Guesses;
+    static Uint32 const START_COUNT = DimensionOf_f<StartSpace_>::V;
+    static_assert(START_COUNT > 0, "there must be at least one start");
+    // checked here so that a failure happens on the calling thread
+    assert(parameters.uniform_step_substep_count > 0 && "uniform_step_substep_count must be positive");
+
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    thread_count = std::max(std::min(thread_count, START_COUNT), 1u);
+
+    // the statistics are always collected, since the final values are needed
+    std::vector<MinimizationStatistics_t<Scalar_>> start_statistics(START_COUNT);
+    std::vector<VectorType> minimizers(START_COUNT, VectorType(Static<WithoutInitialization>::SINGLETON));
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    // thread t handles starts t, t + thread_count, t + 2*thread_count, etc.
+    auto minimize_starts = [&](Uint32 t)
+    {
+        DebugOutputSuppression_t debug_output_suppression(thread_count > 1);
+        VectorType guess(Static<WithoutInitialization>::SINGLETON);
+        for (Uint32 s = t; s < START_COUNT; s += thread_count)
+        {
+            // component c of guess s is at row-major index c*START_COUNT + s
+            for (typename VectorType::ComponentIndex c; c.is_not_at_end(); ++c)
+                guess[c] = guesses[typename Guesses::ComponentIndex(c.value()*START_COUNT + s, CheckRange::FALSE)];
+            minimizers[s] = minimize<InnerProductId_>(func, guess, tolerance, parameters, &start_statistics[s]);
+        }
+    };
+    for (Uint32 t = 1; t < thread_count; ++t)
+        threads.push_back(std::thread(minimize_starts, t));
+    minimize_starts(0);
+    for (std::thread &thread : threads)
+        thread.join();
+
+    // the reduction is done in start order, so it doesn't depend on the threads.
+    // written this way so that NaN values are never chosen over others.
+    Uint32 best = 0;
+    for (Uint32 s = 1; s < START_COUNT; ++s)
+        if (start_statistics[s].final_value < start_statistics[best].final_value || isNaN(start_statistics[best].final_value))
+            best = s;
+
+    if (statistics != nullptr)
+        std::copy(start_statistics.begin(), start_statistics.end(), statistics);
+    if (best_start_index != nullptr)
+        *best_start_index = best;
+    return minimizers[best];
+}
+
+// limited-memory BFGS, a quasi-Newton method which uses only func.function and
+// func.D_function.  the inverse Hessian is approximated from the last HISTORY_SIZE_
+// steps and the corresponding changes in the gradient (via the two-loop recursion),
+// starting from a scalar multiple of the inverse of the inner product.  the history
+// is kept in two preallocated tensors, indexed by a HISTORY_SIZE_-dimensional space,
+// which are used as ring buffers.  each step uses a backtracking line search for
+// sufficient decrease (the Armijo condition).  returns the approximate minimizer,
+// which is where the norm of the gradient is at most tolerance, if that happens
+// within max_iteration_count iterations.  as with minimize, if minimum is not null
+// and tolerance was attained, the function value at the returned approximate
+// minimizer is stored in it.
+template <typename InnerProductId_,
+          Uint32 HISTORY_SIZE_ = 6,
+          typename ObjectiveFunction_,
+          typename BasedVectorSpace_,
+          typename Scalar_,
+          typename GuessUseArrayType_,
+          typename Derived_>
+ImplementationOf_t<BasedVectorSpace_,Scalar_> lbfgs_minimize (ObjectiveFunction_ const &func,
+                                                              ImplementationOf_t<BasedVectorSpace_,Scalar_,GuessUseArrayType_,Derived_> const &guess,
+                                                              Scalar_ tolerance,
+                                                              Scalar_ *minimum = nullptr,
+                                                              Uint32 max_iteration_count = 200)
+{
+    static_assert(HISTORY_SIZE_ > 0, "HISTORY_SIZE_ must be positive");
+    typedef typename DualOf_f<BasedVectorSpace_>::T DualOfBasedVectorSpace;
+    typedef ImplementationOf_t<BasedVectorSpace_,Scalar_> VectorType;
+    typedef ImplementationOf_t<DualOfBasedVectorSpace,Scalar_> CoVectorType;
+    typedef typename InnerProduct_f<DualOfBasedVectorSpace,InnerProductId_,Scalar_>::T CoVectorInnerProductType;
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,HISTORY_SIZE_,Generic>,Basis_c<Generic>> HistorySpace;
+    typedef ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<Typle_t<HistorySpace,BasedVectorSpace_>>,Scalar_> StepHistory;
+    typedef ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<Typle_t<HistorySpace,DualOfBasedVectorSpace>>,Scalar_> GradientChangeHistory;
+    // views of the rows of the history tensors
+    typedef ImplementationOf_t<BasedVectorSpace_,Scalar_,UsePreallocatedArray_t<ComponentsAreConst::FALSE>> VectorView;
+    typedef ImplementationOf_t<DualOfBasedVectorSpace,Scalar_,UsePreallocatedArray_t<ComponentsAreConst::FALSE>> CoVectorView;
+    static_assert(TypesAreEqual_f<VectorType,typename ObjectiveFunction_::V>::V, "types must match");
+    static_assert(TypesAreEqual_f<Scalar_,typename ObjectiveFunction_::Out>::V, "types must match");
+    static Uint32 const DIM = DimensionOf_f<BasedVectorSpace_>::V;
+    static Scalar_ const SUFFICIENT_DECREASE_FACTOR = Scalar_(1e-4);
+    static Scalar_ const BACKTRACKING_FACTOR = Scalar_(0.5);
+    static Uint32 const MAX_BACKTRACKING_COUNT = 40;
+    static Scalar_ const EPSILON = 1e-10;
+
+    CoVectorInnerProductType covector_innerproduct;
+
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+
+    StepHistory step_history(Static<WithoutInitialization>::SINGLETON);
+    GradientChangeHistory gradient_change_history(Static<WithoutInitialization>::SINGLETON);
+    Scalar_ rho[HISTORY_SIZE_] = {};
+    Scalar_ alpha[HISTORY_SIZE_] = {};
+    Uint32 history_count = 0;
+    Uint32 next_history_index = 0;
+
+    VectorType current_approximation(guess);
+    Scalar_ current_value(func.function(current_approximation));
+    CoVectorType g(func.D_function(current_approximation));
+    CoVectorType q(Static<WithoutInitialization>::SINGLETON);
+    CoVectorType next_g(Static<WithoutInitialization>::SINGLETON);
+    VectorType direction(Static<WithoutInitialization>::SINGLETON);
+    VectorType next_approximation(Static<WithoutInitialization>::SINGLETON);
+    Uint32 iteration_count = 0;
+
+    for ( ; iteration_count < max_iteration_count; ++iteration_count)
+    {
+        Scalar_ g_norm = std::sqrt(covector_innerproduct(g, g));
+        DEBUG_OUTPUT(   "lbfgs_minimize: iteration " << iteration_count
+                     << ", current_approximation = " << current_approximation
+                     << ", norm of gradient = " << g_norm
+                     << ", current function value = " << current_value << '\n');
+        if (g_norm <= tolerance)
+            break;
+
+        // the two-loop recursion computes direction = -H*g, where H is the approximate
+        // inverse Hessian.  the k-th entry of the history is s_k = x_{k+1} - x_k and
+        // y_k = g_{k+1} - g_k, which are visited newest to oldest, then oldest to newest.
+        q = g;
+        for (Uint32 n = 0; n < history_count; ++n)
+        {
+            Uint32 k = (next_history_index + HISTORY_SIZE_ - 1 - n) % HISTORY_SIZE_;
+            VectorView s_k(step_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            CoVectorView y_k(gradient_change_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            alpha[k] = rho[k] * (s_k(i)*q(i));
+            q(i).no_alias() -= alpha[k] * y_k(i);
+        }
+        // the initial inverse Hessian approximation is gamma times the inverse of the
+        // inner product, where gamma is taken from the newest history entry, or makes
+        // the first step have unit length.
+        Scalar_ gamma = Scalar_(1) / g_norm;
+        if (history_count > 0)
+        {
+            Uint32 k = (next_history_index + HISTORY_SIZE_ - 1) % HISTORY_SIZE_;
+            CoVectorView y_k(gradient_change_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            gamma = Scalar_(1) / (rho[k] * covector_innerproduct(y_k, y_k));
+        }
+        direction(j).no_alias() = gamma * q(i) * covector_innerproduct.split(i*j);
+        for (Uint32 n = history_count; n-- > 0; )
+        {
+            Uint32 k = (next_history_index + HISTORY_SIZE_ - 1 - n) % HISTORY_SIZE_;
+            VectorView s_k(step_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            CoVectorView y_k(gradient_change_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            Scalar_ beta = rho[k] * (y_k(i)*direction(i));
+            direction(i).no_alias() += (alpha[k] - beta) * s_k(i);
+        }
+        direction(i).no_alias() = -direction(i);
+
+        Scalar_ directional_derivative = g(i)*direction(i);
+        if (!(directional_derivative < Scalar_(0)))
+        {
+            // the approximation has gone bad (e.g. due to roundoff), so start over
+            // from the gradient descent direction.
+            DEBUG_OUTPUT("    lbfgs_minimize: not a descent direction; clearing history\n");
+            history_count = 0;
+            direction(j).no_alias() = (-Scalar_(1) / g_norm) * g(i) * covector_innerproduct.split(i*j);
+            directional_derivative = g(i)*direction(i);
+        }
+
+        // backtracking line search for sufficient decrease
+        Scalar_ t(1);
+        Scalar_ next_value;
+        Uint32 backtracking_count = 0;
+        while (true)
+        {
+            next_approximation(i).no_alias() = current_approximation(i) + t * direction(i);
+            next_value = func.function(next_approximation);
+            if (next_value <= current_value + SUFFICIENT_DECREASE_FACTOR * t * directional_derivative)
+                break;
+            if (++backtracking_count == MAX_BACKTRACKING_COUNT)
+                break;
+            t *= BACKTRACKING_FACTOR;
+        }
+        if (backtracking_count == MAX_BACKTRACKING_COUNT)
+        {
+            DEBUG_OUTPUT("    lbfgs_minimize: line search failed\n");
+            break;
+        }
+        next_g = func.D_function(next_approximation);
+
+        // record the step and gradient change, if they satisfy the curvature condition
+        // (which keeps the approximate inverse Hessian positive definite).
+        {
+            Uint32 k = next_history_index;
+            VectorView s_k(step_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            CoVectorView y_k(gradient_change_history.pointer_to_allocation() + k*DIM, CheckPointer::FALSE);
+            s_k(i).no_alias() = next_approximation(i) - current_approximation(i);
+            y_k(i).no_alias() = next_g(i) - g(i);
+            Scalar_ sy = y_k(i)*s_k(i);
+            if (sy > EPSILON)
+            {
+                rho[k] = Scalar_(1) / sy;
+                next_history_index = (next_history_index + 1) % HISTORY_SIZE_;
+                history_count = std::min(history_count + 1, HISTORY_SIZE_);
+            }
+        }
+
+        current_approximation = next_approximation;
+        current_value = next_value;
+        g = next_g;
+    }
+
+    DEBUG_OUTPUT("    lbfgs_minimize took " << iteration_count << " steps\n");
+
+    if (minimum != nullptr && std::sqrt(covector_innerproduct(g, g)) <= tolerance)
+        *minimum = current_value;
+    return current_approximation;
+}
+
+// Levenberg-Marquardt, for nonlinear least-squares problems: finds an approximate
+// minimizer of half the sum of the squares of the components of func.function,
+// which is a function object (see FunctionObjectType_m) with a vector-valued
+// codomain, using only func.function and func.D_function (the Jacobian J).  each
+// iteration solves (J^T*J + lambda*D)*step = -J^T*r for the step, where r is the
+// residual and D is the diagonal of J^T*J (bounded below by EPSILON, which keeps
+// the step scale-invariant).  J^T*J is accumulated directly in packed Sym^2 storage,
+// one rank-1 update per row of J, and solved via sym2_ldlt_factor/sym2_ldlt_solve.
+// the damping lambda is updated from the ratio of the actual to the predicted
+// decrease (see Nielsen, "Damping Parameter in Marquardt's Method", 1999), and
+// rejected steps cost only one evaluation of func.function.  all the temporaries
+// are allocated once, before the iteration.  returns the approximate minimizer,
+// which is where the norm of the gradient J^T*r is at most tolerance or the step
+// has become negligible, if that happens within max_iteration_count iterations.
+// if minimum is not null, half the sum of squares at the minimizer is stored in it.
+template <typename InnerProductId_,
+          typename ObjectiveFunction_,
+          typename BasedVectorSpace_,
+          typename Scalar_,
+          typename GuessUseArrayType_,
+          typename Derived_>
+ImplementationOf_t<BasedVectorSpace_,Scalar_> levenberg_marquardt (ObjectiveFunction_ const &func,
+                                                                   ImplementationOf_t<BasedVectorSpace_,Scalar_,GuessUseArrayType_,Derived_> const &guess,
+                                                                   Scalar_ tolerance,
+                                                                   Scalar_ *minimum = nullptr,
+                                                                   Uint32 max_iteration_count = 100,
+                                                                   Scalar_ initial_damping_factor = Scalar_(1e-3))
+{
+    typedef typename DualOf_f<BasedVectorSpace_>::T DualOfBasedVectorSpace;
+    typedef typename ObjectiveFunction_::CoDomain CoDomain;
+    typedef ImplementationOf_t<BasedVectorSpace_,Scalar_> VectorType;
+    typedef ImplementationOf_t<DualOfBasedVectorSpace,Scalar_> CoVectorType;
+    typedef ImplementationOf_t<SymmetricPowerOfBasedVectorSpace_c<2,DualOfBasedVectorSpace>,Scalar_> Sym2CoVectorType;
+    typedef typename ObjectiveFunction_::Out Residual;
+    typedef typename ObjectiveFunction_::D1 Jacobian;
+    typedef typename InnerProduct_f<DualOfBasedVectorSpace,InnerProductId_,Scalar_>::T CoVectorInnerProductType;
+    // views of the rows of the Jacobian, which are covectors
+    typedef ImplementationOf_t<DualOfBasedVectorSpace,Scalar_,UsePreallocatedArray_t<ComponentsAreConst::TRUE>> CoVectorView;
+    static_assert(TypesAreEqual_f<VectorType,typename ObjectiveFunction_::V>::V, "types must match");
+    static_assert(TypesAreEqual_f<typename ObjectiveFunction_::Domain,BasedVectorSpace_>::V, "types must match");
+    static_assert(TypesAreEqual_f<typename Jacobian::Concept,TensorProductOfBasedVectorSpaces_c<Typle_t<CoDomain,DualOfBasedVectorSpace>>>::V,
+                  "func.D_function must be the Jacobian, a tensor in CoDomain \\otimes DualOf(BasedVectorSpace_)");
+    static Uint32 const DIM = DimensionOf_f<BasedVectorSpace_>::V;
+    static Uint32 const RESIDUAL_DIM = DimensionOf_f<CoDomain>::V;
+    static Scalar_ const EPSILON = 1e-10;
+
+    CoVectorInnerProductType covector_innerproduct;
+
+    AbstractIndex_c<'i'> i;
+
+    VectorType current_approximation(guess);
+    VectorType next_approximation(Static<WithoutInitialization>::SINGLETON);
+    VectorType step(Static<WithoutInitialization>::SINGLETON);
+    Residual residual(func.function(current_approximation));
+    Residual next_residual(Static<WithoutInitialization>::SINGLETON);
+    Jacobian jacobian(Static<WithoutInitialization>::SINGLETON);
+    CoVectorType g(Static<WithoutInitialization>::SINGLETON);
+    CoVectorType negative_g(Static<WithoutInitialization>::SINGLETON);
+    Sym2CoVectorType jtj(Static<WithoutInitialization>::SINGLETON);
+    Sym2CoVectorType damped_jtj(Static<WithoutInitialization>::SINGLETON);
+    Scalar_ current_value(Scalar_(0.5) * reduce_array<SquaredSumReduction_t<Scalar_>,RESIDUAL_DIM>(residual.pointer_to_allocation()));
+    Scalar_ damping_factor(0);
+    Scalar_ damping_growth_factor(2);
+    bool jacobian_is_current = false;
+    Uint32 iteration_count = 0;
+
+    for ( ; iteration_count < max_iteration_count; ++iteration_count)
+    {
+        // after a rejected step, J^T*J and J^T*r are still valid
+        if (!jacobian_is_current)
+        {
+            jacobian = func.D_function(current_approximation);
+            jtj = Sym2CoVectorType(fill_with(Scalar_(0)));
+            g = CoVectorType(fill_with(Scalar_(0)));
+            for (Uint32 r = 0; r < RESIDUAL_DIM; ++r)
+            {
+                CoVectorView jacobian_row(jacobian.pointer_to_allocation() + r*DIM, CheckPointer::FALSE);
+                sym2_rank1_update(jtj, Scalar_(1), jacobian_row);
+                g(i).no_alias() += residual[typename Residual::ComponentIndex(r, CheckRange::FALSE)] * jacobian_row(i);
+            }
+            jacobian_is_current = true;
+            if (iteration_count == 0)
+            {
+                // the initial damping is relative to the largest diagonal component
+                Scalar_ max_diagonal(0);
+                for (Uint32 a = 0; a < DIM; ++a)
+                    max_diagonal = std::max(max_diagonal, jtj[typename Sym2CoVectorType::ComponentIndex(sym2_packed_index(a, a), CheckRange::FALSE)]);
+                damping_factor = initial_damping_factor * max_diagonal;
+            }
+        }
+
+        Scalar_ g_norm = std::sqrt(covector_innerproduct(g, g));
+        DEBUG_OUTPUT(   "levenberg_marquardt: iteration " << iteration_count
+                     << ", current_approximation = " << current_approximation
+                     << ", norm of gradient = " << g_norm
+                     << ", current function value = " << current_value
+                     << ", damping factor = " << damping_factor << '\n');
+        if (g_norm <= tolerance)
+            break;
+
+        // solve (J^T*J + damping_factor*D)*step = -J^T*r
+        damped_jtj = jtj;
+        for (Uint32 a = 0; a < DIM; ++a)
+        {
+            typename Sym2CoVectorType::ComponentIndex k(sym2_packed_index(a, a), CheckRange::FALSE);
+            damped_jtj[k] += damping_factor * std::max(jtj[k], EPSILON);
+        }
+        negative_g(i).no_alias() = -g(i);
+        if (!sym2_ldlt_factor(damped_jtj, Scalar_(0)))
+        {
+            // J^T*J + damping_factor*D is always positive definite in exact arithmetic,
+            // so this can only be due to roundoff; damp more heavily and try again.
+            DEBUG_OUTPUT("    levenberg_marquardt: damped J^T*J is not positive definite\n");
+            damping_factor = std::max(damping_factor * damping_growth_factor, EPSILON);
+            damping_growth_factor *= Scalar_(2);
+            continue;
+        }
+        sym2_ldlt_solve(damped_jtj, negative_g, step);
+
+        // the step is compared with the current approximation componentwise
+        if (reduce_array<SquaredSumReduction_t<Scalar_>,DIM>(step.pointer_to_allocation()) <=
+            sqr(EPSILON) * (reduce_array<SquaredSumReduction_t<Scalar_>,DIM>(current_approximation.pointer_to_allocation()) + EPSILON))
+        {
+            DEBUG_OUTPUT("    levenberg_marquardt: step is negligible\n");
+            break;
+        }
+
+        next_approximation(i).no_alias() = current_approximation(i) + step(i);
+        next_residual = func.function(next_approximation);
+        Scalar_ next_value(Scalar_(0.5) * reduce_array<SquaredSumReduction_t<Scalar_>,RESIDUAL_DIM>(next_residual.pointer_to_allocation()));
+        // the decrease predicted by the linearization r + J*step, which is
+        // -(g(step) + step^T*J^T*J*step/2), and is positive since g(step) < 0.
+        Scalar_ predicted_decrease = -((g(i)*step(i)) + Scalar_(0.5) * sym2_quadratic_form(jtj, step));
+        Scalar_ gain_ratio = (current_value - next_value) / predicted_decrease;
+        // written this way so that NaN is rejected
+        if (gain_ratio > Scalar_(0))
+        {
+            current_approximation = next_approximation;
+            residual = next_residual;
+            current_value = next_value;
+            jacobian_is_current = false;
+            damping_factor *= std::max(Scalar_(1)/Scalar_(3), Scalar_(1) - cube(Scalar_(2)*gain_ratio - Scalar_(1)));
+            damping_growth_factor = Scalar_(2);
+        }
+        else
+        {
+            DEBUG_OUTPUT("    levenberg_marquardt: rejected step, gain ratio = " << gain_ratio << '\n');
+            damping_factor *= damping_growth_factor;
+            damping_growth_factor *= Scalar_(2);
+        }
+    }
+
+    DEBUG_OUTPUT("    levenberg_marquardt took " << iteration_count << " steps\n");
+
+    if (minimum != nullptr)
+        *minimum = current_value;
     return current_approximation;
 }
 
@@ -376,12 +1216,41 @@ template <typename InnerProductId_,
           typename Scalar_,
           typename BasedVectorSpace_,
           ComponentQualifier COMPONENT_QUALIFIER_>
-Scalar_ squared_norm (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &v)
+Scalar_ squared_norm (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &v,
+                      Value_t<bool,false> const &)
 {
     typename InnerProduct_f<BasedVectorSpace_,InnerProductId_,Scalar_>::T inner_product;
     return inner_product(v, v);//inner_product.split(i*j)*v(i)*v(j); // doesn't take advantage of symmetry
 }
 
+// the standard inner product on an orthonormal basis is the sum of the squares of the
+// components, which for a vector in memory can be accumulated straight from the array.
+template <typename InnerProductId_,
+          typename Derived_,
+          typename Scalar_,
+          typename BasedVectorSpace_,
+          ComponentQualifier COMPONENT_QUALIFIER_>
+Scalar_ squared_norm (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &v,
+                      Value_t<bool,true> const &)
+{
+    typedef Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> Vector;
+    return reduce_array<SquaredSumReduction_t<Scalar_>,Vector::DIM>(v.as_derived().pointer_to_allocation());
+}
+
+// NOTE: this won't work for complex types
+template <typename InnerProductId_,
+          typename Derived_,
+          typename Scalar_,
+          typename BasedVectorSpace_,
+          ComponentQualifier COMPONENT_QUALIFIER_>
+Scalar_ squared_norm (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &v)
+{
+    static bool const IS_STANDARD_IN_MEMORY = TypesAreEqual_f<InnerProductId_,StandardInnerProduct>::V &&
+                                              IsOrthonormalBasis_f<typename BasisOf_f<BasedVectorSpace_>::T>::V &&
+                                              COMPONENT_QUALIFIER_ != ComponentQualifier::PROCEDURAL;
+    return squared_norm<InnerProductId_>(v, Value_t<bool,IS_STANDARD_IN_MEMORY>());
+}
+
 // NOTE: this won't work for complex types
 template <typename InnerProductId_,
           typename Derived_,
@@ -438,6 +1307,30 @@ void randomize (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_
     while (sqn <= squared_inner_radius || squared_outer_radius <= sqn);
 }
 
+// open annulus of given inner and outer radii in the vector space, drawing from
+// rng (e.g. a std::mt19937) instead of the global rand(), so that independent
+// streams of random vectors can be generated (e.g. in different threads).
+template <typename InnerProductId_, typename Derived_, typename Scalar_, typename BasedVectorSpace_, ComponentQualifier COMPONENT_QUALIFIER_, typename Rng_>
+void randomize (Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_> &x,
+                Scalar_ const &inner_radius,
+                Scalar_ const &outer_radius,
+                Rng_ &rng)
+{
+    static_assert(COMPONENT_QUALIFIER_ != ComponentQualifier::PROCEDURAL, "must not use procedural components");
+    Scalar_ squared_inner_radius = sqr(inner_radius);
+    Scalar_ squared_outer_radius = sqr(outer_radius);
+    std::uniform_real_distribution<Scalar_> cube_component(-outer_radius, outer_radius);
+    Scalar_ sqn;
+    do
+    {
+        // generate a random vector in the cube [-r,r]^n, where r is the outer radius
+        for (typename Vector_i<Derived_,Scalar_,BasedVectorSpace_,COMPONENT_QUALIFIER_>::ComponentIndex i; i.is_not_at_end(); ++i)
+            x[i] = cube_component(rng);
+        sqn = squared_norm<InnerProductId_>(x);
+    } // if the randomly generated point is outside of the annulus, try again
+    while (sqn <= squared_inner_radius || squared_outer_radius <= sqn);
+}
+
 
 template <typename InnerProductId_,
           typename ObjectiveFunction_,
@@ -491,6 +1384,119 @@ ImplementationOf_t<BasedVectorSpace_,typename ObjectiveFunction_::Scalar>
     return minimizer;
 }
 
+// the number of samples in each block of parallel_totally_random_minimization
+static Uint32 const RANDOM_MINIMIZATION_BLOCK_SIZE = 256;
+
+// the best sample found in one block of samples of parallel_totally_random_minimization
+template <typename V_, typename Scalar_>
+struct RandomMinimizationBlockResult_t
+{
+    RandomMinimizationBlockResult_t () : minimizer(Static<WithoutInitialization>::SINGLETON), found(false) { }
+
+    V_ minimizer;
+    Scalar_ min;
+    bool found;
+};
+
+// the same search as totally_random_minimization, but with the samples of each
+// iteration split across thread_count threads (or std::thread::hardware_concurrency()
+// threads, if thread_count is 0).  the samples are generated in blocks of
+// RANDOM_MINIMIZATION_BLOCK_SIZE, each drawing from its own std::mt19937 seeded by
+// (seed, iteration, block), and the best samples of the blocks are compared in block
+// order, keeping the earliest in case of a tie.  thus the result depends only on seed,
+// not on thread_count or scheduling.  func.function must be safe to call concurrently.
+template <typename InnerProductId_,
+          typename ObjectiveFunction_,
+          typename BasedVectorSpace_,
+          typename GuessUseArrayType_,
+          typename Derived_>
+ImplementationOf_t<BasedVectorSpace_,typename ObjectiveFunction_::Scalar>
+    parallel_totally_random_minimization (ObjectiveFunction_ const &func,
+                                          ImplementationOf_t<BasedVectorSpace_,typename ObjectiveFunction_::Scalar,GuessUseArrayType_,Derived_> const &initial_guess,
+                                          typename ObjectiveFunction_::Scalar search_radius,
+                                          Uint32 thread_count = 0,
+                                          Uint32 seed = 0,
+                                          Uint32 sample_count = 10000,
+                                          Uint32 max_iteration_count = 8,
+                                          typename ObjectiveFunction_::Scalar *minimum = nullptr)
+{
+    typedef typename ObjectiveFunction_::Scalar Scalar;
+    assert(search_radius > Scalar(0) && "search_radius must be positive");
+
+    typedef ImplementationOf_t<BasedVectorSpace_,Scalar> V;
+    typedef RandomMinimizationBlockResult_t<V,Scalar> BlockResult;
+
+    if (thread_count == 0)
+        thread_count = std::max(std::thread::hardware_concurrency(), 1u);
+    Uint32 block_count = (sample_count + RANDOM_MINIMIZATION_BLOCK_SIZE - 1) / RANDOM_MINIMIZATION_BLOCK_SIZE;
+    thread_count = std::max(std::min(thread_count, block_count), 1u);
+
+    V random_center(initial_guess);
+    V minimizer(initial_guess);
+    Scalar min(func.function(minimizer));
+    std::vector<BlockResult> block_results(block_count);
+    std::vector<std::thread> threads;
+    threads.reserve(thread_count - 1);
+
+    for (Uint32 iteration_count = 0; iteration_count < max_iteration_count; ++iteration_count)
+    {
+        // thread t handles blocks t, t + thread_count, t + 2*thread_count, etc.
+        auto sample_blocks = [&](Uint32 t)
+        {
+            for (Uint32 block = t; block < block_count; block += thread_count)
+            {
+                std::seed_seq seed_sequence{seed, iteration_count, block};
+                std::mt19937 rng(seed_sequence);
+                Uint32 block_end = std::min((block + 1) * RANDOM_MINIMIZATION_BLOCK_SIZE, sample_count);
+                BlockResult &result = block_results[block];
+                result.found = false;
+                V x(Static<WithoutInitialization>::SINGLETON);
+                AbstractIndex_c<'i'> i;
+                for (Uint32 sample = block * RANDOM_MINIMIZATION_BLOCK_SIZE; sample < block_end; ++sample)
+                {
+                    randomize<InnerProductId_>(x, Scalar(0), search_radius, rng);
+                    x(i) += random_center(i);
+                    Scalar value(func.function(x));
+                    // a non-finite first sample would otherwise be kept, since nothing compares less than NaN
+                    if (!isFinite(value))
+                        continue;
+                    if (!result.found || value < result.min)
+                    {
+                        result.min = value;
+                        result.minimizer = x;
+                        result.found = true;
+                    }
+                }
+            }
+        };
+        for (Uint32 t = 1; t < thread_count; ++t)
+            threads.push_back(std::thread(sample_blocks, t));
+        sample_blocks(0);
+        for (std::thread &thread : threads)
+            thread.join();
+        threads.clear();
+
+        // the reduction is done in block order, so it doesn't depend on the threads
+        for (Uint32 block = 0; block < block_count; ++block)
+        {
+            if (block_results[block].found && block_results[block].min < min)
+            {
+                min = block_results[block].min;
+                minimizer = block_results[block].minimizer;
+            }
+        }
+
+        // recenter and narrow search radius
+        random_center = minimizer;
+        search_radius /= Scalar(2);
+    }
+
+    if (minimum != nullptr)
+        *minimum = min;
+
+    return minimizer;
+}
+
 } // end of namespace Tenh
 
 #endif // TENH_UTILITY_OPTIMIZATION_HPP_
@@ -8,6 +8,8 @@
 
 #include "tenh/core.hpp"
 
+#include <algorithm>
+
 #include "tenh/conceptual/symmetricpower.hpp"
 #include "tenh/conceptual/tensorproduct.hpp"
 #include "tenh/conceptual/vectorspace.hpp"
@@ -73,6 +75,41 @@ struct MultivariatePolynomial
         return m_term.evaluate(at) + m_body.evaluate(at);
     }
 
+    static Uint32 const BATCH_CHUNK_SIZE = LeadingTermType::BATCH_CHUNK_SIZE;
+
+    // evaluates at point_count points given in structure-of-arrays form, i.e.
+    // coordinates[i][p] is the ith coordinate of the pth point, and stores the
+    // value at the pth point in values[p].  if gradients is non-null, the ith
+    // partial derivative at the pth point is stored in gradients[i][p].  the
+    // points are processed in chunks, and the monomial table of each homogeneous
+    // term is shared by all of them.  the values are identical to those of evaluate.
+    void evaluate_batch (Scalar_ const *const *coordinates,
+                         Uint32 point_count,
+                         Scalar_ *values,
+                         Scalar_ *const *gradients = nullptr) const
+    {
+        if (gradients != nullptr)
+            for (Uint32 i = 0; i < Vector::DIM; ++i)
+                for (Uint32 p = 0; p < point_count; ++p)
+                    gradients[i][p] = Scalar_(0);
+
+        Scalar_ const *x[Vector::DIM];
+        Scalar_ *g[Vector::DIM];
+        for (Uint32 start = 0; start < point_count; start += BATCH_CHUNK_SIZE)
+        {
+            for (Uint32 i = 0; i < Vector::DIM; ++i)
+            {
+                x[i] = coordinates[i] + start;
+                if (gradients != nullptr)
+                    g[i] = gradients[i] + start;
+            }
+            evaluate_batch_chunk(x,
+                                 std::min(BATCH_CHUNK_SIZE, point_count - start),
+                                 values + start,
+                                 (gradients != nullptr) ? g : nullptr);
+        }
+    }
+
     // Member operators
     MultivariatePolynomial operator * (Scalar_ const &rhs) const
     {
@@ -140,6 +177,19 @@ private:
     BodyPolynomial m_body;
     LeadingTermType m_term;
 
+    // stores the values and adds the partial derivatives (if gradients is non-null)
+    // for up to BATCH_CHUNK_SIZE points.  the term and body are added in the same
+    // order as in evaluate.
+    void evaluate_batch_chunk (Scalar_ const *const *x, Uint32 point_count, Scalar_ *values, Scalar_ *const *gradients) const
+    {
+        assert(point_count <= BATCH_CHUNK_SIZE);
+        Scalar_ term_values[BATCH_CHUNK_SIZE];
+        m_body.evaluate_batch_chunk(x, point_count, values, gradients);
+        m_term.evaluate_batch_chunk(x, point_count, term_values, gradients);
+        for (Uint32 p = 0; p < point_count; ++p)
+            values[p] = term_values[p] + values[p];
+    }
+
     // Helper members for non-member operators.
     //    add is for adding a polynomial of strictly lower degree to this polynomial
     template<Uint32 OTHER_DEGREE_>
@@ -162,6 +212,10 @@ private:
                     MultivariatePolynomial<DEG,BasedVectorSpace_,Scalar> const &rhs);
 };
 
+// the definition is needed because std::min takes BATCH_CHUNK_SIZE by reference
+template <Uint32 DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+Uint32 const MultivariatePolynomial<DEGREE_,BasedVectorSpace_,Scalar_>::BATCH_CHUNK_SIZE;
+
 template <typename BasedVectorSpace_, typename Scalar_>
 struct MultivariatePolynomial<0,BasedVectorSpace_,Scalar_>
 {
@@ -189,6 +243,20 @@ struct MultivariatePolynomial<0,BasedVectorSpace_,Scalar_>
         return m_term;
     }
 
+    // see the general MultivariatePolynomial; a constant has zero gradient.
+    void evaluate_batch (Scalar_ const *const *coordinates,
+                         Uint32 point_count,
+                         Scalar_ *values,
+                         Scalar_ *const *gradients = nullptr) const
+    {
+        for (Uint32 p = 0; p < point_count; ++p)
+            values[p] = m_term;
+        if (gradients != nullptr)
+            for (Uint32 i = 0; i < Vector::DIM; ++i)
+                for (Uint32 p = 0; p < point_count; ++p)
+                    gradients[i][p] = Scalar_(0);
+    }
+
     MultivariatePolynomial operator - () const { return (*this)*Scalar_(-1); }
 
     template <Uint32 DEG>
@@ -238,6 +306,12 @@ struct MultivariatePolynomial<0,BasedVectorSpace_,Scalar_>
 private:
     Scalar_ m_term;
 
+    void evaluate_batch_chunk (Scalar_ const *const *x, Uint32 point_count, Scalar_ *values, Scalar_ *const *gradients) const
+    {
+        for (Uint32 p = 0; p < point_count; ++p)
+            values[p] = m_term;
+    }
+
     //    There is no lower degree possible, so we only need add_eq here.
     MultivariatePolynomial add_eq (MultivariatePolynomial const &other) const { return MultivariatePolynomial(m_term + other.m_term); }
 
@@ -0,0 +1,59 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(BENCHMARK_HPP_)
+#define BENCHMARK_HPP_
+
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "tenh/core.hpp"
+
+namespace Benchmark {
+
+// the result of a benchmarked computation is written here so that the
+// optimizer can't throw the computation away.
+template <typename T>
+T volatile &sink ()
+{
+    static T volatile s;
+    return s;
+}
+
+template <typename T>
+void keep (T const &t)
+{
+    sink<T>() = t;
+}
+
+// calls f() iteration_count times and prints the average time per call, in
+// nanoseconds.  returns that average, so that different approaches to the same
+// computation can be compared.
+template <typename Function_>
+double time_per_call (std::string const &name, Tenh::Uint32 iteration_count, Function_ f)
+{
+    assert(iteration_count > 0 && "iteration_count must be positive");
+    typedef std::chrono::high_resolution_clock Clock;
+    // warm up the caches (and branch predictors) before timing anything
+    for (Tenh::Uint32 i = 0; i < iteration_count / 10 + 1; ++i)
+        f();
+    Clock::time_point start = Clock::now();
+    for (Tenh::Uint32 i = 0; i < iteration_count; ++i)
+        f();
+    Clock::time_point end = Clock::now();
+    double nanoseconds = std::chrono::duration_cast<std::chrono::duration<double,std::nano>>(end - start).count() / iteration_count;
+    std::cout << "    " << std::left << std::setw(48) << name << std::right << std::setw(12) << std::fixed << std::setprecision(2) << nanoseconds << " ns\n";
+    return nanoseconds;
+}
+
+inline void print_speedup (double baseline_nanoseconds, double nanoseconds)
+{
+    std::cout << "    speedup: " << std::fixed << std::setprecision(2) << baseline_nanoseconds / nanoseconds << "x\n";
+}
+
+} // end of namespace Benchmark
+
+#endif // !defined(BENCHMARK_HPP_)
@@ -0,0 +1,136 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_cayley_transform.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares CayleyTransform_t against the way it used to be computed, as
+// products of K_t and N_t which evaluated (and re-evaluated) their values and
+// differentials separately -- the function value against the closed-form 3x3
+// kernel, and the differentials against evaluate_jet, which computes the jets
+// of K, N and J once per point.
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/utility/cayley_transform.hpp"
+
+using namespace Tenh;
+
+typedef BasedVectorSpace_c<VectorSpace_c<RealField,3,Generic>,OrthonormalBasis_c<Generic>> B;
+typedef CayleyTransform_t<B,double> Cayley;
+
+// the previous implementation of CayleyTransform_t, kept here as the baseline
+struct ProductOfKAndN
+{
+    typedef Cayley::V V;
+    typedef Cayley::Out Out;
+    typedef Cayley::D1 D1;
+    typedef Cayley::D2 D2;
+
+    Out function (V const &x) const
+    {
+        AbstractIndex_c<'i'> i;
+        Out retval(Static<WithoutInitialization>::SINGLETON);
+        retval(i).no_alias() = m_K.function(x) * m_N.function(x)(i);
+        return retval;
+    }
+
+    D1 D_function (V const &x) const
+    {
+        AbstractIndex_c<'i'> i;
+        AbstractIndex_c<'j'> j;
+        D1 retval(Static<WithoutInitialization>::SINGLETON);
+        retval(i*j).no_alias() =   m_N.function(x)(i)*m_K.D_function(x)(j)
+                                 + m_K.function(x)*m_N.D_function(x).split(i*j);
+        return retval;
+    }
+
+    D2 D2_function (V const &x) const
+    {
+        AbstractIndex_c<'j'> j;
+        AbstractIndex_c<'k'> k;
+        AbstractIndex_c<'p'> p;
+        AbstractIndex_c<'C'> C;
+        D2 retval(Static<WithoutInitialization>::SINGLETON);
+        retval(C*p).no_alias() =   m_N.function(x)(C)*m_K.D2_function(x)(p)
+                                 + (m_N.D_function(x)(C*k)*m_K.D_function(x)(j)).bundle(j*k,Cayley::Sym2_DualOfV::Concept(),p)
+                                 + (m_K.D_function(x)(k)*m_N.D_function(x)(C*j)).bundle(j*k,Cayley::Sym2_DualOfV::Concept(),p)
+                                 + m_K.function(x)*m_N.D2_function(x)(C*p);
+        return retval;
+    }
+
+private:
+
+    K_t<B,double> m_K;
+    N_t<B,double> m_N;
+};
+
+template <typename T_>
+double max_abs_difference (T_ const &a, T_ const &b)
+{
+    double retval = 0;
+    for (typename T_::ComponentIndex c; c.is_not_at_end(); ++c)
+        retval = std::max(retval, std::abs(a[c] - b[c]));
+    return retval;
+}
+
+int main (int argc, char **argv)
+{
+    static Uint32 const ITERATION_COUNT = 200000;
+    static Uint32 const POINT_COUNT = 16;
+
+    // a spread of points, so that the timings aren't of a single repeated input
+    static_assert(Cayley::V::DIM == 3, "the points are constructed from 3 components");
+    std::vector<Cayley::V> points;
+    for (Uint32 n = 0; n < POINT_COUNT; ++n)
+    {
+        double scale = 1.0 + 0.25*n;
+        points.push_back(Cayley::V(tuple(std::sin(1.0 + 3.0*n) * scale,
+                                         std::sin(2.0 + 3.0*n) * scale,
+                                         std::sin(3.0 + 3.0*n) * scale)));
+    }
+
+    Cayley cayley;
+    ProductOfKAndN baseline;
+    Uint32 n = 0;
+
+    std::cout << "Cayley transform value:\n";
+    double baseline_time = Benchmark::time_per_call("K(x)*N(x)", ITERATION_COUNT, [&]() {
+        Benchmark::keep(baseline.function(points[n++ % POINT_COUNT])[Cayley::Out::ComponentIndex(0)]);
+    });
+    double time = Benchmark::time_per_call("closed-form 3x3 kernel", ITERATION_COUNT, [&]() {
+        Benchmark::keep(cayley.function(points[n++ % POINT_COUNT])[Cayley::Out::ComponentIndex(0)]);
+    });
+    Benchmark::print_speedup(baseline_time, time);
+
+    std::cout << "Cayley transform value, D1 and D2:\n";
+    baseline_time = Benchmark::time_per_call("separate function, D_function, D2_function", ITERATION_COUNT/4, [&]() {
+        Cayley::V const &x = points[n++ % POINT_COUNT];
+        Benchmark::keep(baseline.function(x)[Cayley::Out::ComponentIndex(0)]);
+        Benchmark::keep(baseline.D_function(x)[Cayley::D1::ComponentIndex(0)]);
+        Benchmark::keep(baseline.D2_function(x)[Cayley::D2::ComponentIndex(0)]);
+    });
+    time = Benchmark::time_per_call("evaluate_jet", ITERATION_COUNT/4, [&]() {
+        Cayley::Jet jet(cayley.evaluate_jet(points[n++ % POINT_COUNT]));
+        Benchmark::keep(jet.value[Cayley::Out::ComponentIndex(0)]);
+        Benchmark::keep(jet.D1[Cayley::D1::ComponentIndex(0)]);
+        Benchmark::keep(jet.D2[Cayley::D2::ComponentIndex(0)]);
+    });
+    Benchmark::print_speedup(baseline_time, time);
+
+    // sanity check that the two implementations agree
+    double difference = 0;
+    for (Uint32 m = 0; m < POINT_COUNT; ++m)
+    {
+        Cayley::Jet jet(cayley.evaluate_jet(points[m]));
+        difference = std::max(difference, max_abs_difference(jet.value, baseline.function(points[m])));
+        difference = std::max(difference, max_abs_difference(jet.D1, baseline.D_function(points[m])));
+        difference = std::max(difference, max_abs_difference(jet.D2, baseline.D2_function(points[m])));
+    }
+    std::cout << "    max difference from baseline: " << std::scientific << std::setprecision(3) << difference << '\n';
+    return 0;
+}
@@ -0,0 +1,122 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_homogeneouspolynomial.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares HomogeneousPolynomial evaluation and multiplication against the
+// methods they replaced, which went through full (symmetrized) tensor powers.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "tenh/utility/homogeneouspolynomial.hpp"
+
+using namespace Tenh;
+
+template <typename Array_>
+void randomize_array (Array_ array)
+{
+    for (typename Array_::ComponentIndex i; i.is_not_at_end(); ++i)
+        array[i] = typename Array_::Component(std::rand()) / RAND_MAX;
+}
+
+// the evaluation method used before HomogeneousPolynomial::evaluate used Horner's method
+template <Uint32 DEGREE_, typename BasedVectorSpace_, typename Scalar_>
+Scalar_ evaluate_via_outer_power (HomogeneousPolynomial<DEGREE_,BasedVectorSpace_,Scalar_> const &poly,
+                                  typename HomogeneousPolynomial<DEGREE_,BasedVectorSpace_,Scalar_>::Vector const &at)
+{
+    typedef HomogeneousPolynomial<DEGREE_,BasedVectorSpace_,Scalar_> Polynomial;
+    typedef typename Polynomial::Vector Vector;
+    typedef typename Polynomial::Sym Sym;
+    Sym outer_power(fill_with(1));
+    for (typename Sym::ComponentIndex it; it.is_not_at_end(); ++it)
+    {
+        typename Sym::MultiIndex m = Sym::template bundle_index_map<typename Sym::MultiIndex::IndexTyple, typename Sym::ComponentIndex>(it);
+        for (Uint32 i = 0; i < Sym::MultiIndex::LENGTH; ++i)
+            outer_power[it] *= at[typename Vector::ComponentIndex(m.value_of_index(i, CheckRange::FALSE))];
+        outer_power[it] *= Factorial_t<DEGREE_>::V / (MultiIndexMultiplicity_t<typename Sym::MultiIndex>::eval(m));
+    }
+    AbstractIndex_c<'i'> i;
+    typename Polynomial::SymDual coefficients(poly.coefficients());
+    return coefficients(i)*outer_power(i);
+}
+
+// the multiplication method used before HomogeneousPolynomial::operator* worked on packed storage
+template <Uint32 DEGREE1_, Uint32 DEGREE2_, typename BasedVectorSpace_, typename Scalar_>
+typename HomogeneousPolynomial<DEGREE1_+DEGREE2_,BasedVectorSpace_,Scalar_>::SymDual
+    multiply_via_symmetrization (HomogeneousPolynomial<DEGREE1_,BasedVectorSpace_,Scalar_> const &lhs,
+                                 HomogeneousPolynomial<DEGREE2_,BasedVectorSpace_,Scalar_> const &rhs)
+{
+    typedef typename HomogeneousPolynomial<DEGREE1_+DEGREE2_,BasedVectorSpace_,Scalar_>::SymDual ResultSymDual;
+    typedef typename ResultSymDual::MultiIndex ResultMultiIndex;
+    typedef typename ResultSymDual::ComponentIndex ResultComponentIndex;
+    typedef typename TensorPowerOfBasedVectorSpace_f<DEGREE1_+DEGREE2_,typename DualOf_f<BasedVectorSpace_>::T>::T ResultingTensorPowerType;
+    typedef typename Sym_f<DEGREE1_+DEGREE2_,typename DualOf_f<BasedVectorSpace_>::T,Scalar_>::T SymmetrizeType;
+
+    typename HomogeneousPolynomial<DEGREE1_,BasedVectorSpace_,Scalar_>::SymDual lhs_coefficients(lhs.coefficients());
+    typename HomogeneousPolynomial<DEGREE2_,BasedVectorSpace_,Scalar_>::SymDual rhs_coefficients(rhs.coefficients());
+    SymmetrizeType symmetrize;
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+    AbstractIndex_c<'k'> k;
+    AbstractIndex_c<'I'> I;
+    AbstractIndex_c<'J'> J;
+    AbstractIndex_c<'K'> K;
+
+    ResultSymDual result(Static<WithoutInitialization>::SINGLETON);
+    result(i) = (lhs_coefficients(j).split(j,J)*rhs_coefficients(k).split(k,K))
+                .bundle_with_no_type_check(J*K,ResultingTensorPowerType(),I)*symmetrize(i*I);
+    for (ResultComponentIndex it; it.is_not_at_end(); ++it)
+    {
+        ResultMultiIndex m = ResultSymDual::template bundle_index_map<typename ResultMultiIndex::IndexTyple, ResultComponentIndex>(it);
+        result[it] *= static_cast<Scalar_>(MultiIndexMultiplicity_t<ResultMultiIndex>::eval(m))
+                      / static_cast<Scalar_>(Factorial_t<DEGREE1_+DEGREE2_>::V);
+    }
+    return result;
+}
+
+template <Uint32 DIM_, Uint32 DEGREE1_, Uint32 DEGREE2_, typename Scalar_>
+void benchmark_homogeneous_polynomial (Uint32 iteration_count)
+{
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Generic>,Basis_c<Generic>> BasedVectorSpace;
+    typedef HomogeneousPolynomial<DEGREE1_,BasedVectorSpace,Scalar_> Polynomial1;
+    typedef HomogeneousPolynomial<DEGREE2_,BasedVectorSpace,Scalar_> Polynomial2;
+    typedef typename Polynomial1::Vector Vector;
+
+    std::cout << DIM_ << " variables, degrees " << DEGREE1_ << " and " << DEGREE2_ << ", Scalar = " << type_string_of<Scalar_>() << '\n';
+
+    Polynomial1 p(Static<WithoutInitialization>::SINGLETON);
+    Polynomial2 q(Static<WithoutInitialization>::SINGLETON);
+    Vector v(Static<WithoutInitialization>::SINGLETON);
+    randomize_array(p.as_array());
+    randomize_array(q.as_array());
+    for (typename Vector::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = Scalar_(std::rand()) / RAND_MAX;
+
+    double old_time = Benchmark::time_per_call("evaluate via outer power", iteration_count, [&]() {
+        Benchmark::keep(evaluate_via_outer_power(p, v));
+    });
+    double new_time = Benchmark::time_per_call("evaluate", iteration_count, [&]() {
+        Benchmark::keep(p.evaluate(v));
+    });
+    Benchmark::print_speedup(old_time, new_time);
+
+    // the symmetrization is much slower, so use fewer iterations
+    old_time = Benchmark::time_per_call("multiply via symmetrization", iteration_count / 100 + 1, [&]() {
+        Benchmark::keep(multiply_via_symmetrization(p, q)[typename HomogeneousPolynomial<DEGREE1_+DEGREE2_,BasedVectorSpace,Scalar_>::SymDual::ComponentIndex(0)]);
+    });
+    new_time = Benchmark::time_per_call("operator *", iteration_count / 100 + 1, [&]() {
+        Benchmark::keep((p*q).evaluate(v));
+    });
+    Benchmark::print_speedup(old_time, new_time);
+}
+
+int main (int argc, char **argv)
+{
+    static Uint32 const ITERATION_COUNT = 10000;
+    benchmark_homogeneous_polynomial<3,2,2,double>(ITERATION_COUNT);
+    benchmark_homogeneous_polynomial<4,3,2,double>(ITERATION_COUNT);
+    benchmark_homogeneous_polynomial<6,2,2,double>(ITERATION_COUNT);
+    benchmark_homogeneous_polynomial<6,3,1,float>(ITERATION_COUNT);
+    return 0;
+}
@@ -0,0 +1,295 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_optimization.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares the wall time to convergence of lbfgs_minimize, which uses only the
+// function and its gradient, against minimize, which also uses the Hessian (with
+// each of its line searches), and counts the evaluations of each that were done per solve.  note that minimize
+// stops after a fixed 20 iterations, so on the Rosenbrock function it reports
+// where it got to rather than the time to convergence.  the chained Rosenbrock
+// function is also a sum of squares, so it is solved by levenberg_marquardt too.
+
+#include <cmath>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/utility/functions.hpp"
+#include "tenh/utility/optimization.hpp"
+
+using namespace Tenh;
+
+template <Uint32 DIM_>
+struct Space_f
+{
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Generic>,OrthonormalBasis_c<Generic>> T;
+};
+
+struct EvaluationCounts
+{
+    EvaluationCounts () : function(0), gradient(0), hessian(0) { }
+    Uint32 function;
+    Uint32 gradient;
+    Uint32 hessian;
+};
+
+// f(x) = sum_a cosh(x(a) - a/DIM) + x(a)*A(a*b)*x(b), where A is positive definite,
+// so f is strictly convex.
+template <Uint32 DIM_>
+struct CoshPlusQuadratic
+{
+    typedef typename Space_f<DIM_>::T Space;
+    typedef FunctionObjectType_m<Space,double,double> FunctionObjectType;
+    typedef typename FunctionObjectType::Scalar Scalar;
+    typedef typename FunctionObjectType::V V;
+    typedef typename FunctionObjectType::Out Out;
+    typedef typename FunctionObjectType::D1 D1;
+    typedef typename FunctionObjectType::D2 D2;
+
+    CoshPlusQuadratic ()
+        :
+        m_a(fill_with(Scalar(0.1)))
+    {
+        for (Uint32 a = 0; a < DIM_; ++a)
+            m_a[typename D2::ComponentIndex(sym2_packed_index(a, a))] = Scalar(1);
+    }
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.function;
+        Scalar retval(sym2_quadratic_form(m_a, x));
+        for (typename V::ComponentIndex c; c.is_not_at_end(); ++c)
+            retval += std::cosh(x[c] - Scalar(c.value()) / DIM_);
+        return retval;
+    }
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.gradient;
+        D1 retval(Static<WithoutInitialization>::SINGLETON);
+        sym2_times_vector(m_a, x, retval);
+        for (typename D1::ComponentIndex c; c.is_not_at_end(); ++c)
+            retval[c] = Scalar(2)*retval[c] + std::sinh(x[typename V::ComponentIndex(c.value())] - Scalar(c.value()) / DIM_);
+        return retval;
+    }
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.hessian;
+        D2 retval(Static<WithoutInitialization>::SINGLETON);
+        for (typename D2::ComponentIndex c; c.is_not_at_end(); ++c)
+            retval[c] = Scalar(2)*m_a[c];
+        for (Uint32 a = 0; a < DIM_; ++a)
+            retval[typename D2::ComponentIndex(sym2_packed_index(a, a))] += std::cosh(x[typename V::ComponentIndex(a)] - Scalar(a) / DIM_);
+        return retval;
+    }
+
+    mutable EvaluationCounts m_counts;
+
+private:
+
+    D2 m_a;
+};
+
+// the chained Rosenbrock function, sum_{a < DIM-1} (1 - x(a))^2 + 100*(x(a+1) - x(a)^2)^2,
+// whose minimizer (1,...,1) is at the end of a long, curved valley.
+template <Uint32 DIM_>
+struct ChainedRosenbrock
+{
+    typedef typename Space_f<DIM_>::T Space;
+    typedef FunctionObjectType_m<Space,double,double> FunctionObjectType;
+    typedef typename FunctionObjectType::Scalar Scalar;
+    typedef typename FunctionObjectType::V V;
+    typedef typename FunctionObjectType::Out Out;
+    typedef typename FunctionObjectType::D1 D1;
+    typedef typename FunctionObjectType::D2 D2;
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.function;
+        Scalar retval(0);
+        for (Uint32 a = 0; a+1 < DIM_; ++a)
+        {
+            Scalar x_a = x[typename V::ComponentIndex(a)];
+            Scalar x_b = x[typename V::ComponentIndex(a+1)];
+            retval += sqr(Scalar(1) - x_a) + Scalar(100)*sqr(x_b - x_a*x_a);
+        }
+        return retval;
+    }
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.gradient;
+        D1 retval(fill_with(Scalar(0)));
+        for (Uint32 a = 0; a+1 < DIM_; ++a)
+        {
+            Scalar x_a = x[typename V::ComponentIndex(a)];
+            Scalar x_b = x[typename V::ComponentIndex(a+1)];
+            retval[typename D1::ComponentIndex(a)] += Scalar(-2)*(Scalar(1) - x_a) - Scalar(400)*x_a*(x_b - x_a*x_a);
+            retval[typename D1::ComponentIndex(a+1)] += Scalar(200)*(x_b - x_a*x_a);
+        }
+        return retval;
+    }
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.hessian;
+        D2 retval(fill_with(Scalar(0)));
+        for (Uint32 a = 0; a+1 < DIM_; ++a)
+        {
+            Scalar x_a = x[typename V::ComponentIndex(a)];
+            Scalar x_b = x[typename V::ComponentIndex(a+1)];
+            retval[typename D2::ComponentIndex(sym2_packed_index(a, a))] += Scalar(2) - Scalar(400)*(x_b - Scalar(3)*x_a*x_a);
+            retval[typename D2::ComponentIndex(sym2_packed_index(a+1, a))] += Scalar(-400)*x_a;
+            retval[typename D2::ComponentIndex(sym2_packed_index(a+1, a+1))] += Scalar(200);
+        }
+        return retval;
+    }
+
+    mutable EvaluationCounts m_counts;
+};
+
+// the residuals (1 - x(a), 10*(x(a+1) - x(a)^2)) for a < DIM-1, half the sum of the
+// squares of which is ChainedRosenbrock<DIM_>.
+template <Uint32 DIM_>
+struct ChainedRosenbrockResiduals
+{
+    typedef typename Space_f<DIM_>::T Space;
+    typedef typename Space_f<2*(DIM_-1)>::T ResidualSpace;
+    typedef FunctionObjectType_m<Space,ResidualSpace,double> FunctionObjectType;
+    typedef typename FunctionObjectType::Scalar Scalar;
+    typedef typename FunctionObjectType::Domain Domain;
+    typedef typename FunctionObjectType::CoDomain CoDomain;
+    typedef typename FunctionObjectType::V V;
+    typedef typename FunctionObjectType::Out Out;
+    typedef typename FunctionObjectType::D1 D1;
+    typedef typename FunctionObjectType::D2 D2;
+
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.function;
+        Out retval(Static<WithoutInitialization>::SINGLETON);
+        for (Uint32 a = 0; a+1 < DIM_; ++a)
+        {
+            Scalar x_a = x[typename V::ComponentIndex(a)];
+            Scalar x_b = x[typename V::ComponentIndex(a+1)];
+            retval[typename Out::ComponentIndex(2*a)] = Scalar(1) - x_a;
+            retval[typename Out::ComponentIndex(2*a+1)] = Scalar(10)*(x_b - x_a*x_a);
+        }
+        return retval;
+    }
+    template <typename Derived_, ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Vector_i<Derived_,Scalar,Space,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_counts.gradient;
+        D1 retval(fill_with(Scalar(0)));
+        for (Uint32 a = 0; a+1 < DIM_; ++a)
+        {
+            Scalar x_a = x[typename V::ComponentIndex(a)];
+            retval[typename D1::ComponentIndex(2*a*DIM_ + a)] = Scalar(-1);
+            retval[typename D1::ComponentIndex((2*a+1)*DIM_ + a)] = Scalar(-20)*x_a;
+            retval[typename D1::ComponentIndex((2*a+1)*DIM_ + a+1)] = Scalar(10);
+        }
+        return retval;
+    }
+
+    mutable EvaluationCounts m_counts;
+};
+
+template <typename ObjectiveFunction_>
+void print_result (ObjectiveFunction_ const &f, typename ObjectiveFunction_::V const &x, Uint32 solve_count)
+{
+    typename ObjectiveFunction_::D1 g(f.D_function(x));
+    std::cout << "        function value = " << std::scientific << std::setprecision(3) << f.function(x)
+              << ", norm of gradient = " << std::sqrt(g(AbstractIndex_c<'i'>()).squared_norm())
+              << "\n        evaluations per solve: " << std::fixed << std::setprecision(1)
+              << double(f.m_counts.function) / solve_count << " function, "
+              << double(f.m_counts.gradient) / solve_count << " gradient, "
+              << double(f.m_counts.hessian) / solve_count << " Hessian\n";
+}
+
+template <typename ObjectiveFunction_>
+void benchmark_objective (std::string const &name, typename ObjectiveFunction_::V const &guess, Uint32 iteration_count)
+{
+    typedef typename ObjectiveFunction_::Scalar Scalar;
+    typedef typename ObjectiveFunction_::V V;
+    static Scalar const TOLERANCE = Scalar(1e-6);
+    std::cout << name << '\n';
+
+    ObjectiveFunction_ f;
+    V x(guess);
+    // time_per_call also makes iteration_count/10 + 1 warm-up calls
+    Uint32 solve_count = iteration_count + iteration_count / 10 + 1;
+    double minimize_time = Benchmark::time_per_call("minimize", iteration_count, [&]() {
+        x = minimize<StandardInnerProduct>(f, guess, TOLERANCE);
+        Benchmark::keep(x[typename V::ComponentIndex(0)]);
+    });
+    print_result(f, x, solve_count);
+
+    ObjectiveFunction_ h;
+    MinimizationParameters_t<Scalar> parameters;
+    parameters.line_search_method = LineSearchMethod::STRONG_WOLFE;
+    double time = Benchmark::time_per_call("minimize, strong Wolfe line search", iteration_count, [&]() {
+        x = minimize<StandardInnerProduct>(h, guess, TOLERANCE, parameters);
+        Benchmark::keep(x[typename V::ComponentIndex(0)]);
+    });
+    print_result(h, x, solve_count);
+    Benchmark::print_speedup(minimize_time, time);
+
+    ObjectiveFunction_ g;
+    double lbfgs_time = Benchmark::time_per_call("lbfgs_minimize", iteration_count, [&]() {
+        x = lbfgs_minimize<StandardInnerProduct>(g, guess, TOLERANCE);
+        Benchmark::keep(x[typename V::ComponentIndex(0)]);
+    });
+    print_result(g, x, solve_count);
+    Benchmark::print_speedup(minimize_time, lbfgs_time);
+}
+
+template <Uint32 DIM_>
+void benchmark_least_squares (std::string const &name, typename ChainedRosenbrock<DIM_>::V const &guess, Uint32 iteration_count)
+{
+    typedef typename ChainedRosenbrock<DIM_>::Scalar Scalar;
+    typedef typename ChainedRosenbrock<DIM_>::V V;
+    static Scalar const TOLERANCE = Scalar(1e-6);
+    std::cout << name << '\n';
+
+    V x(guess);
+    Uint32 solve_count = iteration_count + iteration_count / 10 + 1;
+    ChainedRosenbrock<DIM_> f;
+    double lbfgs_time = Benchmark::time_per_call("lbfgs_minimize", iteration_count, [&]() {
+        x = lbfgs_minimize<StandardInnerProduct>(f, guess, TOLERANCE);
+        Benchmark::keep(x[typename V::ComponentIndex(0)]);
+    });
+    print_result(f, x, solve_count);
+
+    // the gradient of half the sum of squares is half that of f
+    ChainedRosenbrockResiduals<DIM_> r;
+    double time = Benchmark::time_per_call("levenberg_marquardt", iteration_count, [&]() {
+        x = levenberg_marquardt<StandardInnerProduct>(r, guess, TOLERANCE / 2);
+        Benchmark::keep(x[typename V::ComponentIndex(0)]);
+    });
+    ChainedRosenbrock<DIM_> g;
+    typename ChainedRosenbrock<DIM_>::D1 gradient(g.D_function(x));
+    std::cout << "        function value = " << std::scientific << std::setprecision(3) << g.function(x)
+              << ", norm of gradient = " << std::sqrt(gradient(AbstractIndex_c<'i'>()).squared_norm())
+              << "\n        evaluations per solve: " << std::fixed << std::setprecision(1)
+              << double(r.m_counts.function) / solve_count << " residual, "
+              << double(r.m_counts.gradient) / solve_count << " Jacobian\n";
+    Benchmark::print_speedup(lbfgs_time, time);
+}
+
+int main (int argc, char **argv)
+{
+    // the progress output would dominate the timings
+    DebugOutputSuppression_t debug_output_suppression(true);
+    static Uint32 const ITERATION_COUNT = 2000;
+    benchmark_objective<CoshPlusQuadratic<6>>("cosh plus quadratic, 6-dimensional", CoshPlusQuadratic<6>::V(fill_with(3.0)), ITERATION_COUNT);
+    benchmark_objective<CoshPlusQuadratic<12>>("cosh plus quadratic, 12-dimensional", CoshPlusQuadratic<12>::V(fill_with(3.0)), ITERATION_COUNT/4);
+    benchmark_objective<ChainedRosenbrock<6>>("chained Rosenbrock, 6-dimensional", ChainedRosenbrock<6>::V(fill_with(-0.5)), ITERATION_COUNT/4);
+    benchmark_least_squares<6>("chained Rosenbrock as least squares, 6-dimensional", ChainedRosenbrock<6>::V(fill_with(-0.5)), ITERATION_COUNT/4);
+    return 0;
+}
@@ -0,0 +1,73 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_polynomial.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares MultivariatePolynomial::evaluate_batch against calling evaluate
+// once per point.
+
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+#include "benchmark.hpp"
+#include "tenh/utility/polynomial.hpp"
+
+using namespace Tenh;
+
+template <Uint32 DIM_, Uint32 DEGREE_, typename Scalar_>
+void benchmark_polynomial (Uint32 point_count, Uint32 iteration_count)
+{
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Generic>,Basis_c<Generic>> BasedVectorSpace;
+    typedef MultivariatePolynomial<DEGREE_,BasedVectorSpace,Scalar_> Polynomial;
+    typedef typename Polynomial::Vector Vector;
+    typedef typename Polynomial::CoefficientArray CoefficientArray;
+
+    std::cout << DIM_ << " variables, degree " << DEGREE_ << ", " << point_count << " points, Scalar = " << type_string_of<Scalar_>() << '\n';
+
+    Polynomial poly(Static<WithoutInitialization>::SINGLETON);
+    CoefficientArray array = poly.as_array();
+    for (typename CoefficientArray::ComponentIndex i; i.is_not_at_end(); ++i)
+        array[i] = Scalar_(std::rand()) / RAND_MAX;
+
+    std::vector<Scalar_> coordinate_storage(DIM_*point_count);
+    std::vector<Scalar_> gradient_storage(DIM_*point_count);
+    std::vector<Scalar_> values(point_count);
+    Scalar_ const *coordinates[DIM_];
+    Scalar_ *gradients[DIM_];
+    for (Uint32 i = 0; i < DIM_; ++i)
+    {
+        coordinates[i] = &coordinate_storage[i*point_count];
+        gradients[i] = &gradient_storage[i*point_count];
+    }
+    for (Uint32 n = 0; n < DIM_*point_count; ++n)
+        coordinate_storage[n] = Scalar_(std::rand()) / RAND_MAX;
+
+    double old_time = Benchmark::time_per_call("evaluate at each point", iteration_count, [&]() {
+        Vector v(Static<WithoutInitialization>::SINGLETON);
+        for (Uint32 p = 0; p < point_count; ++p)
+        {
+            for (typename Vector::ComponentIndex i; i.is_not_at_end(); ++i)
+                v[i] = coordinates[i.value()][p];
+            values[p] = poly.evaluate(v);
+        }
+        Benchmark::keep(values[0]);
+    });
+    double new_time = Benchmark::time_per_call("evaluate_batch", iteration_count, [&]() {
+        poly.evaluate_batch(coordinates, point_count, &values[0]);
+        Benchmark::keep(values[0]);
+    });
+    Benchmark::print_speedup(old_time, new_time);
+    Benchmark::time_per_call("evaluate_batch with gradients", iteration_count, [&]() {
+        poly.evaluate_batch(coordinates, point_count, &values[0], gradients);
+        Benchmark::keep(gradients[0][0]);
+    });
+}
+
+int main (int argc, char **argv)
+{
+    static Uint32 const ITERATION_COUNT = 1000;
+    benchmark_polynomial<3,2,double>(1000, ITERATION_COUNT);
+    benchmark_polynomial<3,4,double>(1000, ITERATION_COUNT);
+    benchmark_polynomial<6,3,float>(1000, ITERATION_COUNT);
+    return 0;
+}
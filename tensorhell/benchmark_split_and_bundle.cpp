@@ -0,0 +1,146 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_split_and_bundle.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares split/bundle expression templates which look up their index maps in
+// precomputed tables against the same expression templates computing their index
+// maps per access (the bundle_index_map function pointer, and vector_index_of and
+// scalar_factor_for_component), which is what they did before the tables were added,
+// and what they still do above MAX_INDEX_TABLE_COMPONENT_COUNT.  the computed path is
+// selected by specializing IndexMapIsTabulated_f for a vector space which is only
+// used here.  splits and bundles of plain tensor products are compared against
+// direct component access.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+
+using namespace Tenh;
+
+// the Id of the vector spaces whose symmetric powers have untabulated index maps
+struct Untabulated { static std::string type_as_string (bool verbose) { return "Untabulated"; } };
+
+namespace Tenh {
+
+template <Uint32 DIM_, Uint32 TABLE_COMPONENT_COUNT_>
+struct IndexMapIsTabulated_f<SymmetricPowerOfBasedVectorSpace_c<3,BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Untabulated>,Basis_c<Generic>>>,
+                             TABLE_COMPONENT_COUNT_>
+{
+    static bool const V = false;
+private:
+    IndexMapIsTabulated_f();
+};
+
+} // end of namespace Tenh
+
+template <typename Vector_>
+void randomize_vector (Vector_ &v)
+{
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = typename Vector_::Scalar(std::rand()) / RAND_MAX;
+}
+
+template <Uint32 DIM_, typename Scalar_, typename Id_>
+struct Spaces_f
+{
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Id_>,Basis_c<Generic>> Factor;
+    typedef SymmetricPowerOfBasedVectorSpace_c<3,Factor> Sym3;
+    typedef TensorProductOfBasedVectorSpaces_c<Typle_t<Factor,Factor,Factor>> TensorProduct;
+    typedef ImplementationOf_t<Sym3,Scalar_> S;
+    typedef ImplementationOf_t<TensorProduct,Scalar_> T;
+};
+
+template <Uint32 DIM_, typename Scalar_, typename Id_>
+double time_split (std::string const &name, Uint32 iteration_count)
+{
+    typedef Spaces_f<DIM_,Scalar_,Id_> Spaces;
+    typename Spaces::S s(Static<WithoutInitialization>::SINGLETON);
+    typename Spaces::T t(Static<WithoutInitialization>::SINGLETON);
+    randomize_vector(s);
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+    AbstractIndex_c<'k'> k;
+    return Benchmark::time_per_call(name, iteration_count, [&]() {
+        t(i*j*k).no_alias() = s.split(i*j*k);
+        Benchmark::keep(t[typename Spaces::T::ComponentIndex(1)]);
+    });
+}
+
+template <Uint32 DIM_, typename Scalar_, typename Id_>
+double time_bundle (std::string const &name, Uint32 iteration_count)
+{
+    typedef Spaces_f<DIM_,Scalar_,Id_> Spaces;
+    typename Spaces::S s(Static<WithoutInitialization>::SINGLETON);
+    typename Spaces::T t(Static<WithoutInitialization>::SINGLETON);
+    randomize_vector(t);
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+    AbstractIndex_c<'k'> k;
+    AbstractIndex_c<'p'> p;
+    return Benchmark::time_per_call(name, iteration_count, [&]() {
+        s(p).no_alias() = t(i*j*k).bundle(i*j*k,typename Spaces::Sym3(),p);
+        Benchmark::keep(s[typename Spaces::S::ComponentIndex(1)]);
+    });
+}
+
+template <Uint32 DIM_, typename Scalar_>
+void benchmark_split_and_bundle (Uint32 iteration_count)
+{
+    typedef Spaces_f<DIM_,Scalar_,Generic> Spaces;
+    typedef typename Spaces::TensorProduct TensorProduct;
+    typedef typename Spaces::T T;
+
+    static_assert(IndexMapIsTabulated_f<typename Spaces::Sym3,T::DIM>::V, "should be tabulated");
+    static_assert(!IndexMapIsTabulated_f<typename Spaces_f<DIM_,Scalar_,Untabulated>::Sym3,T::DIM>::V, "should not be tabulated");
+
+    std::cout << "Sym^3 of " << DIM_ << "-dimensional space, Scalar = " << type_string_of<Scalar_>() << '\n';
+
+    double computed_time = time_split<DIM_,Scalar_,Untabulated>("t(i*j*k) = s.split(i*j*k), computed", iteration_count);
+    double table_time = time_split<DIM_,Scalar_,Generic>("t(i*j*k) = s.split(i*j*k), tabulated", iteration_count);
+    Benchmark::print_speedup(computed_time, table_time);
+
+    computed_time = time_bundle<DIM_,Scalar_,Untabulated>("s(p) = t(i*j*k).bundle(i*j*k,Sym3,p), computed", iteration_count);
+    table_time = time_bundle<DIM_,Scalar_,Generic>("s(p) = t(i*j*k).bundle(i*j*k,Sym3,p), tabulated", iteration_count);
+    Benchmark::print_speedup(computed_time, table_time);
+
+    T t(Static<WithoutInitialization>::SINGLETON);
+    T u(Static<WithoutInitialization>::SINGLETON);
+    randomize_vector(t);
+
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+    AbstractIndex_c<'k'> k;
+    AbstractIndex_c<'p'> p;
+
+    // splitting and bundling a tensor product is a reinterpretation of the component index,
+    // so it should cost the same as accessing the components directly.
+    double direct_time = Benchmark::time_per_call("componentwise copy", iteration_count, [&]() {
+        for (typename T::ComponentIndex c; c.is_not_at_end(); ++c)
+            u[c] = t[c];
+        Benchmark::keep(u[typename T::ComponentIndex(1)]);
+    });
+    double split_time = Benchmark::time_per_call("u(i*j*k) = t.split(i*j*k)", iteration_count, [&]() {
+        u(i*j*k).no_alias() = t.split(i*j*k);
+        Benchmark::keep(u[typename T::ComponentIndex(1)]);
+    });
+    Benchmark::print_speedup(direct_time, split_time);
+
+    // the round trip from test_split_and_bundle
+    Benchmark::time_per_call("u(p) = t(p) - t.split(i*j*k).bundle(i*j*k,TensorProduct,p)", iteration_count, [&]() {
+        u(p).no_alias() = t(p) - t.split(i*j*k).bundle(i*j*k,TensorProduct(),p);
+        Benchmark::keep(u[typename T::ComponentIndex(1)]);
+    });
+}
+
+int main (int argc, char **argv)
+{
+    static Uint32 const ITERATION_COUNT = 100000;
+    benchmark_split_and_bundle<3,double>(ITERATION_COUNT);
+    benchmark_split_and_bundle<6,double>(ITERATION_COUNT/4);
+    benchmark_split_and_bundle<6,float>(ITERATION_COUNT/4);
+    return 0;
+}
@@ -0,0 +1,136 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_summation.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares the throughput and accuracy of the summation policies (see
+// tenh/summationpolicy.hpp) on a long matrix-vector contraction, a(i*j)*x(j),
+// with float storage against naive summation with double storage.
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/summationpolicy.hpp"
+
+using namespace Tenh;
+
+template <Uint32 DIM_>
+struct Spaces_f
+{
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Generic>,Basis_c<Generic>> B;
+    typedef typename DualOf_f<B>::T DualOfB;
+    typedef TensorProductOfBasedVectorSpaces_c<Typle_t<B,DualOfB>> Operator;
+};
+
+// evaluates y(i) = a(i*j)*x(j), accumulating the terms using SummationPolicy_.
+template <typename SummationPolicy_, typename Operator_, typename Vector_>
+void contract (Operator_ const &a, Vector_ const &x, Vector_ &y)
+{
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+    y(i).no_alias() = (a(i*j)*x(j)).template summed_using<SummationPolicy_>();
+}
+
+template <typename Vector_, typename Reference_>
+void print_max_relative_error (Vector_ const &y, Reference_ const &reference)
+{
+    double max_relative_error = 0.0;
+    for (typename Vector_::ComponentIndex c; c.is_not_at_end(); ++c)
+    {
+        double r = double(reference[typename Reference_::ComponentIndex(c.value(), CheckRange::FALSE)]);
+        max_relative_error = std::max(max_relative_error, std::abs(double(y[c]) - r) / std::abs(r));
+    }
+    std::cout << "        max relative error: " << std::scientific << std::setprecision(2) << max_relative_error << '\n';
+}
+
+template <Uint32 DIM_>
+void benchmark_summation (Uint32 iteration_count)
+{
+    typedef typename Spaces_f<DIM_>::B B;
+    typedef typename Spaces_f<DIM_>::Operator Operator;
+    typedef ImplementationOf_t<Operator,float> FloatOperator;
+    typedef ImplementationOf_t<B,float> FloatVector;
+    typedef ImplementationOf_t<Operator,double> DoubleOperator;
+    typedef ImplementationOf_t<B,double> DoubleVector;
+    typedef ImplementationOf_t<B,long double> LongDoubleVector;
+
+    std::cout << "a(i*j)*x(j) with " << DIM_ << "-dimensional space\n";
+
+    FloatOperator *a = new FloatOperator(Static<WithoutInitialization>::SINGLETON);
+    DoubleOperator *a_double = new DoubleOperator(Static<WithoutInitialization>::SINGLETON);
+    FloatVector x(Static<WithoutInitialization>::SINGLETON);
+    FloatVector y(Static<WithoutInitialization>::SINGLETON);
+    DoubleVector x_double(Static<WithoutInitialization>::SINGLETON);
+    DoubleVector y_double(Static<WithoutInitialization>::SINGLETON);
+    LongDoubleVector reference(Static<WithoutInitialization>::SINGLETON);
+    // positive components, so the relative error is meaningful
+    for (typename FloatOperator::ComponentIndex c; c.is_not_at_end(); ++c)
+    {
+        (*a)[c] = float(std::rand()) / RAND_MAX;
+        (*a_double)[typename DoubleOperator::ComponentIndex(c.value())] = (*a)[c];
+    }
+    for (typename FloatVector::ComponentIndex c; c.is_not_at_end(); ++c)
+    {
+        x[c] = float(std::rand()) / RAND_MAX;
+        x_double[typename DoubleVector::ComponentIndex(c.value())] = x[c];
+    }
+    // the exact products of the float components, summed in long double
+    for (typename LongDoubleVector::ComponentIndex c; c.is_not_at_end(); ++c)
+    {
+        long double sum = 0;
+        for (Uint32 k = 0; k < DIM_; ++k)
+            sum += (long double)((*a)[typename FloatOperator::ComponentIndex(c.value()*DIM_ + k)]) *
+                   (long double)(x[typename FloatVector::ComponentIndex(k)]);
+        reference[c] = sum;
+    }
+
+    double baseline_time = Benchmark::time_per_call("double storage, NaiveSummation", iteration_count, [&]() {
+        contract<NaiveSummation>(*a_double, x_double, y_double);
+        Benchmark::keep(y_double[typename DoubleVector::ComponentIndex(1)]);
+    });
+    print_max_relative_error(y_double, reference);
+
+    double time = Benchmark::time_per_call("float storage, NaiveSummation", iteration_count, [&]() {
+        contract<NaiveSummation>(*a, x, y);
+        Benchmark::keep(y[typename FloatVector::ComponentIndex(1)]);
+    });
+    print_max_relative_error(y, reference);
+    Benchmark::print_speedup(baseline_time, time);
+
+    time = Benchmark::time_per_call("float storage, PairwiseSummation", iteration_count, [&]() {
+        contract<PairwiseSummation>(*a, x, y);
+        Benchmark::keep(y[typename FloatVector::ComponentIndex(1)]);
+    });
+    print_max_relative_error(y, reference);
+    Benchmark::print_speedup(baseline_time, time);
+
+    time = Benchmark::time_per_call("float storage, KahanSummation", iteration_count, [&]() {
+        contract<KahanSummation>(*a, x, y);
+        Benchmark::keep(y[typename FloatVector::ComponentIndex(1)]);
+    });
+    print_max_relative_error(y, reference);
+    Benchmark::print_speedup(baseline_time, time);
+
+    time = Benchmark::time_per_call("float storage, WideAccumulatorSummation", iteration_count, [&]() {
+        contract<WideAccumulatorSummation>(*a, x, y);
+        Benchmark::keep(y[typename FloatVector::ComponentIndex(1)]);
+    });
+    print_max_relative_error(y, reference);
+    Benchmark::print_speedup(baseline_time, time);
+
+    delete a;
+    delete a_double;
+}
+
+int main (int argc, char **argv)
+{
+    static Uint32 const ITERATION_COUNT = 2000;
+    benchmark_summation<64>(ITERATION_COUNT*16);
+    benchmark_summation<256>(ITERATION_COUNT);
+    benchmark_summation<1024>(ITERATION_COUNT/16);
+    return 0;
+}
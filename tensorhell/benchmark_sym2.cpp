@@ -0,0 +1,93 @@
+// ///////////////////////////////////////////////////////////////////////////
+// benchmark_sym2.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+// compares the packed-storage kernels for symmetric 2-tensors against the
+// equivalent split(i*j) expression templates.
+
+#include <cstdlib>
+#include <iostream>
+
+#include "benchmark.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+
+using namespace Tenh;
+
+template <typename Vector_>
+void randomize_vector (Vector_ &v)
+{
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = typename Vector_::Scalar(std::rand()) / RAND_MAX;
+}
+
+template <Uint32 DIM_, typename Scalar_>
+void benchmark_sym2 (Uint32 iteration_count)
+{
+    typedef BasedVectorSpace_c<VectorSpace_c<RealField,DIM_,Generic>,Basis_c<Generic>> Factor;
+    typedef typename DualOf_f<Factor>::T DualOfFactor;
+    typedef ImplementationOf_t<SymmetricPowerOfBasedVectorSpace_c<2,Factor>,Scalar_> S;
+    typedef ImplementationOf_t<Factor,Scalar_> U;
+    typedef ImplementationOf_t<DualOfFactor,Scalar_> V;
+
+    std::cout << "Sym^2 of " << DIM_ << "-dimensional space, Scalar = " << type_string_of<Scalar_>() << '\n';
+
+    S s(Static<WithoutInitialization>::SINGLETON);
+    U u(Static<WithoutInitialization>::SINGLETON);
+    U out(Static<WithoutInitialization>::SINGLETON);
+    V v(Static<WithoutInitialization>::SINGLETON);
+    randomize_vector(s);
+    randomize_vector(u);
+    randomize_vector(v);
+
+    AbstractIndex_c<'i'> i;
+    AbstractIndex_c<'j'> j;
+    AbstractIndex_c<'p'> p;
+
+    double split_time = Benchmark::time_per_call("split(i*j)*v(j)", iteration_count, [&]() {
+        out(i).no_alias() = s.split(i*j)*v(j);
+        Benchmark::keep(out[typename U::ComponentIndex(0)]);
+    });
+    double packed_time = Benchmark::time_per_call("sym2_times_vector", iteration_count, [&]() {
+        sym2_times_vector(s, v, out);
+        Benchmark::keep(out[typename U::ComponentIndex(0)]);
+    });
+    Benchmark::print_speedup(split_time, packed_time);
+
+    split_time = Benchmark::time_per_call("v(i)*split(i*j)*v(j)", iteration_count, [&]() {
+        Benchmark::keep(Scalar_(v(i)*s.split(i*j)*v(j)));
+    });
+    Benchmark::time_per_call("s(v, v)", iteration_count, [&]() {
+        Benchmark::keep(s(v, v));
+    });
+    packed_time = Benchmark::time_per_call("sym2_quadratic_form", iteration_count, [&]() {
+        Benchmark::keep(sym2_quadratic_form(s, v));
+    });
+    Benchmark::print_speedup(split_time, packed_time);
+
+    // the split path for the update has to go through a full 2-tensor and bundle back
+    typedef ImplementationOf_t<TensorProductOfBasedVectorSpaces_c<Typle_t<Factor,Factor>>,Scalar_> Matrix;
+    Matrix m(Static<WithoutInitialization>::SINGLETON);
+    Scalar_ const alpha(Scalar_(1)/1000);
+    split_time = Benchmark::time_per_call("rank 1 update via split/bundle", iteration_count, [&]() {
+        m(i*j).no_alias() = s.split(i*j) + alpha*u(i)*u(j);
+        s(p).no_alias() = m(i*j).bundle(i*j,SymmetricPowerOfBasedVectorSpace_c<2,Factor>(),p);
+        Benchmark::keep(s[typename S::ComponentIndex(0)]);
+    });
+    packed_time = Benchmark::time_per_call("sym2_rank1_update", iteration_count, [&]() {
+        sym2_rank1_update(s, alpha, u);
+        Benchmark::keep(s[typename S::ComponentIndex(0)]);
+    });
+    Benchmark::print_speedup(split_time, packed_time);
+}
+
+int main (int argc, char **argv)
+{
+    static Uint32 const ITERATION_COUNT = 100000;
+    benchmark_sym2<3,double>(ITERATION_COUNT);
+    benchmark_sym2<6,double>(ITERATION_COUNT);
+    benchmark_sym2<12,double>(ITERATION_COUNT/4);
+    benchmark_sym2<12,float>(ITERATION_COUNT/4);
+    return 0;
+}
@@ -6,11 +6,17 @@
 #include "test.hpp"
 
 #include "test_abstractindex.hpp"
+#include "test_aliasing.hpp"
 #include "test_array.hpp"
+#include "test_automaticdifferentiation.hpp"
 #include "test_basic_operator.hpp"
 #include "test_basic_vector.hpp"
+#include "test_cayleytransform.hpp"
 #include "test_dimindex.hpp"
+#include "test_directsum.hpp"
+#include "test_expressiontemplate_plan.hpp"
 #include "test_expressiontemplate_reindex.hpp"
+#include "test_functions.hpp"
 #include "test_homogeneouspolynomials.hpp"
 // #include "test_euclideanembedding.hpp"
 // #include "test_euclideanembeddinginverse.hpp"
@@ -18,10 +24,14 @@
 // #include "test_interop_eigen_inversion.hpp"
 // #include "test_interop_eigen_ldlt.hpp"
 #include "test_linearembedding.hpp"
+#include "test_memoize.hpp"
 #include "test_multivariatepolynomials.hpp"
+#include "test_optimization.hpp"
+#include "test_reduction.hpp"
 #include "test_split_and_bundle.hpp"
 #include "test_tuple.hpp"
 #include "test_typle.hpp"
+#include "test_vee.hpp"
 // #include "test_tensor2.hpp"
 // #include "test_tensor2diagonal.hpp"
 // #include "test_expressiontemplates.hpp"
@@ -39,7 +49,9 @@ int main (int argc, char **argv, char **envp)
     Directory root;
 
     Test::AbstractIndex::AddTests(root);
+    Test::Aliasing::AddTests(root);
     Test::Array::AddTests(root);
+    Test::AutomaticDifferentiation::AddTests(root);
 
     {
         Directory &basic_dir = root.GetSubDirectory("basic");
@@ -57,8 +69,13 @@ int main (int argc, char **argv, char **envp)
         Test::Basic::Vector::AddTests5(basic_dir);
     }
 
+    Test::CayleyTransform::AddTests(root);
+
     Test::DimIndex::AddTests(root);
+    Test::DirectSum::AddTests(root);
+    Test::ExpressionTemplate_Plan::AddTests(root);
     Test::ExpressionTemplate_Reindex::AddTests(root);
+    Test::Functions::AddTests(root);
     {
         Test::HomogeneousPolynomials::AddTests0(root);
         Test::HomogeneousPolynomials::AddTests1(root);
@@ -85,6 +102,7 @@ int main (int argc, char **argv, char **envp)
         Test::LinearEmbedding::AddTests4(root);
         Test::LinearEmbedding::AddTests5(root);
     }
+    Test::Memoize::AddTests(root);
     {
         Test::MultivariatePolynomials::AddTests0(root);
         Test::MultivariatePolynomials::AddTests1(root);
@@ -93,9 +111,12 @@ int main (int argc, char **argv, char **envp)
         Test::MultivariatePolynomials::AddTests4(root);
         Test::MultivariatePolynomials::AddTests5(root);
     }
+    Test::Optimization::AddTests(root);
+    Test::Reduction::AddTests(root);
     Test::SplitAndBundle::AddTests(root);
     Test::Tuple::AddTests(root);
     Test::Typle::AddTests(root);
+    Test::Vee::AddTests(root);
 //     Test::Tensor2::AddTests(root);
 //     Test::Tensor2Diagonal::AddTests(root);
 
@@ -0,0 +1,153 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_aliasing.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_aliasing.hpp"
+
+#include <type_traits>
+
+#include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace Aliasing {
+
+typedef double Scalar;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B;
+typedef Tenh::DualOf_f<B>::T DualOfB;
+typedef Tenh::ImplementationOf_t<B,Scalar> V;
+typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,DualOfB>>,Scalar> Operator;
+typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,B>>,Scalar> T;
+// large enough that the temporary for an aliased assignment goes on the heap
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,40,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B40;
+typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B40,B40>>,Scalar> T40;
+
+template <typename Vector_>
+void fill_with_distinct_values (Vector_ &v, Scalar offset)
+{
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = offset + Scalar(i.value()*i.value()) / Scalar(3);
+}
+
+// runs the aliasing analysis that the assignment operators use for destination(...) = expression
+template <typename Destination_, typename Expression_>
+bool is_safe_in_place (Destination_ const &destination, Expression_ const &expression)
+{
+    typedef typename std::decay<decltype(destination.object())>::type Object;
+    Tenh::AliasingDestination_t aliasing_destination(destination.object());
+    return Tenh::ElementwiseAliasing_t<Expression_,
+                                       Object,
+                                       typename Destination_::FreeFactorTyple,
+                                       typename Destination_::FreeDimIndexTyple>::is_safe(expression, aliasing_destination);
+}
+
+void test_analysis (Context const &context)
+{
+    V x(Tenh::fill_with(Scalar(1)));
+    V y(Tenh::fill_with(Scalar(2)));
+    Operator a(Tenh::fill_with(Scalar(3)));
+    T t(Tenh::fill_with(Scalar(4)));
+    T u(Tenh::fill_with(Scalar(5)));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+
+    // elementwise-identical access is safe
+    assert(is_safe_in_place(x(i), x(i)));
+    assert(is_safe_in_place(x(i), Scalar(2)*x(i) + y(i)));
+    assert(is_safe_in_place(x(i), x(i) - x(i)/Scalar(2)));
+    assert(is_safe_in_place(t(i*j), t(i*j) + u(j*i)));
+    assert(is_safe_in_place(t(i*j), t(i*j)*(x(k)*y(k))));
+    // permuting and summing access is not
+    assert(!is_safe_in_place(x(i), a(i*j)*x(j)));
+    assert(!is_safe_in_place(t(i*j), t(j*i)));
+    assert(!is_safe_in_place(t(i*j), t(i*j) + t(j*i)));
+    // other objects' memory doesn't matter
+    assert(is_safe_in_place(x(i), a(i*j)*y(j)));
+}
+
+void test_elementwise_update (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V y(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V x_original(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar(1));
+    fill_with_distinct_values(y, Scalar(-2));
+    fill_with_distinct_values(x_original, Scalar(1));
+
+    Tenh::AbstractIndex_c<'i'> i;
+
+    x(i) = Scalar(2)*x(i) + y(i);
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], Scalar(2)*x_original[c] + y[c]);
+
+    x(i) += x(i);
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], Scalar(2)*(Scalar(2)*x_original[c] + y[c]));
+}
+
+void test_contraction (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-4));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    expected(i).no_alias() = a(i*j)*x(j);
+    x(i) = a(i*j)*x(j);
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], expected[c]);
+
+    expected(i).no_alias() = x(i) - a(i*j)*x(j);
+    x(i) -= a(i*j)*x(j);
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], expected[c]);
+}
+
+template <typename T_>
+void test_transpose (Context const &context)
+{
+    T_ t(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    T_ t_original(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(t, Scalar(0));
+    fill_with_distinct_values(t_original, Scalar(0));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    t(i*j) = t(j*i);
+    for (typename T_::MultiIndex m; m.is_not_at_end(); ++m)
+        assert_eq(t[m], t_original[typename T_::MultiIndex(m.template el<1>(), m.template el<0>())]);
+
+    t(i*j) += t(j*i);
+    for (typename T_::MultiIndex m; m.is_not_at_end(); ++m)
+        assert_eq(t[m], t_original[typename T_::MultiIndex(m.template el<1>(), m.template el<0>())] + t_original[m]);
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("aliasing");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_analysis, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_elementwise_update, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_contraction, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "transpose", test_transpose<T>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "transpose_with_heap_temporary", test_transpose<T40>, RESULT_NO_ERROR);
+}
+
+} // end of namespace Aliasing
+} // end of namespace Test
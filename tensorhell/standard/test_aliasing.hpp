@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_aliasing.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_ALIASING_HPP_)
+#define TEST_ALIASING_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace Aliasing {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace Aliasing
+} // end of namespace Test
+
+#endif // !defined(TEST_ALIASING_HPP_)
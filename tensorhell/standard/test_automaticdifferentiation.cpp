@@ -0,0 +1,203 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_automaticdifferentiation.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_automaticdifferentiation.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/utility/automaticdifferentiation.hpp"
+#include "tenh/utility/optimization.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace AutomaticDifferentiation {
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> B;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> Plane;
+
+typedef Tenh::Dual_t<double,1> Dual;
+typedef Tenh::HyperDual_t<double,1> HyperDual;
+
+// the derivatives are computed by different (but equivalent) formulas than the
+// expected values, so they're only equal up to roundoff.
+void verify_close (Context const &context, double actual, double expected)
+{
+    assert_leq(std::abs(actual - expected), 1e-13 * std::max(1.0, std::abs(expected)));
+}
+
+void verify_unary (Context const &context, Dual const &d, HyperDual const &h, double g, double dg, double d2g)
+{
+    verify_close(context, d.value(), g);
+    verify_close(context, d.derivative(0), dg);
+    verify_close(context, h.value(), g);
+    verify_close(context, h.derivative(0), dg);
+    verify_close(context, h.second_derivative(0, 0), d2g);
+}
+
+void test_elementary_functions (Context const &context)
+{
+    double x = 0.7;
+    Dual d(Dual::variable(x, 0));
+    HyperDual h(HyperDual::variable(x, 0));
+
+    verify_unary(context, sqrt(d), sqrt(h), std::sqrt(x), 0.5/std::sqrt(x), -0.25/(x*std::sqrt(x)));
+    verify_unary(context, exp(d), exp(h), std::exp(x), std::exp(x), std::exp(x));
+    verify_unary(context, log(d), log(h), std::log(x), 1/x, -1/(x*x));
+    verify_unary(context, pow(d, 2.5), pow(h, 2.5), std::pow(x, 2.5), 2.5*std::pow(x, 1.5), 3.75*std::pow(x, 0.5));
+    // integral powers are well-defined at zero
+    Dual d0(Dual::variable(0.0, 0));
+    HyperDual h0(HyperDual::variable(0.0, 0));
+    verify_unary(context, pow(d0, 0.0), pow(h0, 0.0), 1, 0, 0);
+    verify_unary(context, pow(d0, 1.0), pow(h0, 1.0), 0, 1, 0);
+    verify_unary(context, pow(d0, 2.0), pow(h0, 2.0), 0, 0, 2);
+    verify_unary(context, sin(d), sin(h), std::sin(x), std::cos(x), -std::sin(x));
+    verify_unary(context, cos(d), cos(h), std::cos(x), -std::sin(x), -std::cos(x));
+    verify_unary(context, sinh(d), sinh(h), std::sinh(x), std::cosh(x), std::sinh(x));
+    verify_unary(context, cosh(d), cosh(h), std::cosh(x), std::sinh(x), std::cosh(x));
+    verify_unary(context, atan(d), atan(h), std::atan(x), 1/(1+x*x), -2*x/((1+x*x)*(1+x*x)));
+    verify_unary(context, abs(-d), abs(-h), x, 1, 0);
+    // arithmetic, including mixing with constants
+    verify_unary(context, 3.0/d, 3.0/h, 3/x, -3/(x*x), 6/(x*x*x));
+    verify_unary(context, d/(1.0+d), h/(1.0+h), x/(1+x), 1/((1+x)*(1+x)), -2/((1+x)*(1+x)*(1+x)));
+    verify_unary(context, 2.0 - d*d*d, 2.0 - h*h*h, 2 - x*x*x, -3*x*x, -6*x);
+    verify_unary(context, Tenh::sqr(d) - 4.0*d, Tenh::sqr(h) - 4.0*h, x*x - 4*x, 2*x - 4, 2);
+    // comparisons are of the values only
+    assert(d < Dual(1));
+    assert(h > 0.5);
+    assert(d == Dual(x));
+}
+
+// f(x) = x0^2*x1 + x1*x2^3 - x0/x2, written generically in the scalar type.
+struct Polynomial
+{
+    template <typename Derived_, typename S_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    S_ function (Tenh::Vector_i<Derived_,S_,B,COMPONENT_QUALIFIER_> const &x) const
+    {
+        typedef Tenh::ComponentIndex_t<3> C;
+        S_ x0(x[C(0)]);
+        S_ x1(x[C(1)]);
+        S_ x2(x[C(2)]);
+        return x0*x0*x1 + x1*x2*x2*x2 - x0/x2;
+    }
+};
+
+void test_derived_differentials (Context const &context)
+{
+    typedef Tenh::AutomaticallyDifferentiated_t<Polynomial,B,double> F;
+    typedef Tenh::ComponentIndex_t<3> C;
+    F f;
+    F::V x(Tenh::tuple(1.5, -0.5, 2.0));
+    double x0 = x[C(0)];
+    double x1 = x[C(1)];
+    double x2 = x[C(2)];
+
+    verify_close(context, f.function(x), x0*x0*x1 + x1*x2*x2*x2 - x0/x2);
+
+    F::D1 expected_d1(Tenh::tuple(2*x0*x1 - 1/x2, x0*x0 + x2*x2*x2, 3*x1*x2*x2 + x0/(x2*x2)));
+    F::D1 d1(f.D_function(x));
+    for (F::D1::ComponentIndex c; c.is_not_at_end(); ++c)
+        verify_close(context, d1[c], expected_d1[c]);
+
+    double expected_d2[3][3] = {
+        { 2*x1,         2*x0,     1/(x2*x2)                 },
+        { 2*x0,         0,        3*x2*x2                   },
+        { 1/(x2*x2),    3*x2*x2,  6*x1*x2 - 2*x0/(x2*x2*x2) }
+    };
+    F::D2 d2(f.D2_function(x));
+    for (Tenh::Uint32 a = 0; a < 3; ++a)
+        for (Tenh::Uint32 b = 0; b <= a; ++b)
+            verify_close(context, d2[F::D2::ComponentIndex(Tenh::sym2_packed_index(a, b))], expected_d2[a][b]);
+}
+
+// f(x) = exp(x0)*x(i)*x(i), which exercises Dual_t and HyperDual_t as the scalar
+// type of expression templates.
+struct ExpTimesSquaredNorm
+{
+    template <typename Derived_, typename S_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    S_ function (Tenh::Vector_i<Derived_,S_,B,COMPONENT_QUALIFIER_> const &x) const
+    {
+        using std::exp;
+        Tenh::AbstractIndex_c<'i'> i;
+        S_ squared_norm(x(i).squared_norm());
+        return exp(x[Tenh::ComponentIndex_t<3>(0)]) * squared_norm;
+    }
+};
+
+void test_expression_templates (Context const &context)
+{
+    typedef Tenh::AutomaticallyDifferentiated_t<ExpTimesSquaredNorm,B,double> F;
+    F f;
+    F::V x(Tenh::tuple(0.25, -1.0, 0.5));
+    double e = std::exp(x[F::V::ComponentIndex(0)]);
+    double r2 = 0;
+    for (F::V::ComponentIndex c; c.is_not_at_end(); ++c)
+        r2 += x[c]*x[c];
+
+    F::D1 d1(f.D_function(x));
+    F::D2 d2(f.D2_function(x));
+    for (Tenh::Uint32 a = 0; a < 3; ++a)
+    {
+        double x_a = x[F::V::ComponentIndex(a)];
+        verify_close(context, d1[F::D1::ComponentIndex(a)], e*(2*x_a + (a == 0 ? r2 : 0)));
+        for (Tenh::Uint32 b = 0; b <= a; ++b)
+        {
+            double x_b = x[F::V::ComponentIndex(b)];
+            // d/dx_b of e*(2*x_a + delta_a0*r2)
+            double expected = e*((a == b ? 2 : 0) + (a == 0 ? 2*x_b : 0) + (b == 0 ? 2*x_a + (a == 0 ? r2 : 0) : 0));
+            verify_close(context, d2[F::D2::ComponentIndex(Tenh::sym2_packed_index(a, b))], expected);
+        }
+    }
+}
+
+// the Rosenbrock function, written generically in the scalar type.
+struct Rosenbrock
+{
+    template <typename Derived_, typename S_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    S_ function (Tenh::Vector_i<Derived_,S_,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        typedef Tenh::ComponentIndex_t<2> C;
+        S_ x(v[C(0)]);
+        S_ y(v[C(1)]);
+        return Tenh::sqr(1.0 - x) + 100.0*Tenh::sqr(y - x*x);
+    }
+};
+
+void test_minimize (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef Tenh::AutomaticallyDifferentiated_t<Rosenbrock,Plane,double> F;
+    F f;
+    F::V guess(Tenh::tuple(-1.2, 1.0));
+    Tenh::MinimizationParameters_t<double> parameters;
+    parameters.line_search_method = Tenh::LineSearchMethod::STRONG_WOLFE;
+    parameters.max_iteration_count = 100;
+    Tenh::MinimizationStatistics_t<double> statistics;
+    F::V x(Tenh::minimize<Tenh::StandardInnerProduct>(f, guess, 1e-10, parameters, &statistics));
+    assert(statistics.tolerance_was_attained);
+    assert_lt(std::abs(x[F::V::ComponentIndex(0)] - 1.0), 1e-8);
+    assert_lt(std::abs(x[F::V::ComponentIndex(1)] - 1.0), 1e-8);
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("automaticdifferentiation");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_elementary_functions, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_derived_differentials, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_expression_templates, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_minimize, RESULT_NO_ERROR);
+}
+
+} // end of namespace AutomaticDifferentiation
+} // end of namespace Test
@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_automaticdifferentiation.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_AUTOMATICDIFFERENTIATION_HPP_)
+#define TEST_AUTOMATICDIFFERENTIATION_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace AutomaticDifferentiation {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace AutomaticDifferentiation
+} // end of namespace Test
+
+#endif // !defined(TEST_AUTOMATICDIFFERENTIATION_HPP_)
@@ -0,0 +1,147 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_cayleytransform.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_cayleytransform.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/utility/cayley_transform.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace CayleyTransform {
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> B;
+typedef Tenh::CayleyTransform_t<B,double> Cayley;
+typedef Tenh::K_t<B,double> K;
+typedef Tenh::N_t<B,double> N;
+
+// the jets and closed-form kernel are computed by different (but equivalent)
+// formulas than the references, so they're only equal up to roundoff.
+template <typename T_>
+void verify_components_close (Context const &context, T_ const &actual, T_ const &expected)
+{
+    for (typename T_::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_leq(std::abs(actual[c] - expected[c]), 1e-14 * std::max(1.0, std::abs(expected[c])));
+}
+
+void verify_close (Context const &context, double actual, double expected)
+{
+    assert_leq(std::abs(actual - expected), 1e-14 * std::max(1.0, std::abs(expected)));
+}
+
+Cayley::V point (Tenh::Uint32 n)
+{
+    // a few points, including the origin and some far from it
+    double const components[][3] = {
+        {  0.0,  0.0,   0.0 },
+        {  0.1, -0.2,   0.3 },
+        { -1.5,  0.25,  2.0 },
+        { 10.0, -7.0,  -3.0 }
+    };
+    return Cayley::V(Tenh::tuple(components[n][0], components[n][1], components[n][2]));
+}
+
+static Tenh::Uint32 const POINT_COUNT = 4;
+
+void test_closed_form_function (Context const &context)
+{
+    Tenh::AbstractIndex_c<'i'> i;
+    Cayley cayley;
+    K k_function;
+    N n_function;
+    for (Tenh::Uint32 n = 0; n < POINT_COUNT; ++n)
+    {
+        Cayley::V x(point(n));
+        Cayley::Out r(cayley.function(x));
+        Cayley::Out expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        expected(i).no_alias() = k_function.function(x) * n_function.function(x)(i);
+        verify_components_close(context, r, expected);
+
+        // the Cayley transform is a rotation, so r^T*r is the identity (this is
+        // computed in components because it pairs the codomain with itself)
+        for (Tenh::Uint32 a = 0; a < 3; ++a)
+        {
+            for (Tenh::Uint32 b = 0; b < 3; ++b)
+            {
+                double dot = 0;
+                for (Tenh::Uint32 c = 0; c < 3; ++c)
+                    dot += r[Cayley::Out::ComponentIndex(3*c + a)] * r[Cayley::Out::ComponentIndex(3*c + b)];
+                assert_leq(std::abs(dot - (a == b ? 1.0 : 0.0)), 1e-14);
+            }
+        }
+    }
+}
+
+void test_K_and_N_jets (Context const &context)
+{
+    K k_function;
+    N n_function;
+    for (Tenh::Uint32 n = 0; n < POINT_COUNT; ++n)
+    {
+        Cayley::V x(point(n));
+        K::Jet k_jet(k_function.evaluate_jet(x));
+        verify_close(context, k_jet.value, k_function.function(x));
+        verify_components_close(context, k_jet.D1, k_function.D_function(x));
+        verify_components_close(context, k_jet.D2, k_function.D2_function(x));
+        N::Jet n_jet(n_function.evaluate_jet(x));
+        verify_components_close(context, n_jet.value, n_function.function(x));
+        verify_components_close(context, n_jet.D1, n_function.D_function(x));
+        verify_components_close(context, n_jet.D2, n_function.D2_function(x));
+    }
+}
+
+void test_cayley_transform_jet (Context const &context)
+{
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+    Tenh::AbstractIndex_c<'p'> p;
+    Tenh::AbstractIndex_c<'C'> C;
+    Cayley cayley;
+    K k_function;
+    N n_function;
+    for (Tenh::Uint32 n = 0; n < POINT_COUNT; ++n)
+    {
+        Cayley::V x(point(n));
+        Cayley::Jet jet(cayley.evaluate_jet(x));
+        verify_components_close(context, jet.value, cayley.function(x));
+        verify_components_close(context, jet.D1, cayley.D_function(x));
+        verify_components_close(context, jet.D2, cayley.D2_function(x));
+
+        // the product rule, evaluating K and N separately
+        Cayley::D1 expected_d1(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        expected_d1(i*j).no_alias() =   n_function.function(x)(i)*k_function.D_function(x)(j)
+                                      + k_function.function(x)*n_function.D_function(x).split(i*j);
+        verify_components_close(context, jet.D1, expected_d1);
+        Cayley::D2 expected_d2(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        expected_d2(C*p).no_alias() =   n_function.function(x)(C)*k_function.D2_function(x)(p)
+                                      + (n_function.D_function(x)(C*k)*k_function.D_function(x)(j)).bundle(j*k,Cayley::Sym2_DualOfV::Concept(),p)
+                                      + (k_function.D_function(x)(k)*n_function.D_function(x)(C*j)).bundle(j*k,Cayley::Sym2_DualOfV::Concept(),p)
+                                      + k_function.function(x)*n_function.D2_function(x)(C*p);
+        verify_components_close(context, jet.D2, expected_d2);
+    }
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("cayleytransform");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_closed_form_function, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_K_and_N_jets, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_cayley_transform_jet, RESULT_NO_ERROR);
+}
+
+} // end of namespace CayleyTransform
+} // end of namespace Test
@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_cayleytransform.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_CAYLEYTRANSFORM_HPP_)
+#define TEST_CAYLEYTRANSFORM_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace CayleyTransform {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace CayleyTransform
+} // end of namespace Test
+
+#endif // !defined(TEST_CAYLEYTRANSFORM_HPP_)
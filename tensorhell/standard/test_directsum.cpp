@@ -0,0 +1,172 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_directsum.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_directsum.hpp"
+
+#include "randomize.hpp"
+#include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/implementation/diagonal2tensor.hpp"
+#include "tenh/implementation/directsum.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace DirectSum {
+
+// gives a distinct, non-constant value for each component of each block
+template <typename Scalar_, Uint32 COMPONENT_COUNT_, Sint32 OFFSET_>
+Scalar_ offset_evaluator (Tenh::ComponentIndex_t<COMPONENT_COUNT_> const &i)
+{
+    return Scalar_(OFFSET_) + Scalar_(i.value()) / Scalar_(2);
+}
+
+template <typename Concept_, typename Scalar_, Sint32 OFFSET_>
+struct ProceduralBlock_f
+{
+    typedef Tenh::ComponentGenerator_t<Scalar_,
+                                       Tenh::DimensionOf_f<Concept_>::V,
+                                       offset_evaluator<Scalar_,Tenh::DimensionOf_f<Concept_>::V,OFFSET_>,
+                                       Tenh::Generic> ComponentGenerator;
+    typedef Tenh::ImplementationOf_t<Concept_,Scalar_,Tenh::UseProceduralArray_t<ComponentGenerator>> T;
+};
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,1,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B1;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B2;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B3;
+
+// a diagonal 2-tensor can only be indexed via split, so there's nothing to check.
+template <typename D_, typename V_, typename Matrix_, typename Out_>
+void verify_tensor_indexed_assignment (Context const &context, D_ const &d, V_ const &v, Matrix_ const &expected_matrix, Out_ const &expected_out, Tenh::Value_t<bool,false> const &)
+{ }
+
+template <typename D_, typename V_, typename Matrix_, typename Out_>
+void verify_tensor_indexed_assignment (Context const &context, D_ const &d, V_ const &v, Matrix_ const &expected_matrix, Out_ const &expected_out, Tenh::Value_t<bool,true> const &)
+{
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Matrix_ matrix(Tenh::fill_with(typename D_::Scalar(-1)));
+    matrix(i*j) = d(i*j);
+    for (typename Matrix_::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(matrix[c], expected_matrix[c]);
+    Out_ out(Tenh::fill_with(typename D_::Scalar(-1)));
+    out(i) = d(i*j)*v(j);
+    for (typename Out_::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_about_eq(out[c], expected_out[c]);
+}
+
+template <typename Procedural2TensorImplementationTyple_>
+void test_blocks_match_generic_evaluation (Context const &context)
+{
+    typedef Tenh::DirectSumOfProcedural2Tensors_f<Procedural2TensorImplementationTyple_> DirectSumOfProcedural2Tensors;
+    typedef typename DirectSumOfProcedural2Tensors::T D;
+    typedef typename DirectSumOfProcedural2Tensors::Blocks Blocks;
+    typedef typename D::Scalar Scalar;
+    typedef typename Blocks::Factor0 Factor0;
+    typedef typename Blocks::Factor1 Factor1;
+    typedef typename Tenh::DualOf_f<Factor0>::T DualOfFactor0;
+    typedef typename Tenh::DualOf_f<Factor1>::T DualOfFactor1;
+    typedef Tenh::ImplementationOf_t<Factor0,Scalar> Out;
+    typedef Tenh::ImplementationOf_t<DualOfFactor0,Scalar> U;
+    typedef Tenh::ImplementationOf_t<DualOfFactor1,Scalar> V;
+    typedef Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<Factor0,Factor1>> BlockMatrix;
+    typedef Tenh::ImplementationOf_t<BlockMatrix,Scalar> Matrix;
+
+    D d;
+    U u(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (typename U::ComponentIndex i; i.is_not_at_end(); ++i)
+        Tenh::randomize(u[i]);
+    for (typename V::ComponentIndex i; i.is_not_at_end(); ++i)
+        Tenh::randomize(v[i]);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    // the expected values are computed componentwise, since indexed assignment from d
+    // (and from its contraction with a vector) uses the block-aware operations too.
+    typedef decltype(d.split(i*j)) SplitD;
+    SplitD split_d(d.split(i*j));
+    Matrix expected_matrix(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (typename SplitD::MultiIndex m; m.is_not_at_end(); ++m)
+        expected_matrix[typename Matrix::ComponentIndex(m.value())] = split_d[m];
+    Matrix matrix(Tenh::fill_with(Scalar(-1)));
+    Blocks::assign_to(matrix);
+    for (typename Matrix::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(matrix[c], expected_matrix[c]);
+    matrix = Matrix(Tenh::fill_with(Scalar(-1)));
+    matrix(i*j) = d.split(i*j);
+    for (typename Matrix::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(matrix[c], expected_matrix[c]);
+
+    Out expected_out(Tenh::fill_with(Scalar(0)));
+    for (typename Matrix::ComponentIndex c; c.is_not_at_end(); ++c)
+        expected_out[typename Out::ComponentIndex(c.value() / V::DIM)] += expected_matrix[c] * v[typename V::ComponentIndex(c.value() % V::DIM)];
+    Out out(Tenh::fill_with(Scalar(-1)));
+    Blocks::contract(out, v);
+    for (typename Out::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_about_eq(out[c], expected_out[c]);
+    verify_tensor_indexed_assignment(context, d, v, expected_matrix, expected_out,
+                                     Tenh::Value_t<bool,Tenh::IsTensorProductOfBasedVectorSpaces_f<typename D::Concept>::V>());
+    out = Out(Tenh::fill_with(Scalar(-1)));
+    out(i) = d.split(i*j)*v(j);
+    for (typename Out::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_about_eq(out[c], expected_out[c]);
+
+    Scalar expected_bilinear_form = u(i)*d.split(i*j)*v(j);
+    assert_about_eq(Blocks::bilinear_form(u, v), expected_bilinear_form);
+}
+
+void test_direct_sum_of_square_diagonals_is_diagonal (Context const &context)
+{
+    typedef double Scalar;
+    typedef ProceduralBlock_f<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B1,B1>,Scalar,1>::T D11;
+    typedef ProceduralBlock_f<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B2,B2>,Scalar,2>::T D22;
+    typedef ProceduralBlock_f<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B3,B3>,Scalar,3>::T D33;
+    typedef Tenh::Typle_t<D11,D22,D33> Typle;
+    typedef Tenh::DirectSumOfProcedural2Tensors_f<Typle>::T D;
+    typedef Tenh::DirectSumOfBasedVectorSpaces_c<Tenh::Typle_t<B1,B2,B3>> DirectSum;
+
+    static_assert(Tenh::TypesAreEqual_f<D::Concept,Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<DirectSum,DirectSum>>::V,
+                  "direct sum of square diagonal 2-tensors should be a diagonal 2-tensor");
+    assert_eq(D::DIM, Tenh::Uint32(6));
+
+    // the diagonal is the concatenation of the diagonals of the summands
+    D d;
+    assert_eq(d[D::ComponentIndex(0)], D11()[D11::ComponentIndex(0)]);
+    assert_eq(d[D::ComponentIndex(1)], D22()[D22::ComponentIndex(0)]);
+    assert_eq(d[D::ComponentIndex(2)], D22()[D22::ComponentIndex(1)]);
+    assert_eq(d[D::ComponentIndex(3)], D33()[D33::ComponentIndex(0)]);
+    assert_eq(d[D::ComponentIndex(4)], D33()[D33::ComponentIndex(1)]);
+    assert_eq(d[D::ComponentIndex(5)], D33()[D33::ComponentIndex(2)]);
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("DirectSum");
+
+    typedef double Scalar;
+    typedef ProceduralBlock_f<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B1,B2>>,Scalar,1>::T T12;
+    typedef ProceduralBlock_f<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B3,B3>>,Scalar,2>::T T33;
+    typedef ProceduralBlock_f<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B2,B1>>,Scalar,3>::T T21;
+    typedef ProceduralBlock_f<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B2,B3>,Scalar,4>::T D23;
+    typedef ProceduralBlock_f<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B3,B3>,Scalar,5>::T D33;
+    typedef ProceduralBlock_f<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B1,B2>,Scalar,6>::T D12;
+
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "blocks_of_2tensors", test_blocks_match_generic_evaluation<Tenh::Typle_t<T12,T33,T21>>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "blocks_of_single_2tensor", test_blocks_match_generic_evaluation<Tenh::Typle_t<T33>>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "blocks_of_diagonal_2tensors", test_blocks_match_generic_evaluation<Tenh::Typle_t<D23,D33,D12>>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "blocks_of_square_diagonal_2tensors", test_blocks_match_generic_evaluation<Tenh::Typle_t<D33,D33>>, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_direct_sum_of_square_diagonals_is_diagonal, RESULT_NO_ERROR);
+}
+
+} // end of namespace DirectSum
+} // end of namespace Test
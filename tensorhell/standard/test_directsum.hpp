@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_directsum.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_DIRECTSUM_HPP_)
+#define TEST_DIRECTSUM_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace DirectSum {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace DirectSum
+} // end of namespace Test
+
+#endif // !defined(TEST_DIRECTSUM_HPP_)
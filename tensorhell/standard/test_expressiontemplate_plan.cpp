@@ -0,0 +1,190 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_expressiontemplate_plan.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_expressiontemplate_plan.hpp"
+
+#include "tenh/conceptual/symmetricpower.hpp"
+#include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/expressiontemplate_plan.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace ExpressionTemplate_Plan {
+
+typedef double Scalar;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B;
+typedef Tenh::DualOf_f<B>::T DualOfB;
+typedef Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,DualOfB>> OperatorSpace;
+typedef Tenh::ImplementationOf_t<B,Scalar> V;
+typedef Tenh::ImplementationOf_t<OperatorSpace,Scalar> Operator;
+typedef Tenh::ImplementationOf_t<B,Scalar,Tenh::UsePreallocatedArray_t<Tenh::ComponentsAreConst::FALSE>> PreallocatedV;
+typedef Tenh::ImplementationOf_t<OperatorSpace,Scalar,Tenh::UsePreallocatedArray_t<Tenh::ComponentsAreConst::FALSE>> PreallocatedOperator;
+
+template <typename Vector_>
+void fill_with_distinct_values (Vector_ &v, Scalar offset)
+{
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = offset + Scalar(i.value()*i.value()) / Scalar(3);
+}
+
+void test_operation_count (Context const &context)
+{
+    V x(Tenh::fill_with(Scalar(1)));
+    V y(Tenh::fill_with(Scalar(2)));
+    Operator a(Tenh::fill_with(Scalar(3)));
+    Operator b(Tenh::fill_with(Scalar(4)));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+
+    // each component is a 3-term dot product
+    auto contraction = Tenh::plan_assignment(y(i), a(i*j)*x(j));
+    assert_eq(contraction.multiplication_count(), Tenh::Uint32(9));
+    assert_eq(contraction.addition_count(), Tenh::Uint32(6));
+
+    auto elementwise = Tenh::plan_assignment(y(i), Scalar(2)*x(i) - y(i));
+    assert_eq(elementwise.multiplication_count(), Tenh::Uint32(3));
+    assert_eq(elementwise.addition_count(), Tenh::Uint32(3));
+
+    // each of the 9 components is a sum of 3 terms, each of which is a product of 2 components
+    auto composition = Tenh::plan_assignment(a(i*k), a(i*j)*b(j*k) + a(i*k));
+    assert_eq(composition.multiplication_count(), Tenh::Uint32(27));
+    assert_eq(composition.addition_count(), Tenh::Uint32(27));
+    assert_eq(composition.operation_count(), Tenh::Uint32(54));
+}
+
+void test_coembed_operation_count (Context const &context)
+{
+    typedef Tenh::SymmetricPowerOfBasedVectorSpace_c<2,B> Sym2;
+    typedef Tenh::TensorPowerOfBasedVectorSpace_f<2,B>::T TensorPower2;
+    Tenh::ImplementationOf_t<TensorPower2,Scalar> t(Tenh::fill_with(Scalar(1)));
+    Tenh::ImplementationOf_t<Sym2,Scalar> s(Tenh::fill_with(Scalar(0)));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    // the 9 components of t are distributed over the 6 components of s, so each
+    // component is counted as a sum of 2 scaled terms.
+    auto coembedding = Tenh::plan_assignment(s(j), t(i).coembed(i, Sym2(), j));
+    assert_eq(coembedding.multiplication_count(), Tenh::Uint32(12));
+    assert_eq(coembedding.addition_count(), Tenh::Uint32(6));
+    coembedding.execute();
+    Tenh::ImplementationOf_t<Sym2,Scalar> expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    expected(j) = t(i).coembed(i, Sym2(), j);
+    for (Tenh::ImplementationOf_t<Sym2,Scalar>::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(s[c], expected[c]);
+}
+
+void test_rebinding (Context const &context)
+{
+    static Tenh::Uint32 const FRAME_COUNT = 3;
+    Scalar x_frames[FRAME_COUNT][V::DIM];
+    Scalar y_frames[FRAME_COUNT][V::DIM];
+    Scalar a_components[Operator::DIM];
+
+    PreallocatedOperator a(a_components);
+    fill_with_distinct_values(a, Scalar(-1));
+    PreallocatedV x(x_frames[0]);
+    PreallocatedV y(y_frames[0]);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    auto plan = Tenh::plan_assignment(y(i), a(i*j)*x(j) + x(i));
+    assert(!plan.uses_temporary());
+    for (Tenh::Uint32 frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        x.set_pointer_to_allocation(x_frames[frame]);
+        y.set_pointer_to_allocation(y_frames[frame]);
+        fill_with_distinct_values(x, Scalar(frame));
+        plan.execute();
+    }
+
+    for (Tenh::Uint32 frame = 0; frame < FRAME_COUNT; ++frame)
+    {
+        PreallocatedV x_frame(x_frames[frame]);
+        PreallocatedV y_frame(y_frames[frame]);
+        V expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        expected(i) = a(i*j)*x_frame(j) + x_frame(i);
+        for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_eq(y_frame[c], expected[c]);
+    }
+}
+
+void test_repeated_execution (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V y(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(a, Scalar(2));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    // nothing computed by one execution may be reused by the next
+    auto plan = Tenh::plan_assignment(y(i), a(i*j)*x(j) - Scalar(3)*x(i));
+    for (Tenh::Uint32 iteration = 0; iteration < 3; ++iteration)
+    {
+        fill_with_distinct_values(x, Scalar(10*iteration));
+        a[Operator::ComponentIndex(iteration)] += Scalar(100);
+        plan.execute();
+        expected(i) = a(i*j)*x(j) - Scalar(3)*x(i);
+        for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_eq(y[c], expected[c]);
+    }
+}
+
+void test_aliased_plan (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-4));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    // elementwise updates are done in place
+    auto scale = Tenh::plan_assignment(x(i), Scalar(2)*x(i));
+    assert(!scale.uses_temporary());
+    // but a contraction of x into itself needs a temporary
+    auto transform = Tenh::plan_assignment(x(i), a(i*j)*x(j));
+    assert(transform.uses_temporary());
+
+    for (Tenh::Uint32 iteration = 0; iteration < 3; ++iteration)
+    {
+        expected(i).no_alias() = Scalar(2)*(a(i*j)*x(j));
+        transform.execute();
+        scale.execute();
+        for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_eq(x[c], expected[c]);
+    }
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("ExpressionTemplate_Plan");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_operation_count, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_coembed_operation_count, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_rebinding, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_repeated_execution, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_aliased_plan, RESULT_NO_ERROR);
+}
+
+} // end of namespace ExpressionTemplate_Plan
+} // end of namespace Test
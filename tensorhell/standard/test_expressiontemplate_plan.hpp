@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_expressiontemplate_plan.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_EXPRESSIONTEMPLATE_PLAN_HPP_)
+#define TEST_EXPRESSIONTEMPLATE_PLAN_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace ExpressionTemplate_Plan {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace ExpressionTemplate_Plan
+} // end of namespace Test
+
+#endif // !defined(TEST_EXPRESSIONTEMPLATE_PLAN_HPP_)
@@ -401,6 +401,31 @@ void Eval_t (Context const &context)
               type_string_of(t(Tenh::reindexed<DomainIndexTyple,CodomainIndexTyple>(i)).eval())); // expected value
 }
 
+void Memoize_t (Context const &context)
+{
+    static Uint32 const DIM = 3;
+    typedef int DummyId;
+    typedef float Scalar;
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,DIM,DummyId>,Tenh::Basis_c<DummyId>> BasedVectorSpace;
+    typedef Tenh::Typle_t<BasedVectorSpace,BasedVectorSpace,BasedVectorSpace> FactorTyple;
+    typedef Tenh::TensorProductOfBasedVectorSpaces_c<FactorTyple> TensorProduct;
+    typedef Tenh::ImplementationOf_t<TensorProduct,Scalar> Tensor;
+
+    typedef Tenh::AbstractIndex_c<'i'> I;
+    typedef Tenh::AbstractIndex_c<'j'> J;
+
+    // set up the abstract index mapping
+    typedef Tenh::Typle_t<I> DomainIndexTyple;
+    typedef Tenh::Typle_t<J> CodomainIndexTyple;
+
+    Tensor t(Tenh::fill_with(3));
+
+    I i;
+    // verify that the operations of index-expression-memoize and reindexing commute.
+    assert_eq(type_string_of(Tenh::reindexed<DomainIndexTyple,CodomainIndexTyple>(t(i).memoize())),
+              type_string_of(t(Tenh::reindexed<DomainIndexTyple,CodomainIndexTyple>(i)).memoize())); // expected value
+}
+
 void fancy_expression (Context const &context)
 {
     static Uint32 const DIM = 3;
@@ -454,6 +479,7 @@ void AddTests (Directory &parent)
     LVD_ADD_TEST_CASE_FUNCTION(dir, IndexSplit_t, RESULT_NO_ERROR);
     LVD_ADD_TEST_CASE_FUNCTION(dir, IndexSplitToIndex_t, RESULT_NO_ERROR);
     LVD_ADD_TEST_CASE_FUNCTION(dir, Eval_t, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, Memoize_t, RESULT_NO_ERROR);
     LVD_ADD_TEST_CASE_FUNCTION(dir, fancy_expression, RESULT_NO_ERROR);
 }
 
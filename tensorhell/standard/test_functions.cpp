@@ -0,0 +1,216 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_functions.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_functions.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include "tenh/implementation/directsum.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/utility/functions.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace Functions {
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> B;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> Plane;
+
+// f(x,y) = (x*y, sin(x), y^2), which doesn't provide evaluate_jet, and counts how
+// many times it's evaluated.
+struct Curve
+{
+    typedef Tenh::FunctionObjectType_m<Plane,B,double> FunctionObjectType;
+
+    typedef FunctionObjectType::DualOfBasedVectorSpace DualOfBasedVectorSpace;
+    typedef FunctionObjectType::Domain Domain;
+    typedef FunctionObjectType::CoDomain CoDomain;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    Curve () : m_function_count(0) { }
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        ++m_function_count;
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return Out(Tenh::tuple(x*y, std::sin(x), y*y));
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return D1(Tenh::tuple(y,           x,
+                              std::cos(x), Scalar(0),
+                              Scalar(0),   Scalar(2)*y));
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        // each row is packed as (xx, yx, yy)
+        return D2(Tenh::tuple(Scalar(0),    Scalar(1), Scalar(0),
+                              -std::sin(x), Scalar(0), Scalar(0),
+                              Scalar(0),    Scalar(0), Scalar(2)));
+    }
+
+    mutable Tenh::Uint32 m_function_count;
+};
+
+// g(u) = u0*u1*u2 + u0^2
+struct Surface
+{
+    typedef Tenh::FunctionObjectType_m<B,double,double> FunctionObjectType;
+
+    typedef FunctionObjectType::DualOfBasedVectorSpace DualOfBasedVectorSpace;
+    typedef FunctionObjectType::Domain Domain;
+    typedef FunctionObjectType::CoDomain CoDomain;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &u) const
+    {
+        Scalar u0 = u[typename V::ComponentIndex(0)];
+        Scalar u1 = u[typename V::ComponentIndex(1)];
+        Scalar u2 = u[typename V::ComponentIndex(2)];
+        return u0*u1*u2 + u0*u0;
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &u) const
+    {
+        Scalar u0 = u[typename V::ComponentIndex(0)];
+        Scalar u1 = u[typename V::ComponentIndex(1)];
+        Scalar u2 = u[typename V::ComponentIndex(2)];
+        return D1(Tenh::tuple(u1*u2 + Scalar(2)*u0, u0*u2, u0*u1));
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &u) const
+    {
+        Scalar u0 = u[typename V::ComponentIndex(0)];
+        Scalar u1 = u[typename V::ComponentIndex(1)];
+        Scalar u2 = u[typename V::ComponentIndex(2)];
+        return D2(Tenh::tuple(Scalar(2), u2, Scalar(0), u1, u0, Scalar(0)));
+    }
+};
+
+// the jet and the separately computed value and derivatives are computed by the
+// same formulas, but possibly in different orders, so they're only equal up to roundoff.
+void verify_close (Context const &context, double actual, double expected)
+{
+    assert_leq(std::abs(actual - expected), 1e-14 * std::max(1.0, std::abs(expected)));
+}
+
+template <typename T_>
+void verify_components_close (Context const &context, T_ const &actual, T_ const &expected)
+{
+    for (typename T_::ComponentIndex c; c.is_not_at_end(); ++c)
+        verify_close(context, actual[c], expected[c]);
+}
+
+void verify_components_close (Context const &context, double actual, double expected)
+{
+    verify_close(context, actual, expected);
+}
+
+// checks that evaluate_jet agrees with function, D_function and D2_function
+template <typename FunctionObject_>
+void verify_jet (Context const &context, FunctionObject_ const &f, typename FunctionObject_::V const &x)
+{
+    typename Tenh::JetOf_f<FunctionObject_>::T jet(Tenh::evaluate_jet(f, x));
+    verify_components_close(context, jet.value, f.function(x));
+    verify_components_close(context, jet.D1, f.D_function(x));
+    verify_components_close(context, jet.D2, f.D2_function(x));
+}
+
+void test_fallback_jet (Context const &context)
+{
+    assert(!Tenh::HasEvaluateJet_f<Curve>::V);
+    assert((Tenh::HasEvaluateJet_f<Tenh::FunctionComposition_t<Surface,Curve>>::V));
+    assert((Tenh::HasEvaluateJet_f<Tenh::IdentityFunction_t<B,double>>::V));
+
+    Curve f;
+    Curve::V x(Tenh::tuple(0.5, -1.25));
+    verify_jet(context, f, x);
+}
+
+void test_composition_jet (Context const &context)
+{
+    Curve curve;
+    Surface surface;
+    Curve::V x(Tenh::tuple(0.5, -1.25));
+
+    // scalar-valued outer function
+    {
+        typedef Tenh::FunctionComposition_t<Surface,Curve> Composition;
+        Composition composition(surface, curve);
+        verify_jet(context, composition, x);
+        // the inner function is evaluated only once for the whole jet
+        curve.m_function_count = 0;
+        composition.evaluate_jet(x);
+        assert_eq(curve.m_function_count, Tenh::Uint32(1));
+    }
+
+    // vector-valued outer function
+    {
+        typedef Tenh::IdentityFunction_t<B,double> Identity;
+        typedef Tenh::FunctionComposition_t<Identity,Curve> Composition;
+        Identity identity;
+        Composition composition(identity, curve);
+        verify_jet(context, composition, x);
+    }
+}
+
+void test_direct_sum_jet (Context const &context)
+{
+    typedef Tenh::IdentityFunction_t<Plane,double> Identity;
+    typedef Tenh::FunctionDirectSum_t<Curve,Identity> DirectSum;
+    Curve curve;
+    Identity identity;
+    DirectSum direct_sum(curve, identity);
+    DirectSum::V x(Tenh::tuple(0.5, -1.25, 2.0, 0.75));
+    verify_jet(context, direct_sum, x);
+    curve.m_function_count = 0;
+    direct_sum.evaluate_jet(x);
+    assert_eq(curve.m_function_count, Tenh::Uint32(1));
+}
+
+void test_diagonal_and_identity_jets (Context const &context)
+{
+    Tenh::DiagonalFunction_t<B,double> diagonal;
+    Tenh::IdentityFunction_t<B,double> identity;
+    Tenh::DiagonalFunction_t<B,double>::V x(Tenh::tuple(0.5, -1.25, 2.0));
+    verify_jet(context, diagonal, x);
+    verify_jet(context, identity, x);
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("functions");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_fallback_jet, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_composition_jet, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_direct_sum_jet, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_diagonal_and_identity_jets, RESULT_NO_ERROR);
+}
+
+} // end of namespace Functions
+} // end of namespace Test
@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_functions.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_FUNCTIONS_HPP_)
+#define TEST_FUNCTIONS_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace Functions {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace Functions
+} // end of namespace Test
+
+#endif // !defined(TEST_FUNCTIONS_HPP_)
@@ -121,6 +121,103 @@ void multiply_random_polynomials_and_check_result (Context const &context)
     assert_about_eq((roly*poly).evaluate(v), (roly.evaluate(v) * poly.evaluate(v)));
 }
 
+// the product used to be computed by symmetrizing the tensor product of the
+// split coefficients; this checks the packed product against that.
+template <typename Scalar_, typename BasedVectorSpace_, Uint32 DEGREE1_, Uint32 DEGREE2_>
+void multiply_random_polynomials_and_compare_with_symmetrization (Context const &context)
+{
+    typedef Tenh::HomogeneousPolynomial<DEGREE1_,BasedVectorSpace_,Scalar_> Polynomial1;
+    typedef Tenh::HomogeneousPolynomial<DEGREE2_,BasedVectorSpace_,Scalar_> Polynomial2;
+    typedef Tenh::HomogeneousPolynomial<DEGREE1_+DEGREE2_,BasedVectorSpace_,Scalar_> ResultPolynomial;
+    typedef typename ResultPolynomial::SymDual ResultSymDual;
+    typedef typename ResultSymDual::MultiIndex ResultMultiIndex;
+    typedef typename ResultSymDual::ComponentIndex ResultComponentIndex;
+    typedef typename Tenh::TensorPowerOfBasedVectorSpace_f<DEGREE1_+DEGREE2_,typename Tenh::DualOf_f<BasedVectorSpace_>::T>::T ResultingTensorPowerType;
+    typedef typename Tenh::Sym_f<DEGREE1_+DEGREE2_,typename Tenh::DualOf_f<BasedVectorSpace_>::T,Scalar_>::T SymmetrizeType;
+    typedef typename Polynomial1::CoefficientArray ArrayType1;
+    typedef typename Polynomial2::CoefficientArray ArrayType2;
+
+    Polynomial1 roly(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Polynomial2 poly(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    ArrayType1 array1 = roly.as_array();
+    for (typename ArrayType1::ComponentIndex i; i.is_not_at_end(); ++i)
+    {
+        Tenh::randomize(array1[i]);
+    }
+
+    ArrayType2 array2 = poly.as_array();
+    for (typename ArrayType2::ComponentIndex i; i.is_not_at_end(); ++i)
+    {
+        Tenh::randomize(array2[i]);
+    }
+
+    typename Polynomial1::SymDual roly_coefficients(roly.coefficients());
+    typename Polynomial2::SymDual poly_coefficients(poly.coefficients());
+    SymmetrizeType symmetrize;
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+    Tenh::AbstractIndex_c<'I'> I;
+    Tenh::AbstractIndex_c<'J'> J;
+    Tenh::AbstractIndex_c<'K'> K;
+
+    ResultSymDual expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    expected(i) = (roly_coefficients(j).split(j,J)*poly_coefficients(k).split(k,K))
+                  .bundle_with_no_type_check(J*K,ResultingTensorPowerType(),I)*symmetrize(i*I);
+    for (ResultComponentIndex it; it.is_not_at_end(); ++it)
+    {
+        ResultMultiIndex m = ResultSymDual::template bundle_index_map<typename ResultMultiIndex::IndexTyple, ResultComponentIndex>(it);
+        expected[it] *= static_cast<Scalar_>(Tenh::MultiIndexMultiplicity_t<ResultMultiIndex>::eval(m))
+                        / static_cast<Scalar_>(Tenh::Factorial_t<DEGREE1_+DEGREE2_>::V);
+    }
+
+    ResultSymDual actual((roly*poly).coefficients());
+    for (ResultComponentIndex it; it.is_not_at_end(); ++it)
+    {
+        assert_about_eq(actual[it], expected[it]);
+    }
+}
+
+// evaluation used to contract the coefficients with the full symmetric outer
+// power of the point; this checks the Horner evaluation against that.
+template <typename Scalar_, typename BasedVectorSpace_, Uint32 DEGREE_>
+void evaluate_random_polynomial_and_compare_with_outer_power (Context const &context)
+{
+    typedef Tenh::HomogeneousPolynomial<DEGREE_,BasedVectorSpace_,Scalar_> Polynomial;
+    typedef typename Polynomial::Vector Vector;
+    typedef typename Polynomial::Sym Sym;
+    typedef typename Polynomial::CoefficientArray ArrayType;
+
+    Polynomial poly(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Vector v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    ArrayType array = poly.as_array();
+    for (typename ArrayType::ComponentIndex i; i.is_not_at_end(); ++i)
+    {
+        Tenh::randomize(array[i]);
+    }
+
+    for (typename Vector::ComponentIndex i; i.is_not_at_end(); ++i)
+    {
+        Tenh::randomize(v[i]);
+    }
+
+    Sym outer_power(Tenh::fill_with(1));
+    for (typename Sym::ComponentIndex it; it.is_not_at_end(); ++it)
+    {
+        typename Sym::MultiIndex m = Sym::template bundle_index_map<typename Sym::MultiIndex::IndexTyple, typename Sym::ComponentIndex>(it);
+        for (Uint32 i = 0; i < Sym::MultiIndex::LENGTH; ++i)
+        {
+            outer_power[it] *= v[typename Vector::ComponentIndex(m.value_of_index(i, Tenh::CheckRange::FALSE))];
+        }
+        outer_power[it] *= Tenh::Factorial_t<DEGREE_>::V / (Tenh::MultiIndexMultiplicity_t<typename Sym::MultiIndex>::eval(m));
+    }
+
+    Tenh::AbstractIndex_c<'i'> i;
+    typename Polynomial::SymDual coefficients(poly.coefficients());
+    Scalar_ expected = coefficients(i)*outer_power(i);
+    assert_about_eq(poly.evaluate(v), expected);
+}
+
 template <typename Scalar_, typename BasedVectorSpace_, Uint32 DEGREE_>
 void multiply_random_polynomial_by_scalar_and_check_result (Context const &context)
 {
@@ -179,6 +276,9 @@ void add_multiplication_tests (Directory &parent)
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "Degree 2 and 4", multiply_random_polynomials_and_check_result<Scalar_,BasedVectorSpace_,2,4>, RESULT_NO_ERROR);
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "Degree 3 and 1", multiply_random_polynomials_and_check_result<Scalar_,BasedVectorSpace_,3,1>, RESULT_NO_ERROR);
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "Degree 3 and 4", multiply_random_polynomials_and_check_result<Scalar_,BasedVectorSpace_,3,4>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "Degree 1 and 1 (vs symmetrization)", multiply_random_polynomials_and_compare_with_symmetrization<Scalar_,BasedVectorSpace_,1,1>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "Degree 2 and 1 (vs symmetrization)", multiply_random_polynomials_and_compare_with_symmetrization<Scalar_,BasedVectorSpace_,2,1>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "Degree 2 and 3 (vs symmetrization)", multiply_random_polynomials_and_compare_with_symmetrization<Scalar_,BasedVectorSpace_,2,3>, RESULT_NO_ERROR);
 }
 
 
@@ -192,6 +292,7 @@ void add_particular_tests (Directory &parent)
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "constructor_without_initialization", constructor_without_initialization<Scalar_,BasedVectorSpace,DEGREE_>, RESULT_NO_ERROR);
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "constructor_fill_with", constructor_fill_with<Scalar_,BasedVectorSpace,DEGREE_>, new Context::Data<Scalar_>(42), RESULT_NO_ERROR);
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "multiply_random_polynomial_by_scalar_and_check_result", multiply_random_polynomial_by_scalar_and_check_result<Scalar_,BasedVectorSpace,DEGREE_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "evaluate_random_polynomial_and_compare_with_outer_power", evaluate_random_polynomial_and_compare_with_outer_power<Scalar_,BasedVectorSpace,DEGREE_>, RESULT_NO_ERROR);
 }
 
 void AddTests0 (Lvd::TestSystem::Directory &parent);
@@ -75,6 +75,86 @@ void check_mutual_adjointness(Context const &context)
     assert_eq(d.embed(codomain, j)*c(j) - d(j)*c.coembed(dual(domain), j), Scalar_(0));
 }
 
+// assignment of an embedded expression is done by scattering; compare it against
+// the component-wise values of the embedded expression.
+template <typename Domain_, typename Codomain_, typename Scalar_, typename EmbeddingId_>
+void check_embed_assignment(Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<Domain_, Scalar_> D;
+    typedef Tenh::ImplementationOf_t<Codomain_, Scalar_> C;
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,Domain_>>, Scalar_> BD;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<Codomain_,B>>, Scalar_> CB;
+
+    Codomain_ codomain;
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+
+    D d(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (typename D::ComponentIndex it; it.is_not_at_end(); ++it)
+        d[it] = Scalar_(it.value() + 1);
+    C c(Tenh::fill_with(Scalar_(-1)));
+    c(j) = d.embed(codomain, j);
+    typedef Tenh::LinearEmbedding_c<Domain_, Codomain_, Scalar_, EmbeddingId_, Tenh::WithExceptions::DISABLED> LinearEmbedding;
+    for (typename C::ComponentIndex it; it.is_not_at_end(); ++it)
+    {
+        if (LinearEmbedding::embedded_component_is_procedural_zero(it))
+            assert_eq(c[it], Scalar_(0));
+        else
+            assert_eq(c[it], LinearEmbedding::scalar_factor_for_embedded_component(it) *
+                             d[LinearEmbedding::source_component_index_for_embedded_component(it)]);
+    }
+
+    // the embedded index is not the first index, and the destination index order differs
+    BD bd(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (typename BD::ComponentIndex it; it.is_not_at_end(); ++it)
+        bd[it] = Scalar_(it.value() + 1);
+    CB cb(Tenh::fill_with(Scalar_(-1)));
+    CB expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    cb(j*k) = bd(k*i).embed(i, codomain, j);
+    // a scalar multiple of an embedded expression is assigned component-wise
+    expected(j*k) = Scalar_(1)*bd(k*i).embed(i, codomain, j);
+    for (typename CB::ComponentIndex it; it.is_not_at_end(); ++it)
+        assert_eq(cb[it], expected[it]);
+}
+
+// each entry of the coembed lookup table must correspond to exactly one embedded component.
+template <typename Domain_, typename Codomain_, typename Scalar_, typename EmbeddingId_>
+void check_coembed_lookup_table(Context const &context)
+{
+    typedef Tenh::LinearEmbedding_c<Domain_, Codomain_, Scalar_, EmbeddingId_, Tenh::WithExceptions::DISABLED> LinearEmbedding;
+    typedef Tenh::CoembedLookupTable_t<Domain_, Codomain_, Scalar_, EmbeddingId_> CoembedLookupTable;
+    typedef typename CoembedLookupTable::DomainComponentIndex DomainComponentIndex;
+    typedef typename CoembedLookupTable::CodomainComponentIndex CodomainComponentIndex;
+    typedef Tenh::LookupTableCoembedIndexIterator_t<Domain_, Codomain_, Scalar_, EmbeddingId_> CoembedIndexIterator;
+
+    CoembedLookupTable const &lookup_table = CoembedLookupTable::instance();
+    Uint32 embedded_component_count = 0;
+    for (CodomainComponentIndex i; i.is_not_at_end(); ++i)
+        if (!LinearEmbedding::embedded_component_is_procedural_zero(i))
+            ++embedded_component_count;
+    assert_eq(lookup_table.entry_count(), embedded_component_count);
+
+    Uint32 iterated_count = 0;
+    for (DomainComponentIndex j; j.is_not_at_end(); ++j)
+    {
+        Uint32 previous_component = 0;
+        for (CoembedIndexIterator it(j); it.is_not_at_end(); ++it, ++iterated_count)
+        {
+            CodomainComponentIndex i(it.component_index());
+            assert(!LinearEmbedding::embedded_component_is_procedural_zero(i));
+            assert_eq(LinearEmbedding::source_component_index_for_embedded_component(i).value(), j.value());
+            assert_eq(it.scale_factor(), LinearEmbedding::scalar_factor_for_embedded_component(i));
+            // rows are stored in increasing order of codomain component
+            if (iterated_count > lookup_table.row_begin(j))
+                assert_lt(previous_component, i.value());
+            previous_component = i.value();
+        }
+    }
+    assert_eq(iterated_count, embedded_component_count);
+}
+
 template <typename BasedVectorSpace_, typename Scalar_>
 void add_checks(Directory &parent)
 {
@@ -132,6 +212,29 @@ void add_checks(Directory &parent)
         LVD_ADD_NAMED_TEST_CASE_FUNCTION(natural_embedding_dir, Tenh::type_string_of<SymmetricPower5>() + " into " + Tenh::type_string_of<TensorPower5>(), check_linear_embedding<SymmetricPower5, TensorPower5, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
     }
 
+    {
+        static Uint32 const DIM = Tenh::DimensionOf_f<BasedVectorSpace_>::V;
+        Directory &embed_assignment_dir = parent.GetSubDirectory("embed assignment");
+
+        LVD_ADD_NAMED_TEST_CASE_FUNCTION(embed_assignment_dir, Tenh::type_string_of<Diag2>() + " into " + Tenh::type_string_of<TensorPower2>(), check_embed_assignment<Diag2, TensorPower2, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+        LVD_ADD_NAMED_TEST_CASE_FUNCTION(embed_assignment_dir, Tenh::type_string_of<SymmetricPower2>() + " into " + Tenh::type_string_of<TensorPower2>(), check_embed_assignment<SymmetricPower2, TensorPower2, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+        LVD_ADD_NAMED_TEST_CASE_FUNCTION(embed_assignment_dir, Tenh::type_string_of<SymmetricPower3>() + " into " + Tenh::type_string_of<TensorPower3>(), check_embed_assignment<SymmetricPower3, TensorPower3, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+        if (DIM >= 2)
+            LVD_ADD_NAMED_TEST_CASE_FUNCTION(embed_assignment_dir, Tenh::type_string_of<ExteriorPower2>() + " into " + Tenh::type_string_of<TensorPower2>(), check_embed_assignment<ExteriorPower2, TensorPower2, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+    }
+
+    {
+        static Uint32 const DIM = Tenh::DimensionOf_f<BasedVectorSpace_>::V;
+        Directory &lookup_table_dir = parent.GetSubDirectory("coembed lookup table");
+
+        if (DIM >= 2)
+            LVD_ADD_NAMED_TEST_CASE_FUNCTION(lookup_table_dir, Tenh::type_string_of<ExteriorPower2>() + " into " + Tenh::type_string_of<TensorPower2>(), check_coembed_lookup_table<ExteriorPower2, TensorPower2, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+        if (DIM >= 3)
+            LVD_ADD_NAMED_TEST_CASE_FUNCTION(lookup_table_dir, Tenh::type_string_of<ExteriorPower3>() + " into " + Tenh::type_string_of<TensorPower3>(), check_coembed_lookup_table<ExteriorPower3, TensorPower3, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+        LVD_ADD_NAMED_TEST_CASE_FUNCTION(lookup_table_dir, Tenh::type_string_of<SymmetricPower2>() + " into " + Tenh::type_string_of<TensorPower2>(), check_coembed_lookup_table<SymmetricPower2, TensorPower2, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+        LVD_ADD_NAMED_TEST_CASE_FUNCTION(lookup_table_dir, Tenh::type_string_of<SymmetricPower3>() + " into " + Tenh::type_string_of<TensorPower3>(), check_coembed_lookup_table<SymmetricPower3, TensorPower3, Scalar_, Tenh::NaturalEmbedding>, RESULT_NO_ERROR);
+    }
+
     {
         Directory &mutual_adjointness_dir = parent.GetSubDirectory("mutual adjointness");
 
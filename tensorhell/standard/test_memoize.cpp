@@ -0,0 +1,189 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_memoize.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_memoize.hpp"
+
+#include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/expressiontemplate_eval.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace Memoize {
+
+typedef double Scalar;
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B;
+typedef Tenh::DualOf_f<B>::T DualOfB;
+typedef Tenh::ImplementationOf_t<B,Scalar> V;
+typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,DualOfB>>,Scalar> Operator;
+typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,B,DualOfB>>,Scalar> T;
+
+template <typename Vector_>
+void fill_with_distinct_values (Vector_ &v, Scalar offset)
+{
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = offset + Scalar(i.value()*i.value()) / Scalar(3);
+}
+
+void test_sparse_access (Context const &context)
+{
+    T t(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(t, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-2));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+    Tenh::AbstractIndex_c<'l'> l;
+
+    auto expression = t(i*j*k)*a(k*l);
+    auto evaluated = expression.eval();
+    auto memoized = expression.memoize();
+    typedef decltype(memoized) Memoized;
+    typedef Memoized::MultiIndex MultiIndex;
+    typedef Tenh::ComponentIndex_t<Memoized::COMPONENT_COUNT> ComponentIndex;
+
+    // nothing is computed until it is accessed
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(0));
+
+    MultiIndex m(ComponentIndex(5));
+    MultiIndex n(ComponentIndex(Memoized::COMPONENT_COUNT-1));
+    assert_eq(memoized[m], evaluated[m]);
+    assert(memoized.component_is_cached(m));
+    assert(!memoized.component_is_cached(n));
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(1));
+    assert_eq(memoized[n], evaluated[n]);
+    assert_eq(memoized[m], evaluated[m]);
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(2));
+
+    // reading every component computes each exactly once
+    for (MultiIndex c; c.is_not_at_end(); ++c)
+        assert_eq(memoized[c], evaluated[c]);
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(Memoized::COMPONENT_COUNT));
+}
+
+void test_invalidate (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-2));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    auto memoized = (a(i*j)*x(j)).memoize();
+    typedef decltype(memoized)::MultiIndex MultiIndex;
+    MultiIndex m;
+    Scalar original = memoized[m];
+
+    // cached components are stale until invalidated
+    x[V::ComponentIndex(0)] += Scalar(1);
+    assert_eq(memoized[m], original);
+    memoized.invalidate();
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(0));
+    assert_eq(memoized[m], original + a[Operator::MultiIndex(0, 0)]);
+}
+
+void test_copies_share_cache (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-2));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    auto memoized = (a(i*j)*x(j)).memoize();
+    typedef decltype(memoized) Memoized;
+    typedef Memoized::MultiIndex MultiIndex;
+    typedef Tenh::ComponentIndex_t<Memoized::COMPONENT_COUNT> ComponentIndex;
+    MultiIndex m(ComponentIndex(1));
+    MultiIndex n(ComponentIndex(2));
+
+    // a copy sees (and adds to) the components cached by the original
+    Memoized copy(memoized);
+    assert_eq(copy[m], memoized[m]);
+    assert_eq(copy.cached_component_count(), Tenh::Uint32(1));
+    // so does the copy stored by value in a larger expression
+    auto scaled = Scalar(2)*memoized;
+    assert_eq(scaled[n], Scalar(2)*copy[n]);
+    assert(memoized.component_is_cached(n));
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(2));
+
+    copy.invalidate();
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(0));
+}
+
+void test_multiple_blocks (Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,B,B,DualOfB>>,Scalar> T4;
+    T4 t(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(t, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-2));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+    Tenh::AbstractIndex_c<'l'> l;
+    Tenh::AbstractIndex_c<'p'> p;
+
+    // the 81 components span a full block and a partial one
+    auto expression = t(i*j*k*l)*a(l*p);
+    auto memoized = expression.memoize();
+    typedef decltype(memoized) Memoized;
+    static_assert(Memoized::COMPONENT_COUNT > Memoized::BLOCK_SIZE, "the components must span more than one block");
+
+    // the last component (in the partial block) first, then all of them
+    Memoized::MultiIndex last(Tenh::ComponentIndex_t<Memoized::COMPONENT_COUNT>(Memoized::COMPONENT_COUNT - 1));
+    assert_eq(memoized[last], expression[last]);
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(1));
+    for (Memoized::MultiIndex m; m.is_not_at_end(); ++m)
+        assert_eq(memoized[m], expression[m]);
+    assert_eq(memoized.cached_component_count(), Tenh::Uint32(Memoized::COMPONENT_COUNT));
+}
+
+void test_assignment (Context const &context)
+{
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar(1));
+    fill_with_distinct_values(a, Scalar(-4));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    expected(i).no_alias() = a(i*j)*x(j);
+    // the memoized components are computed during the assignment, so this must be
+    // treated as aliased, just as the unmemoized expression would be.
+    x(i) = (a(i*j)*x(j)).memoize();
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], expected[c]);
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("memoize");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_sparse_access, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_invalidate, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_copies_share_cache, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_multiple_blocks, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_assignment, RESULT_NO_ERROR);
+}
+
+} // end of namespace Memoize
+} // end of namespace Test
@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_memoize.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_MEMOIZE_HPP_)
+#define TEST_MEMOIZE_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace Memoize {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace Memoize
+} // end of namespace Test
+
+#endif // !defined(TEST_MEMOIZE_HPP_)
@@ -152,6 +152,113 @@ void multiply_random_polynomial_by_scalar_and_check_result (Context const &conte
     assert_about_eq((a*poly).evaluate(v), (a * poly.evaluate(v)));
 }
 
+template <typename Scalar, typename BasedVectorSpace_, Uint32 DEGREE>
+void evaluate_batch_and_compare_with_evaluate (Context const &context)
+{
+    typedef Tenh::MultivariatePolynomial<DEGREE,BasedVectorSpace_,Scalar> Polynomial;
+    typedef typename Polynomial::Vector Vector;
+    typedef typename Polynomial::CoefficientArray ArrayType;
+    static Uint32 const POINT_COUNT = 2*Polynomial::BATCH_CHUNK_SIZE + 3;
+
+    Polynomial poly(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    ArrayType array = poly.as_array();
+    for (typename ArrayType::ComponentIndex i; i.is_not_at_end(); ++i)
+        Tenh::randomize(array[i]);
+
+    Scalar coordinate_storage[Vector::DIM][POINT_COUNT];
+    Scalar const *coordinates[Vector::DIM];
+    for (Uint32 i = 0; i < Vector::DIM; ++i)
+    {
+        for (Uint32 p = 0; p < POINT_COUNT; ++p)
+            Tenh::randomize(coordinate_storage[i][p]);
+        coordinates[i] = coordinate_storage[i];
+    }
+
+    Scalar values[POINT_COUNT];
+    poly.evaluate_batch(coordinates, POINT_COUNT, values);
+
+    Vector v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (Uint32 p = 0; p < POINT_COUNT; ++p)
+    {
+        for (typename Vector::ComponentIndex i; i.is_not_at_end(); ++i)
+            v[i] = coordinate_storage[i.value()][p];
+        assert_about_eq(values[p], poly.evaluate(v));
+    }
+}
+
+// p = l1*l2*l3 + l4 + c for linear l1, ..., l4, whose gradient is known in closed form.
+template <typename Scalar, typename BasedVectorSpace_>
+void evaluate_batch_gradient_of_product_of_linear_polynomials (Context const &context)
+{
+    typedef Tenh::HomogeneousPolynomial<1,BasedVectorSpace_,Scalar> Linear;
+    typedef typename Linear::CoefficientArray LinearArray;
+    typedef typename Linear::Vector Vector;
+    static Uint32 const DIM = Vector::DIM;
+    static Uint32 const POINT_COUNT = Tenh::MultivariatePolynomial<3,BasedVectorSpace_,Scalar>::BATCH_CHUNK_SIZE + 5;
+
+    // positive coefficients and coordinates, so that there is no cancellation
+    Linear l[4] = { Linear(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    Linear(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    Linear(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    Linear(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON) };
+    Scalar a[4][DIM];
+    for (Uint32 k = 0; k < 4; ++k)
+    {
+        LinearArray array = l[k].as_array();
+        for (typename LinearArray::ComponentIndex i; i.is_not_at_end(); ++i)
+        {
+            Tenh::randomize(array[i]);
+            array[i] = std::abs(array[i]);
+            a[k][i.value()] = array[i];
+        }
+    }
+    Scalar c;
+    Tenh::randomize(c);
+
+    Tenh::MultivariatePolynomial<3,BasedVectorSpace_,Scalar> poly =
+        Tenh::MultivariatePolynomial<3,BasedVectorSpace_,Scalar>(l[0]*l[1]*l[2]) +
+        Tenh::MultivariatePolynomial<1,BasedVectorSpace_,Scalar>(l[3]) +
+        c;
+
+    Scalar coordinate_storage[DIM][POINT_COUNT];
+    Scalar gradient_storage[DIM][POINT_COUNT];
+    Scalar const *coordinates[DIM];
+    Scalar *gradients[DIM];
+    for (Uint32 i = 0; i < DIM; ++i)
+    {
+        for (Uint32 p = 0; p < POINT_COUNT; ++p)
+        {
+            Tenh::randomize(coordinate_storage[i][p]);
+            coordinate_storage[i][p] = std::abs(coordinate_storage[i][p]);
+        }
+        coordinates[i] = coordinate_storage[i];
+        gradients[i] = gradient_storage[i];
+    }
+
+    Scalar values[POINT_COUNT];
+    poly.evaluate_batch(coordinates, POINT_COUNT, values, gradients);
+
+    for (Uint32 p = 0; p < POINT_COUNT; ++p)
+    {
+        Scalar lx[4] = { Scalar(0), Scalar(0), Scalar(0), Scalar(0) };
+        for (Uint32 k = 0; k < 4; ++k)
+            for (Uint32 i = 0; i < DIM; ++i)
+                lx[k] += a[k][i] * coordinate_storage[i][p];
+        assert_about_eq(values[p], lx[0]*lx[1]*lx[2] + lx[3] + c);
+        for (Uint32 i = 0; i < DIM; ++i)
+            assert_about_eq(gradients[i][p], lx[1]*lx[2]*a[0][i] + lx[0]*lx[2]*a[1][i] + lx[0]*lx[1]*a[2][i] + a[3][i]);
+    }
+}
+
+template <typename Scalar, typename BasedVectorSpace_>
+void add_batch_tests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory(FORMAT("Batch Tests"))
+                           .GetSubDirectory(Tenh::type_string_of<BasedVectorSpace_>());
+
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "gradient of product of linear polynomials", evaluate_batch_gradient_of_product_of_linear_polynomials<Scalar,BasedVectorSpace_>, RESULT_NO_ERROR);
+}
+
 template <typename Scalar, typename BasedVectorSpace_>
 void add_addition_tests (Directory &parent)
 {
@@ -199,6 +306,7 @@ void add_particular_tests (Directory &parent)
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "constructor_without_initialization", constructor_without_initialization<Scalar_,BasedVectorSpace,DEGREE_>, RESULT_NO_ERROR);
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "constructor_fill_with", constructor_fill_with<Scalar_,BasedVectorSpace,DEGREE_>, new Context::Data<Scalar_>(42), RESULT_NO_ERROR);
     LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "multiply_random_polynomial_by_scalar_and_check_result", multiply_random_polynomial_by_scalar_and_check_result<Scalar_,BasedVectorSpace,DEGREE_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(degree_dir, "evaluate_batch_and_compare_with_evaluate", evaluate_batch_and_compare_with_evaluate<Scalar_,BasedVectorSpace,DEGREE_>, RESULT_NO_ERROR);
 }
 
 void AddTests0 (Lvd::TestSystem::Directory &parent);
@@ -29,6 +29,7 @@ void AddTests5 (Directory &parent)
         typedef Tenh::BasedVectorSpace_c<VectorSpace,Tenh::Basis_c<Tenh::Generic>> BasedVectorSpace;
         add_addition_tests<double,BasedVectorSpace>(dir);
         add_multiplication_tests<double,BasedVectorSpace>(dir);
+        add_batch_tests<double,BasedVectorSpace>(dir);
     }
 }
 
@@ -0,0 +1,606 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_optimization.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_optimization.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/utility/functions.hpp"
+#include "tenh/utility/optimization.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace Optimization {
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> B;
+
+// f(x) = (x - c)^T A (x - c) + m, where A is positive definite, so the minimizer is c
+struct ConvexQuadratic
+{
+    typedef Tenh::FunctionObjectType_m<B,double,double> FunctionObjectType;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::DualOfV DualOfV;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    ConvexQuadratic ()
+        :
+        m_a(Tenh::fill_with(Scalar(0.5))),
+        m_center(Tenh::uniform_tuple<Scalar>(1, -2, 3)),
+        m_minimum(Scalar(-5))
+    {
+        for (Tenh::Uint32 a = 0; a < 3; ++a)
+            m_a[D2::ComponentIndex(Tenh::sym2_packed_index(a, a))] = Scalar(2 + a);
+    }
+
+    V const &minimizer () const { return m_center; }
+    Scalar minimum () const { return m_minimum; }
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &x) const
+    {
+        Tenh::AbstractIndex_c<'i'> i;
+        V d(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        d(i).no_alias() = x(i) - m_center(i);
+        return Tenh::sym2_quadratic_form(m_a, d) + m_minimum;
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &x) const
+    {
+        Tenh::AbstractIndex_c<'i'> i;
+        V d(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        d(i).no_alias() = Scalar(2)*(x(i) - m_center(i));
+        D1 retval(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        Tenh::sym2_times_vector(m_a, d, retval);
+        return retval;
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &x) const
+    {
+        Tenh::AbstractIndex_c<'p'> p;
+        D2 retval(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        retval(p).no_alias() = Scalar(2)*m_a(p);
+        return retval;
+    }
+
+private:
+
+    D2 m_a;
+    V m_center;
+    Scalar m_minimum;
+};
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> Plane;
+
+// f(x,y) = (1 - x)^2 + 100*(y - x^2)^2, whose minimizer (1,1) is at the end of a
+// long, curved valley.
+struct Rosenbrock
+{
+    typedef Tenh::FunctionObjectType_m<Plane,double,double> FunctionObjectType;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return Tenh::sqr(Scalar(1) - x) + Scalar(100)*Tenh::sqr(y - x*x);
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return D1(Tenh::tuple(Scalar(-2)*(Scalar(1) - x) - Scalar(400)*x*(y - x*x),
+                              Scalar(200)*(y - x*x)));
+    }
+};
+
+// forwards to ObjectiveFunction_, counting the evaluations of the function and
+// its differential.
+template <typename ObjectiveFunction_>
+struct EvaluationCounter : public ObjectiveFunction_
+{
+    EvaluationCounter () : m_function_count(0), m_gradient_count(0) { }
+
+    template <typename Derived_, typename BasedVectorSpace_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    typename ObjectiveFunction_::Out function (Tenh::Vector_i<Derived_,typename ObjectiveFunction_::Scalar,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_function_count;
+        return ObjectiveFunction_::function(x);
+    }
+    template <typename Derived_, typename BasedVectorSpace_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    typename ObjectiveFunction_::D1 D_function (Tenh::Vector_i<Derived_,typename ObjectiveFunction_::Scalar,BasedVectorSpace_,COMPONENT_QUALIFIER_> const &x) const
+    {
+        ++m_gradient_count;
+        return ObjectiveFunction_::D_function(x);
+    }
+
+    mutable Tenh::Uint32 m_function_count;
+    mutable Tenh::Uint32 m_gradient_count;
+};
+
+// checks the strong Wolfe conditions for a line search from (x0, f0, g0) along step
+// that resulted in (x1, f1, g1), and that f1 and g1 are the function and its
+// differential at x1.
+template <typename ObjectiveFunction_>
+void verify_strong_wolfe_step (Context const &context,
+                               ObjectiveFunction_ const &f,
+                               typename ObjectiveFunction_::V const &x0,
+                               typename ObjectiveFunction_::Scalar f0,
+                               typename ObjectiveFunction_::D1 const &g0,
+                               typename ObjectiveFunction_::V const &step,
+                               typename ObjectiveFunction_::V const &x1,
+                               typename ObjectiveFunction_::Scalar f1,
+                               typename ObjectiveFunction_::D1 const &g1)
+{
+    typedef typename ObjectiveFunction_::Scalar Scalar;
+    Tenh::AbstractIndex_c<'i'> i;
+    assert_eq(f1, f.function(x1));
+    typename ObjectiveFunction_::D1 expected_g1(f.D_function(x1));
+    for (typename ObjectiveFunction_::D1::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(g1[c], expected_g1[c]);
+    // recover the step length from the largest component of step
+    typename ObjectiveFunction_::V::ComponentIndex largest;
+    for (typename ObjectiveFunction_::V::ComponentIndex c; c.is_not_at_end(); ++c)
+        if (std::abs(step[c]) > std::abs(step[largest]))
+            largest = c;
+    Scalar t = (x1[largest] - x0[largest]) / step[largest];
+    Scalar initial_slope = g0(i)*step(i);
+    Scalar slope = g1(i)*step(i);
+    assert_lt(Scalar(0), t);
+    assert_leq(f1, f0 + Scalar(1e-4) * t * initial_slope);
+    assert_leq(std::abs(slope), -Scalar(0.9) * initial_slope);
+}
+
+void test_strong_wolfe_step (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef Rosenbrock::Scalar Scalar;
+    Tenh::AbstractIndex_c<'i'> i;
+    EvaluationCounter<Rosenbrock> f;
+    Rosenbrock::V x0(Tenh::tuple(Scalar(-1.2), Scalar(1)));
+    Scalar f0 = f.function(x0);
+    Rosenbrock::D1 g0(f.D_function(x0));
+    // the multiples of the negative gradient which satisfy the strong Wolfe
+    // conditions are roughly between 1e-4 and 1e-3, so these require, respectively,
+    // expansion, no adjustment and narrowing of the bracket.
+    Scalar step_scales[] = { Scalar(1e-6), Scalar(1e-3), Scalar(1) };
+    for (Scalar step_scale : step_scales)
+    {
+        Rosenbrock::V step(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        step(i).no_alias() = -step_scale * g0(i);
+        Rosenbrock::V x1(x0);
+        Scalar f1 = f0;
+        Rosenbrock::D1 g1(g0);
+        f.m_function_count = f.m_gradient_count = 0;
+        assert(Tenh::LineSearch::strong_wolfe_step(f, x1, step, f1, g1));
+        // each trial costs one evaluation of each
+        assert_leq(f.m_function_count, Tenh::Uint32(20));
+        assert_leq(f.m_gradient_count, f.m_function_count + 1);
+        verify_strong_wolfe_step(context, f, x0, f0, g0, step, x1, f1, g1);
+    }
+    // an ascent direction must fail and leave everything unchanged
+    {
+        Rosenbrock::V step(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        step(i).no_alias() = g0(i);
+        Rosenbrock::V x1(x0);
+        Scalar f1 = f0;
+        Rosenbrock::D1 g1(g0);
+        assert(!Tenh::LineSearch::strong_wolfe_step(f, x1, step, f1, g1));
+        assert_eq(f1, f0);
+        for (Rosenbrock::V::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_eq(x1[c], x0[c]);
+    }
+}
+
+void test_minimize_with_strong_wolfe (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef ConvexQuadratic::Scalar Scalar;
+    Tenh::AbstractIndex_c<'i'> i;
+    ConvexQuadratic::V guess(Tenh::fill_with(Scalar(10)));
+
+    EvaluationCounter<ConvexQuadratic> uniform_f;
+    Scalar uniform_minimum;
+    ConvexQuadratic::V uniform_x(Tenh::minimize<Tenh::StandardInnerProduct>(uniform_f, guess, Scalar(1e-8), &uniform_minimum));
+    assert_lt(Scalar((uniform_x(i) - uniform_f.minimizer()(i)).norm()), Scalar(1e-7));
+
+    EvaluationCounter<ConvexQuadratic> wolfe_f;
+    Tenh::MinimizationParameters_t<Scalar> parameters;
+    parameters.line_search_method = Tenh::LineSearchMethod::STRONG_WOLFE;
+    Tenh::MinimizationStatistics_t<Scalar> statistics;
+    ConvexQuadratic::V wolfe_x(Tenh::minimize<Tenh::StandardInnerProduct>(wolfe_f, guess, Scalar(1e-8), parameters, &statistics));
+    assert_lt(Scalar((wolfe_x(i) - wolfe_f.minimizer()(i)).norm()), Scalar(1e-7));
+    assert_about_eq(statistics.final_value, wolfe_f.minimum());
+    // the Newton step is exact, so it's accepted on the first trial, after which
+    // the function value and gradient are reused.
+    assert_eq(wolfe_f.m_function_count, Tenh::Uint32(2));
+    assert_eq(wolfe_f.m_gradient_count, Tenh::Uint32(2));
+    assert_lt(wolfe_f.m_function_count, uniform_f.m_function_count);
+}
+
+void test_minimization_statistics (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef ConvexQuadratic::Scalar Scalar;
+    ConvexQuadratic::V guess(Tenh::fill_with(Scalar(10)));
+    EvaluationCounter<ConvexQuadratic> f;
+    Tenh::MinimizationParameters_t<Scalar> parameters;
+    Tenh::MinimizationStatistics_t<Scalar> statistics;
+    Tenh::minimize<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-8), parameters, &statistics);
+    // the Newton step is exact, and is followed by the tolerance check
+    assert(statistics.tolerance_was_attained);
+    assert_eq(statistics.iteration_count, Tenh::Uint32(1));
+    assert_eq(statistics.newtons_method_step_count, Tenh::Uint32(1));
+    assert_eq(statistics.conjugate_gradient_step_count, Tenh::Uint32(0));
+    assert_eq(statistics.gradient_descent_step_count, Tenh::Uint32(0));
+    assert(statistics.last_step_type == Tenh::MinimizationStepType::NEWTONS_METHOD);
+    assert_eq(statistics.function_evaluation_count, f.m_function_count);
+    assert_eq(statistics.gradient_evaluation_count, f.m_gradient_count);
+    assert_eq(statistics.hessian_evaluation_count, Tenh::Uint32(1));
+    assert_leq(statistics.final_gradient_norm, Scalar(1e-8));
+    assert_about_eq(statistics.final_value, f.minimum());
+    assert_leq(Scalar(0), statistics.function_evaluation_seconds);
+    assert_leq(statistics.function_evaluation_seconds + statistics.gradient_evaluation_seconds + statistics.hessian_evaluation_seconds,
+               statistics.total_seconds);
+
+    // stopping at the iteration limit must be reported as such
+    parameters.max_iteration_count = 0;
+    ConvexQuadratic::V x(Tenh::minimize<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-8), parameters, &statistics));
+    assert(!statistics.tolerance_was_attained);
+    assert_eq(statistics.iteration_count, Tenh::Uint32(0));
+    assert(statistics.last_step_type == Tenh::MinimizationStepType::NONE);
+    assert_eq(statistics.final_value, f.function(guess));
+    for (ConvexQuadratic::V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], guess[c]);
+
+    // a Hessian which isn't positive definite (as far as epsilon is concerned)
+    // forces conjugate gradient steps.
+    parameters.max_iteration_count = 1;
+    parameters.epsilon = Scalar(1e10);
+    Tenh::minimize<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-8), parameters, &statistics);
+    assert_eq(statistics.conjugate_gradient_step_count + statistics.gradient_descent_step_count, Tenh::Uint32(1));
+    assert(statistics.last_step_type != Tenh::MinimizationStepType::NEWTONS_METHOD);
+}
+
+// f(x,y) = (x^2 - 1)^2 + x/4 + y^2, which has a local minimizer near (1,0) and its
+// global minimizer near (-1,0).
+struct TiltedDoubleWell
+{
+    typedef Tenh::FunctionObjectType_m<Plane,double,double> FunctionObjectType;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return Tenh::sqr(x*x - Scalar(1)) + x/Scalar(4) + y*y;
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return D1(Tenh::tuple(Scalar(4)*x*(x*x - Scalar(1)) + Scalar(0.25), Scalar(2)*y));
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D2 D2_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        return D2(Tenh::tuple(Scalar(12)*x*x - Scalar(4), Scalar(0), Scalar(2)));
+    }
+};
+
+void test_multistart_minimize (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef TiltedDoubleWell::Scalar Scalar;
+    typedef TiltedDoubleWell::V V;
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,5,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> StartSpace;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<Plane,StartSpace>>,Scalar> Guesses;
+    static Tenh::Uint32 const START_COUNT = 5;
+    // the guesses are the columns, i.e. the x components of all the starts, then the
+    // y components.  only the fourth start is in the basin of the global minimizer.
+    Guesses guesses(Tenh::tuple(Scalar(2),   Scalar(1.5), Scalar(0.9),  Scalar(-1.5), Scalar(1.2),
+                                Scalar(0.5), Scalar(-1),  Scalar(0.25), Scalar(1),    Scalar(-0.5)));
+
+    TiltedDoubleWell f;
+    Tenh::MinimizationParameters_t<Scalar> parameters;
+    parameters.line_search_method = Tenh::LineSearchMethod::STRONG_WOLFE;
+    parameters.max_iteration_count = 50;
+    Tenh::MinimizationStatistics_t<Scalar> statistics[START_COUNT];
+    Tenh::Uint32 best_start_index;
+    V x(Tenh::multistart_minimize<Tenh::StandardInnerProduct>(f, guesses, Scalar(1e-8), parameters, 1, statistics, &best_start_index));
+    assert_eq(best_start_index, Tenh::Uint32(3));
+    assert_lt(x[V::ComponentIndex(0)], Scalar(-1));
+    assert_lt(std::abs(x[V::ComponentIndex(1)]), Scalar(1e-8));
+    for (Tenh::Uint32 s = 0; s < START_COUNT; ++s)
+    {
+        assert(statistics[s].tolerance_was_attained);
+        assert_leq(statistics[best_start_index].final_value, statistics[s].final_value);
+    }
+
+    // each start is the same as a separate call to minimize
+    V expected(Tenh::minimize<Tenh::StandardInnerProduct>(f, V(Tenh::tuple(Scalar(-1.5), Scalar(1))), Scalar(1e-8), parameters));
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(x[c], expected[c]);
+
+    // the result must not depend on the number of threads
+    for (Tenh::Uint32 thread_count = 2; thread_count <= START_COUNT + 1; ++thread_count)
+    {
+        Tenh::MinimizationStatistics_t<Scalar> threaded_statistics[START_COUNT];
+        Tenh::Uint32 threaded_best_start_index;
+        V threaded(Tenh::multistart_minimize<Tenh::StandardInnerProduct>(f, guesses, Scalar(1e-8), parameters, thread_count, threaded_statistics, &threaded_best_start_index));
+        assert_eq(threaded_best_start_index, best_start_index);
+        for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_eq(threaded[c], x[c]);
+        for (Tenh::Uint32 s = 0; s < START_COUNT; ++s)
+        {
+            assert_eq(threaded_statistics[s].final_value, statistics[s].final_value);
+            assert_eq(threaded_statistics[s].iteration_count, statistics[s].iteration_count);
+        }
+    }
+}
+
+void test_lbfgs_convex_quadratic (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef ConvexQuadratic::Scalar Scalar;
+    ConvexQuadratic f;
+    ConvexQuadratic::V guess(Tenh::fill_with(Scalar(10)));
+    Scalar minimum;
+    ConvexQuadratic::V x(Tenh::lbfgs_minimize<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-8), &minimum));
+    Tenh::AbstractIndex_c<'i'> i;
+    assert_lt(Scalar((x(i) - f.minimizer()(i)).norm()), Scalar(1e-7));
+    assert_about_eq(minimum, f.minimum());
+    // a history of one step is still a valid (if less effective) quasi-Newton method
+    x = Tenh::lbfgs_minimize<Tenh::StandardInnerProduct,1>(f, guess, Scalar(1e-8));
+    assert_lt(Scalar((x(i) - f.minimizer()(i)).norm()), Scalar(1e-7));
+    // as with minimize, minimum is only stored if tolerance was attained
+    Scalar unattained_minimum(-1);
+    Tenh::lbfgs_minimize<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-8), &unattained_minimum, 1);
+    assert_eq(unattained_minimum, Scalar(-1));
+}
+
+void test_lbfgs_rosenbrock (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef Rosenbrock::Scalar Scalar;
+    Rosenbrock f;
+    Rosenbrock::V guess(Tenh::tuple(Scalar(-1.2), Scalar(1)));
+    Rosenbrock::V x(Tenh::lbfgs_minimize<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-8)));
+    assert_lt(std::abs(x[Rosenbrock::V::ComponentIndex(0)] - Scalar(1)), Scalar(1e-6));
+    assert_lt(std::abs(x[Rosenbrock::V::ComponentIndex(1)] - Scalar(1)), Scalar(1e-6));
+}
+
+// the Rosenbrock function as half the sum of the squares of the residuals
+// (10*(y - x^2), 1 - x), i.e. a nonlinear least-squares problem with a zero residual.
+struct RosenbrockResiduals
+{
+    typedef Tenh::FunctionObjectType_m<Plane,Plane,double> FunctionObjectType;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::Domain Domain;
+    typedef FunctionObjectType::CoDomain CoDomain;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        Scalar y = v[typename V::ComponentIndex(1)];
+        return Out(Tenh::tuple(Scalar(10)*(y - x*x), Scalar(1) - x));
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar x = v[typename V::ComponentIndex(0)];
+        // the rows are the differentials of the residuals
+        return D1(Tenh::tuple(Scalar(-20)*x, Scalar(10),
+                              Scalar(-1),    Scalar(0)));
+    }
+};
+
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,6,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> SampleSpace;
+
+// the residuals a*exp(b*t_k) - y_k of fitting the curve a*exp(b*t) to the samples
+// y_k at t_k = k/2, where (a,b) are the parameters.
+struct ExponentialFit
+{
+    typedef Tenh::FunctionObjectType_m<Plane,SampleSpace,double> FunctionObjectType;
+    typedef FunctionObjectType::Scalar Scalar;
+    typedef FunctionObjectType::Domain Domain;
+    typedef FunctionObjectType::CoDomain CoDomain;
+    typedef FunctionObjectType::V V;
+    typedef FunctionObjectType::Out Out;
+    typedef FunctionObjectType::D1 D1;
+    typedef FunctionObjectType::D2 D2;
+
+    ExponentialFit (Out const &samples) : m_samples(samples) { }
+
+    static Scalar t (Tenh::Uint32 k) { return Scalar(k) / 2; }
+
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar a = v[typename V::ComponentIndex(0)];
+        Scalar b = v[typename V::ComponentIndex(1)];
+        Out retval(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        for (Out::ComponentIndex k; k.is_not_at_end(); ++k)
+            retval[k] = a*std::exp(b*t(k.value())) - m_samples[k];
+        return retval;
+    }
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    D1 D_function (Tenh::Vector_i<Derived_,Scalar,Plane,COMPONENT_QUALIFIER_> const &v) const
+    {
+        Scalar a = v[typename V::ComponentIndex(0)];
+        Scalar b = v[typename V::ComponentIndex(1)];
+        D1 retval(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        for (Tenh::Uint32 k = 0; k < Out::DIM; ++k)
+        {
+            Scalar e = std::exp(b*t(k));
+            retval[D1::ComponentIndex(2*k)] = e;
+            retval[D1::ComponentIndex(2*k + 1)] = a*t(k)*e;
+        }
+        return retval;
+    }
+
+private:
+
+    Out m_samples;
+};
+
+void test_levenberg_marquardt_rosenbrock (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef RosenbrockResiduals::Scalar Scalar;
+    RosenbrockResiduals f;
+    RosenbrockResiduals::V guess(Tenh::tuple(Scalar(-1.2), Scalar(1)));
+    Scalar minimum;
+    RosenbrockResiduals::V x(Tenh::levenberg_marquardt<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-12), &minimum));
+    assert_lt(std::abs(x[RosenbrockResiduals::V::ComponentIndex(0)] - Scalar(1)), Scalar(1e-10));
+    assert_lt(std::abs(x[RosenbrockResiduals::V::ComponentIndex(1)] - Scalar(1)), Scalar(1e-10));
+    assert_lt(minimum, Scalar(1e-20));
+}
+
+void test_levenberg_marquardt_curve_fit (Context const &context)
+{
+    Tenh::DebugOutputSuppression_t debug_output_suppression(true);
+    typedef ExponentialFit::Scalar Scalar;
+    typedef ExponentialFit::Out Samples;
+    ExponentialFit::V guess(Tenh::tuple(Scalar(1), Scalar(0)));
+
+    // samples of 2*exp(-0.7*t) are fit exactly
+    {
+        Samples samples(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        for (Samples::ComponentIndex k; k.is_not_at_end(); ++k)
+            samples[k] = Scalar(2)*std::exp(Scalar(-0.7)*ExponentialFit::t(k.value()));
+        ExponentialFit f(samples);
+        ExponentialFit::V x(Tenh::levenberg_marquardt<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-12)));
+        assert_lt(std::abs(x[ExponentialFit::V::ComponentIndex(0)] - Scalar(2)), Scalar(1e-9));
+        assert_lt(std::abs(x[ExponentialFit::V::ComponentIndex(1)] - Scalar(-0.7)), Scalar(1e-9));
+    }
+
+    // perturbed samples have no exact fit, so check that the gradient J^T*r of the
+    // sum of squares vanishes at the fit instead.
+    {
+        Samples samples(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        for (Samples::ComponentIndex k; k.is_not_at_end(); ++k)
+            samples[k] = Scalar(2)*std::exp(Scalar(-0.7)*ExponentialFit::t(k.value())) + (k.value() % 2 == 0 ? Scalar(0.05) : Scalar(-0.05));
+        ExponentialFit f(samples);
+        Scalar minimum;
+        ExponentialFit::V x(Tenh::levenberg_marquardt<Tenh::StandardInnerProduct>(f, guess, Scalar(1e-10), &minimum));
+        Samples r(f.function(x));
+        ExponentialFit::D1 jacobian(f.D_function(x));
+        Scalar squared_norm_of_r(0);
+        for (Tenh::Uint32 a = 0; a < 2; ++a)
+        {
+            Scalar g_a(0);
+            for (Tenh::Uint32 k = 0; k < Samples::DIM; ++k)
+                g_a += r[Samples::ComponentIndex(k)] * jacobian[ExponentialFit::D1::ComponentIndex(2*k + a)];
+            assert_leq(std::abs(g_a), Scalar(1e-9));
+        }
+        for (Samples::ComponentIndex k; k.is_not_at_end(); ++k)
+            squared_norm_of_r += r[k]*r[k];
+        assert_about_eq(minimum, Scalar(0.5)*squared_norm_of_r);
+        assert_lt(minimum, Scalar(0.5)*Scalar(Samples::DIM)*Tenh::sqr(Scalar(0.05)));
+    }
+}
+
+void test_parallel_random_minimization (Context const &context)
+{
+    typedef ConvexQuadratic::Scalar Scalar;
+    ConvexQuadratic f;
+    ConvexQuadratic::V guess(Tenh::fill_with(Scalar(0)));
+    static Tenh::Uint32 const SEED = 12345;
+    static Tenh::Uint32 const SAMPLE_COUNT = 2000;
+
+    Scalar minimum;
+    ConvexQuadratic::V expected(Tenh::parallel_totally_random_minimization<Tenh::StandardInnerProduct>(f, guess, Scalar(8), 1, SEED, SAMPLE_COUNT, 8, &minimum));
+    assert_lt(minimum, f.function(guess));
+    Tenh::AbstractIndex_c<'i'> i;
+    assert_lt(Scalar((expected(i) - f.minimizer()(i)).norm()), Scalar(0.25));
+
+    // the result must not depend on the number of threads
+    for (Tenh::Uint32 thread_count = 2; thread_count <= 5; ++thread_count)
+    {
+        Scalar threaded_minimum;
+        ConvexQuadratic::V threaded(Tenh::parallel_totally_random_minimization<Tenh::StandardInnerProduct>(f, guess, Scalar(8), thread_count, SEED, SAMPLE_COUNT, 8, &threaded_minimum));
+        assert_eq(threaded_minimum, minimum);
+        for (ConvexQuadratic::V::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_eq(threaded[c], expected[c]);
+    }
+}
+
+// ConvexQuadratic, except that it is NaN outside of a ball around the minimizer
+struct ConvexQuadraticWithNaNs : public ConvexQuadratic
+{
+    template <typename Derived_, Tenh::ComponentQualifier COMPONENT_QUALIFIER_>
+    Out function (Tenh::Vector_i<Derived_,Scalar,B,COMPONENT_QUALIFIER_> const &x) const
+    {
+        Tenh::AbstractIndex_c<'i'> i;
+        if (Scalar((x(i) - minimizer()(i)).norm()) > Scalar(4))
+            return std::numeric_limits<Scalar>::quiet_NaN();
+        return ConvexQuadratic::function(x);
+    }
+};
+
+void test_parallel_random_minimization_skips_nans (Context const &context)
+{
+    typedef ConvexQuadraticWithNaNs::Scalar Scalar;
+    ConvexQuadraticWithNaNs f;
+    ConvexQuadraticWithNaNs::V guess(Tenh::fill_with(Scalar(0)));
+
+    // a single block of samples, many of which are NaN.  a NaN sample (in particular
+    // the first) must not hide the finite samples after it.
+    for (Tenh::Uint32 seed = 0; seed < 8; ++seed)
+    {
+        Scalar minimum;
+        Tenh::parallel_totally_random_minimization<Tenh::StandardInnerProduct>(f, guess, Scalar(8), 1, seed, Tenh::RANDOM_MINIMIZATION_BLOCK_SIZE, 1, &minimum);
+        assert_lt(minimum, f.function(guess));
+    }
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("optimization");
+
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_strong_wolfe_step, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_minimize_with_strong_wolfe, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_minimization_statistics, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_multistart_minimize, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_lbfgs_convex_quadratic, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_lbfgs_rosenbrock, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_levenberg_marquardt_rosenbrock, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_levenberg_marquardt_curve_fit, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_parallel_random_minimization, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(dir, test_parallel_random_minimization_skips_nans, RESULT_NO_ERROR);
+}
+
+} // end of namespace Optimization
+} // end of namespace Test
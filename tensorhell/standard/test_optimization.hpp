@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_optimization.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_OPTIMIZATION_HPP_)
+#define TEST_OPTIMIZATION_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace Optimization {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace Optimization
+} // end of namespace Test
+
+#endif // !defined(TEST_OPTIMIZATION_HPP_)
@@ -0,0 +1,190 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_reduction.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_reduction.hpp"
+
+#include <cmath>
+
+#include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/expressiontemplate_eval.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/reduction.hpp"
+#include "tenh/summationpolicy.hpp"
+#include "tenh/utility/optimization.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace Reduction {
+
+// 5 isn't a multiple of the number of accumulation lanes
+typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,5,Tenh::Generic>,Tenh::OrthonormalBasis_c<Tenh::Generic>> B;
+typedef Tenh::DualOf_f<B>::T DualOfB;
+
+template <typename Vector_>
+void fill_with_distinct_values (Vector_ &v, typename Vector_::Scalar offset)
+{
+    typedef typename Vector_::Scalar Scalar;
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = offset + Scalar(i.value()) - Scalar(i.value()*i.value()) / Scalar(7);
+}
+
+template <Tenh::Uint32 COMPONENT_COUNT_>
+void test_reduce_array (Context const &context)
+{
+    double components[COMPONENT_COUNT_ == 0 ? 1 : COMPONENT_COUNT_];
+    double expected_sum = 0.0;
+    double expected_squared_sum = 0.0;
+    double expected_max_abs = 0.0;
+    for (Tenh::Uint32 i = 0; i < COMPONENT_COUNT_; ++i)
+    {
+        components[i] = (i % 2 == 0 ? 1.0 : -1.0) * double(i + 1);
+        expected_sum += components[i];
+        expected_squared_sum += components[i]*components[i];
+        expected_max_abs = std::max(expected_max_abs, std::abs(components[i]));
+    }
+    assert_eq((Tenh::reduce_array<Tenh::SumReduction_t<double>,COMPONENT_COUNT_>(components)), expected_sum);
+    assert_eq((Tenh::reduce_array<Tenh::SquaredSumReduction_t<double>,COMPONENT_COUNT_>(components)), expected_squared_sum);
+    assert_eq((Tenh::reduce_array<Tenh::MaxAbsReduction_t<double>,COMPONENT_COUNT_>(components)), expected_max_abs);
+}
+
+template <typename Scalar_>
+void test_expression_reductions (Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<B,Scalar_> V;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B,DualOfB>>,Scalar_> Operator;
+
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V y(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar_(1));
+    fill_with_distinct_values(a, Scalar_(-2));
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    y(i) = a(i*j)*x(j);
+    Scalar_ expected_sum(0);
+    Scalar_ expected_squared_norm(0);
+    Scalar_ expected_max_abs(0);
+    for (typename V::ComponentIndex c; c.is_not_at_end(); ++c)
+    {
+        expected_sum += y[c];
+        expected_squared_norm += y[c]*y[c];
+        expected_max_abs = std::max(expected_max_abs, Scalar_(std::abs(y[c])));
+    }
+
+    assert_about_eq((a(i*j)*x(j)).sum(), expected_sum);
+    assert_about_eq((a(i*j)*x(j)).squared_norm(), expected_squared_norm);
+    assert_about_eq((a(i*j)*x(j)).norm(), Scalar_(std::sqrt(expected_squared_norm)));
+    assert_eq((a(i*j)*x(j)).max_abs(), expected_max_abs);
+    // the same reductions of an evaluated expression
+    assert_about_eq((a(i*j)*x(j)).eval().squared_norm(), expected_squared_norm);
+    // reductions of a tensor's components
+    Scalar_ expected_tensor_squared_norm(0);
+    for (typename Operator::ComponentIndex c; c.is_not_at_end(); ++c)
+        expected_tensor_squared_norm += a[c]*a[c];
+    assert_about_eq(a(i*j).squared_norm(), expected_tensor_squared_norm);
+}
+
+template <typename Scalar_>
+void test_standard_squared_norm (Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<B,Scalar_> V;
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    fill_with_distinct_values(x, Scalar_(3));
+
+    // the array-based fast path must agree with the inner product
+    Scalar_ via_inner_product = Tenh::squared_norm<Tenh::StandardInnerProduct>(x, Tenh::Value_t<bool,false>());
+    assert_about_eq(Tenh::squared_norm<Tenh::StandardInnerProduct>(x), via_inner_product);
+    Tenh::AbstractIndex_c<'i'> i;
+    assert_about_eq(x(i).squared_norm(), via_inner_product);
+}
+
+// many terms which aren't exactly representable, so naive float summation loses accuracy
+template <typename SummationPolicy_>
+void test_summation_policy_accuracy (Context const &context)
+{
+    static Tenh::Uint32 const TERM_COUNT = 100000;
+    float const term = 0.1f;
+    typename SummationPolicy_::template Accumulator_t<float> accumulator;
+    for (Tenh::Uint32 i = 0; i < TERM_COUNT; ++i)
+        accumulator.add(term);
+    double expected = double(TERM_COUNT) * double(term);
+    assert_leq(std::abs(double(accumulator.value()) - expected) / expected, 1.0e-6);
+}
+
+template <typename SummationPolicy_>
+void test_summation_policy_contraction (Context const &context)
+{
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,1000,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> LongB;
+    typedef Tenh::ImplementationOf_t<LongB,float> V;
+    typedef Tenh::ImplementationOf_t<Tenh::DualOf_f<LongB>::T,float> DualOfV;
+
+    V x(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    DualOfV y(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    double expected = 0.0;
+    for (V::ComponentIndex c; c.is_not_at_end(); ++c)
+    {
+        x[c] = 1.0f + float(c.value()) / 3.0f;
+        y[DualOfV::ComponentIndex(c.value())] = 1.0f / 7.0f;
+        expected += double(x[c]) * double(y[DualOfV::ComponentIndex(c.value())]);
+    }
+
+    Tenh::AbstractIndex_c<'i'> i;
+    typedef decltype(x(i)) LeftOperand;
+    typedef decltype(y(i)) RightOperand;
+    typedef decltype(x(i)*y(i)) Contraction;
+    // the policy is selected for this one contraction
+    float contraction = (x(i)*y(i)).template summed_using<SummationPolicy_>();
+    assert_leq(std::abs(double(contraction) - expected) / expected, 1.0e-6);
+    // and also for one with free indices, assigned componentwise
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B2;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B2,Tenh::DualOf_f<LongB>::T>>,float> Operator;
+    typedef Tenh::ImplementationOf_t<B2,float> Out;
+    Tenh::AbstractIndex_c<'j'> j;
+    Operator a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    a(j*i) = Out(Tenh::fill_with(1.0f))(j)*y(i);
+    Out out(Tenh::fill_with(0.0f));
+    out(j) = (a(j*i)*x(i)).template summed_using<SummationPolicy_>();
+    for (Out::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_leq(std::abs(double(out[c]) - expected) / expected, 1.0e-6);
+    // the default policy is what expression templates use
+    float naive_contraction = Tenh::BinarySummation_t<LeftOperand,
+                                                      RightOperand,
+                                                      Tenh::Typle_t<>,
+                                                      typename Contraction::SummedDimIndexTyple,
+                                                      Tenh::NaiveSummation>::eval(x(i), y(i), Tenh::MultiIndex_t<Tenh::Typle_t<>>());
+    assert_eq(naive_contraction, float(x(i)*y(i)));
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("reduction");
+
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "reduce_array_0", test_reduce_array<0>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "reduce_array_1", test_reduce_array<1>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "reduce_array_4", test_reduce_array<4>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "reduce_array_7", test_reduce_array<7>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "expression_reductions_float", test_expression_reductions<float>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "expression_reductions_double", test_expression_reductions<double>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "standard_squared_norm_float", test_standard_squared_norm<float>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "standard_squared_norm_double", test_standard_squared_norm<double>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "summation_policy_accuracy_pairwise", test_summation_policy_accuracy<Tenh::PairwiseSummation>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "summation_policy_accuracy_kahan", test_summation_policy_accuracy<Tenh::KahanSummation>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "summation_policy_accuracy_wide_accumulator", test_summation_policy_accuracy<Tenh::WideAccumulatorSummation>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "summation_policy_contraction_pairwise", test_summation_policy_contraction<Tenh::PairwiseSummation>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "summation_policy_contraction_kahan", test_summation_policy_contraction<Tenh::KahanSummation>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "summation_policy_contraction_wide_accumulator", test_summation_policy_contraction<Tenh::WideAccumulatorSummation>, RESULT_NO_ERROR);
+}
+
+} // end of namespace Reduction
+} // end of namespace Test
@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_reduction.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_REDUCTION_HPP_)
+#define TEST_REDUCTION_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace Reduction {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace Reduction
+} // end of namespace Test
+
+#endif // !defined(TEST_REDUCTION_HPP_)
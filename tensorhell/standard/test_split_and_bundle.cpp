@@ -6,7 +6,9 @@
 #include "test_split_and_bundle.hpp"
 #include "tenh/conceptual/tensorproduct.hpp"
 #include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/implementation/diagonal2tensor.hpp"
 #include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vee.hpp"
 
 // this is included last because it redefines the `assert` macro,
 // which would be bad for the above includes.
@@ -54,12 +56,86 @@ void test_partial_inverse (Context const &context)
 }
 
 
+// checks the table-driven split against the static index-map methods of the implementation,
+// and that bundling the split back recovers the original components.
+template <typename Concept_, typename Scalar_>
+void test_split_against_index_map (Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<Concept_,Scalar_> V;
+    typedef typename Tenh::AS_EMBEDDABLE_IN_TENSOR_PRODUCT_OF_BASED_VECTOR_SPACES(Concept_)::TensorProductOfBasedVectorSpaces TensorProduct;
+    typedef Tenh::ImplementationOf_t<TensorProduct,Scalar_> T;
+    typedef Tenh::ImplementationOf_t<Concept_,Scalar_,Tenh::UseMemberArray_t<Tenh::ComponentsAreConst::FALSE>> StaticMethods;
+    typedef typename StaticMethods::MultiIndex MultiIndex;
+
+    V v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (typename V::ComponentIndex i; i.is_not_at_end(); ++i)
+        v[i] = Scalar_(i.value() + 1);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'p'> p;
+
+    T t(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    t(i*j).no_alias() = v.split(i*j);
+    for (MultiIndex m; m.is_not_at_end(); ++m)
+    {
+        Scalar_ expected = StaticMethods::component_is_procedural_zero(m) ?
+                           Scalar_(0) :
+                           StaticMethods::scalar_factor_for_component(m) * v[typename V::ComponentIndex(StaticMethods::vector_index_of(m))];
+        assert_eq(t[typename T::ComponentIndex(m.value())], expected);
+    }
+
+    V w(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    w(p).no_alias() = t(i*j).bundle(i*j,Concept_(),p);
+    for (typename V::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(w[c], v[c]);
+}
+
+// splitting a tensor product is a reinterpretation of its component index, which
+// assignment uses when the indices are in the same order.  this checks both that case
+// and a transposed one, which must go through the general multi-index path.
+void test_split_of_tensor_product (Context const &context)
+{
+    typedef double Scalar;
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,2,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B2;
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B3;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B2,B3>>,Scalar> T23;
+    typedef Tenh::ImplementationOf_t<Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<B3,B2>>,Scalar> T32;
+
+    T23 t(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    for (T23::ComponentIndex c; c.is_not_at_end(); ++c)
+        t[c] = Scalar(c.value() + 1);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+
+    T23 u(Tenh::fill_with(Scalar(-1)));
+    u(i*j) = t.split(i*j);
+    for (T23::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_eq(u[c], t[c]);
+
+    T32 v(Tenh::fill_with(Scalar(-1)));
+    v(j*i) = t.split(i*j);
+    for (T23::MultiIndex m; m.is_not_at_end(); ++m)
+        assert_eq(v[T32::MultiIndex(m.el<1>(), m.el<0>())], t[T23::ComponentIndex(m.value())]);
+}
 
 void AddTests (Directory &parent)
 {
     Directory &split_and_bundle_dir = parent.GetSubDirectory("split_and_bundle");
 
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,3,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B3;
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,4,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B4;
+
     LVD_ADD_TEST_CASE_FUNCTION(split_and_bundle_dir, test_partial_inverse, RESULT_NO_ERROR);
+    LVD_ADD_TEST_CASE_FUNCTION(split_and_bundle_dir, test_split_of_tensor_product, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(split_and_bundle_dir, "split_against_index_map_diagonal", test_split_against_index_map<Tenh::Diagonal2TensorProductOfBasedVectorSpaces_c<B3,B4>,double>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(split_and_bundle_dir, "split_against_index_map_sym", test_split_against_index_map<Tenh::SymmetricPowerOfBasedVectorSpace_c<2,B3>,double>, RESULT_NO_ERROR);
+    // Sym^2 of a 91-dimensional space has 4186 components (and its tensor product has 8281), which
+    // is more than MAX_INDEX_TABLE_COMPONENT_COUNT, so its split and bundle index maps are computed.
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,91,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> B91;
+    static_assert(!Tenh::IndexMapIsTabulated_f<Tenh::SymmetricPowerOfBasedVectorSpace_c<2,B91>,4186>::V, "should not be tabulated");
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(split_and_bundle_dir, "split_against_index_map_untabulated", test_split_against_index_map<Tenh::SymmetricPowerOfBasedVectorSpace_c<2,B91>,double>, RESULT_NO_ERROR);
 }
 
 } // end of namespace SplitAndBundle
@@ -0,0 +1,266 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_vee.cpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#include "test_vee.hpp"
+
+#include <cmath>
+#include <limits>
+
+#include "randomize.hpp"
+#include "tenh/conceptual/vectorspace.hpp"
+#include "tenh/implementation/scalar2tensor.hpp"
+#include "tenh/implementation/tensor.hpp"
+#include "tenh/implementation/vector.hpp"
+#include "tenh/implementation/vee.hpp"
+#include "tenh/implementation/wedge.hpp"
+
+// this is included last because it redefines the `assert` macro,
+// which would be bad for the above includes.
+#include "lvd_testsystem.hpp"
+
+using namespace Lvd;
+using namespace std;
+using namespace TestSystem;
+
+namespace Test {
+namespace Vee {
+
+template <typename Vector_>
+void randomize_vector (Vector_ &v)
+{
+    for (typename Vector_::ComponentIndex i; i.is_not_at_end(); ++i)
+        Tenh::randomize(v[i]);
+}
+
+template <Tenh::Uint32 DIM_>
+struct Sym2_f
+{
+    typedef Tenh::BasedVectorSpace_c<Tenh::VectorSpace_c<Tenh::RealField,DIM_,Tenh::Generic>,Tenh::Basis_c<Tenh::Generic>> Factor;
+    typedef typename Tenh::DualOf_f<Factor>::T DualOfFactor;
+    typedef Tenh::SymmetricPowerOfBasedVectorSpace_c<2,Factor> Sym2;
+    typedef Tenh::TensorProductOfBasedVectorSpaces_c<Tenh::Typle_t<Factor,Factor>> Matrix;
+};
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void test_packed_index (Context const &context)
+{
+    typedef typename Sym2_f<DIM_>::Sym2 Sym2;
+    typedef Tenh::ImplementationOf_t<Sym2,Scalar_> S;
+
+    for (Tenh::Uint32 a = 0; a < DIM_; ++a)
+    {
+        for (Tenh::Uint32 b = 0; b < DIM_; ++b)
+        {
+            typename S::MultiIndex m(a, b, Tenh::CheckRange::FALSE);
+            assert_eq(Tenh::sym2_packed_index(a, b), S::vector_index_of(m).value());
+        }
+    }
+}
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void test_sym2_times_vector (Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Sym2,Scalar_> S;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Factor,Scalar_> Out;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::DualOfFactor,Scalar_> V;
+
+    S s(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    randomize_vector(s);
+    randomize_vector(v);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Out expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    expected(i) = s.split(i*j)*v(j);
+    Out out(Tenh::fill_with(Scalar_(-1)));
+    Tenh::sym2_times_vector(s, v, out);
+    for (typename Out::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_about_eq(out[c], expected[c]);
+}
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void test_sym2_forms (Context const &context)
+{
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Sym2,Scalar_> S;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::DualOfFactor,Scalar_> V;
+
+    S s(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V u(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    randomize_vector(s);
+    randomize_vector(u);
+    randomize_vector(v);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Scalar_ expected_bilinear_form = u(i)*s.split(i*j)*v(j);
+    Scalar_ expected_quadratic_form = v(i)*s.split(i*j)*v(j);
+    assert_about_eq(Tenh::sym2_bilinear_form(s, u, v), expected_bilinear_form);
+    assert_about_eq(Tenh::sym2_quadratic_form(s, v), expected_quadratic_form);
+    assert_about_eq(Tenh::sym2_quadratic_form(s, v), s(v, v));
+}
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void test_sym2_updates (Context const &context)
+{
+    static Tenh::Uint32 const COUNT = 3;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Sym2,Scalar_> S;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Factor,Scalar_> U;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Matrix,Scalar_> Matrix;
+
+    S s(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    randomize_vector(s);
+    U us[COUNT] = { U(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    U(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    U(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON) };
+    for (Tenh::Uint32 n = 0; n < COUNT; ++n)
+        randomize_vector(us[n]);
+    Scalar_ alpha(Scalar_(3)/2);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Matrix expected(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    Matrix actual(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+
+    {
+        S t(s);
+        Tenh::sym2_rank1_update(t, alpha, us[0]);
+        expected(i*j) = s.split(i*j) + alpha*us[0](i)*us[0](j);
+        actual(i*j) = t.split(i*j);
+        for (typename Matrix::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_about_eq(actual[c], expected[c]);
+    }
+    {
+        S t(s);
+        Tenh::sym2_rank2_update(t, alpha, us[0], us[1]);
+        expected(i*j) = s.split(i*j) + alpha*(us[0](i)*us[1](j) + us[1](i)*us[0](j));
+        actual(i*j) = t.split(i*j);
+        for (typename Matrix::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_about_eq(actual[c], expected[c]);
+    }
+    {
+        S t(s);
+        Tenh::sym2_rank_k_update(t, alpha, us, COUNT);
+        expected(i*j) = s.split(i*j) + alpha*(us[0](i)*us[0](j) + us[1](i)*us[1](j) + us[2](i)*us[2](j));
+        actual(i*j) = t.split(i*j);
+        for (typename Matrix::ComponentIndex c; c.is_not_at_end(); ++c)
+            assert_about_eq(actual[c], expected[c]);
+    }
+}
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void test_sym2_ldlt (Context const &context)
+{
+    static Tenh::Uint32 const COUNT = 3;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Sym2,Scalar_> S;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Factor,Scalar_> U;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::DualOfFactor,Scalar_> V;
+
+    // a positive definite s, being DIM_ times the identity plus a sum of outer products
+    S s(Tenh::fill_with(Scalar_(0)));
+    for (Tenh::Uint32 a = 0; a < DIM_; ++a)
+        s[typename S::ComponentIndex(Tenh::sym2_packed_index(a, a))] = Scalar_(DIM_);
+    U us[COUNT] = { U(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    U(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON),
+                    U(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON) };
+    for (Tenh::Uint32 n = 0; n < COUNT; ++n)
+        randomize_vector(us[n]);
+    Tenh::sym2_rank_k_update(s, Scalar_(1), us, COUNT);
+
+    S ldlt(s);
+    assert(Tenh::sym2_ldlt_factor(ldlt, Scalar_(0)));
+    U u(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    U s_times_v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    randomize_vector(u);
+    Tenh::sym2_ldlt_solve(ldlt, u, v);
+    Tenh::sym2_times_vector(s, v, s_times_v);
+    // the components of u are in [0,1]
+    Scalar_ tolerance = Scalar_(64*DIM_*DIM_) * std::numeric_limits<Scalar_>::epsilon();
+    for (typename U::ComponentIndex c; c.is_not_at_end(); ++c)
+        assert_leq(std::abs(s_times_v[c] - u[c]), tolerance);
+
+    // making the last diagonal component negative enough makes s indefinite
+    S indefinite(s);
+    indefinite[typename S::ComponentIndex(Tenh::sym2_packed_index(DIM_-1, DIM_-1))] = -Scalar_(DIM_);
+    assert(!Tenh::sym2_ldlt_factor(indefinite, Scalar_(0)));
+}
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void test_multilinear_forms (Context const &context)
+{
+    typedef typename Sym2_f<DIM_>::Factor Factor;
+    typedef typename Sym2_f<DIM_>::DualOfFactor DualOfFactor;
+    typedef Tenh::ImplementationOf_t<typename Sym2_f<DIM_>::Sym2,Scalar_> S;
+    typedef Tenh::ImplementationOf_t<Tenh::SymmetricPowerOfBasedVectorSpace_c<3,Factor>,Scalar_> S3;
+    typedef Tenh::ImplementationOf_t<Tenh::ExteriorPowerOfBasedVectorSpace_c<2,Factor>,Scalar_> A;
+    typedef Tenh::ImplementationOf_t<DualOfFactor,Scalar_> V;
+
+    S s(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    S3 s3(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V u(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V v(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    V w(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    randomize_vector(s);
+    randomize_vector(s3);
+    randomize_vector(u);
+    randomize_vector(v);
+    randomize_vector(w);
+
+    Tenh::AbstractIndex_c<'i'> i;
+    Tenh::AbstractIndex_c<'j'> j;
+    Tenh::AbstractIndex_c<'k'> k;
+    Scalar_ expected_bilinear_form = u(i)*s.split(i*j)*v(j);
+    Scalar_ expected_quadratic_form = v(i)*s.split(i*j)*v(j);
+    Scalar_ expected_trilinear_form = u(i)*v(j)*w(k)*s3.split(i*j*k);
+    assert_about_eq(s(u, v), expected_bilinear_form);
+    assert_about_eq(s(v, v), expected_quadratic_form);
+    assert_about_eq(s(Tenh::Tuple_t<Tenh::Typle_t<V,V>>(u, v)), expected_bilinear_form);
+    assert_about_eq(s3(Tenh::Tuple_t<Tenh::Typle_t<V,V,V>>(u, v, w)), expected_trilinear_form);
+
+    if (DIM_ >= 2)
+    {
+        A a(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+        randomize_vector(a);
+        Scalar_ expected_alternating_form = u(i)*a.split(i*j)*v(j);
+        assert_about_eq(a(u, v), expected_alternating_form);
+        assert_about_eq(a(u, v), -a(v, u));
+        assert_eq(a(v, v), Scalar_(0));
+    }
+
+    // a scalar multiple of the identity has components which are not permutations
+    // of one another within a single coembedding.
+    typedef Tenh::ImplementationOf_t<Tenh::Scalar2TensorProductOfBasedVectorSpaces_c<Factor,Factor>,Scalar_> D;
+    D d(Tenh::Static<Tenh::WithoutInitialization>::SINGLETON);
+    randomize_vector(d);
+    Scalar_ expected_scalar2_quadratic_form = v(i)*d.split(i*j)*v(j);
+    assert_about_eq(d(v, v), expected_scalar2_quadratic_form);
+}
+
+template <Tenh::Uint32 DIM_, typename Scalar_>
+void add_particular_tests (Directory &parent)
+{
+    typedef typename Sym2_f<DIM_>::Sym2 Sym2;
+    Directory &dir = parent.GetSubDirectory(FORMAT("ImplementationOf_t<" << Tenh::type_string_of<Sym2>() << ',' << Tenh::type_string_of<Scalar_>() << '>'));
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "packed_index", test_packed_index<DIM_,Scalar_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "sym2_times_vector", test_sym2_times_vector<DIM_,Scalar_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "sym2_forms", test_sym2_forms<DIM_,Scalar_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "sym2_updates", test_sym2_updates<DIM_,Scalar_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "sym2_ldlt", test_sym2_ldlt<DIM_,Scalar_>, RESULT_NO_ERROR);
+    LVD_ADD_NAMED_TEST_CASE_FUNCTION(dir, "multilinear_forms", test_multilinear_forms<DIM_,Scalar_>, RESULT_NO_ERROR);
+}
+
+void AddTests (Directory &parent)
+{
+    Directory &dir = parent.GetSubDirectory("Vee");
+
+    add_particular_tests<1,double>(dir);
+    add_particular_tests<2,double>(dir);
+    add_particular_tests<5,double>(dir);
+    add_particular_tests<8,float>(dir);
+}
+
+} // end of namespace Vee
+} // end of namespace Test
@@ -0,0 +1,26 @@
+// ///////////////////////////////////////////////////////////////////////////
+// test_vee.hpp
+// ///////////////////////////////////////////////////////////////////////////
+
+#if !defined(TEST_VEE_HPP_)
+#define TEST_VEE_HPP_
+
+#include "test.hpp"
+
+namespace Lvd {
+namespace TestSystem {
+
+struct Directory;
+
+} // end of namespace TestSystem
+} // end of namespace Lvd
+
+namespace Test {
+namespace Vee {
+
+void AddTests (Lvd::TestSystem::Directory &parent);
+
+} // end of namespace Vee
+} // end of namespace Test
+
+#endif // !defined(TEST_VEE_HPP_)